@@ -16,6 +16,46 @@
 #include <arinc653/time.h>
 #include <arinc653/process.h>
 
+#ifdef POK_NEEDS_PERF_COUNTERS
+#include <core/syscall.h>
+#endif
+
+/*
+ * Counters of the partition (see POK_NEEDS_PERF_COUNTERS) are printed
+ * together with execution time. Unsupported events are read as 0.
+ * Counters are per partition, so other processes of the partition
+ * running in between are counted too.
+ */
+#if GET_STAT && defined(POK_NEEDS_PERF_COUNTERS)
+    #define GET_PERF_STAT_1_3                                                  \
+        jet_perf_counters_t START_PERF_STAT, END_PERF_STAT;                    \
+        uint64_t            WC_MISSES_PERF_STAT = 0;                           \
+                                                                               \
+        jet_perf_counter_setup(0, JET_PERF_EVENT_INSTRUCTIONS);                \
+        jet_perf_counter_setup(1, JET_PERF_EVENT_CACHE_MISSES);                \
+        jet_perf_counter_setup(2, JET_PERF_EVENT_DTLB_MISSES);
+
+    #define GET_PERF_STAT_2_3 jet_perf_counters_read(&START_PERF_STAT);
+
+    #define GET_PERF_STAT_3_3                                                  \
+        jet_perf_counters_read(&END_PERF_STAT);                                \
+                                                                               \
+        uint64_t MISSES_PERF_STAT = END_PERF_STAT.values[1] -                  \
+                                    START_PERF_STAT.values[1];                 \
+        WC_MISSES_PERF_STAT = WC_MISSES_PERF_STAT < MISSES_PERF_STAT ?         \
+                              MISSES_PERF_STAT : WC_MISSES_PERF_STAT;          \
+        printf("[%s] INSTR %u, CACHE MISSES %u (WC %u), DTLB MISSES %u\n",     \
+               PROCESS_STATUS_ET_STAT.ATTRIBUTES.NAME,                         \
+               (uint32_t)(END_PERF_STAT.values[0] - START_PERF_STAT.values[0]),\
+               (uint32_t)MISSES_PERF_STAT,                                     \
+               (uint32_t)WC_MISSES_PERF_STAT,                                  \
+               (uint32_t)(END_PERF_STAT.values[2] - START_PERF_STAT.values[2]));
+#else
+    #define GET_PERF_STAT_1_3
+    #define GET_PERF_STAT_2_3
+    #define GET_PERF_STAT_3_3
+#endif
+
  #if GET_STAT
     #define GET_ET_STAT_1_3                                                    \
         SYSTEM_TIME_TYPE    WCET_ET_STAT = 0;                                  \
@@ -30,8 +70,11 @@
         GET_MY_ID(&PROCESS_ID_ET_STAT, &RET_TYPE_ET_STAT);                     \
         GET_PROCESS_STATUS(PROCESS_ID_ET_STAT, &PROCESS_STATUS_ET_STAT,        \
                            &RET_TYPE_ET_STAT);                                 \
+        GET_PERF_STAT_1_3
 
-    #define GET_ET_STAT_2_3 GET_TIME(&START_ET_STAT, &RET_TYPE_ET_STAT);
+    #define GET_ET_STAT_2_3                                                    \
+        GET_PERF_STAT_2_3                                                      \
+        GET_TIME(&START_ET_STAT, &RET_TYPE_ET_STAT);
 
     #define GET_ET_STAT_3_3                                                    \
         GET_TIME(&END_ET_STAT, &RET_TYPE_ET_STAT);                             \
@@ -44,13 +87,14 @@
         ACET_ET_STAT = (ACET_ET_STAT * (EX_ET_STAT) + DIFF_ET_STAT) /          \
                        (EX_ET_STAT + 1);                                       \
         ++EX_ET_STAT;                                                          \
-        printf("[%s] ET %ums, WCET %ums, BCET %ums, ACET %ums, EXE %u\n",      \
+        printf("[%s] ET %uus, WCET %uus, BCET %uus, ACET %uus, EXE %u\n",      \
                PROCESS_STATUS_ET_STAT.ATTRIBUTES.NAME,                         \
-               (uint32_t)(DIFF_ET_STAT/1000000),                               \
-               (uint32_t)(WCET_ET_STAT/1000000),                               \
-               (uint32_t)(BCET_ET_STAT/1000000),                               \
-               (uint32_t)(ACET_ET_STAT/1000000),                               \
-               (uint32_t)EX_ET_STAT);
+               (uint32_t)(DIFF_ET_STAT/1000),                                  \
+               (uint32_t)(WCET_ET_STAT/1000),                                  \
+               (uint32_t)(BCET_ET_STAT/1000),                                  \
+               (uint32_t)(ACET_ET_STAT/1000),                                  \
+               (uint32_t)EX_ET_STAT);                                  \
+        GET_PERF_STAT_3_3
 #else
     #define GET_ET_STAT_1_3
     #define GET_ET_STAT_2_3
@@ -46,12 +46,12 @@
         ACET_ET_STAT = (ACET_ET_STAT * (EX_ET_STAT) + DIFF_ET_STAT) /          \
                        (EX_ET_STAT + 1);                                       \
         ++EX_ET_STAT;                                                          \
-        OUTPUT("[%s] ET %ums, WCET %ums, BCET %ums, ACET %ums, EXE %u\n",      \
+        OUTPUT("[%s] ET %uus, WCET %uus, BCET %uus, ACET %uus, EXE %u\n",      \
                PROCESS_STATUS_ET_STAT.ATTRIBUTES.NAME,                         \
-               (uint32_t)(DIFF_ET_STAT/1000000),                               \
-               (uint32_t)(WCET_ET_STAT/1000000),                               \
-               (uint32_t)(BCET_ET_STAT/1000000),                               \
-               (uint32_t)(ACET_ET_STAT/1000000),                               \
+               (uint32_t)(DIFF_ET_STAT/1000),                                  \
+               (uint32_t)(WCET_ET_STAT/1000),                                  \
+               (uint32_t)(BCET_ET_STAT/1000),                                  \
+               (uint32_t)(ACET_ET_STAT/1000),                                  \
                (uint32_t)EX_ET_STAT);
 #else
     #define GET_ET_STAT_1_3
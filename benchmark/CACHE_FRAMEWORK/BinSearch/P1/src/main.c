@@ -18,6 +18,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -111,14 +114,23 @@ void* binsrch_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Searching for %u elements\n", COMPUTATION_LOAD);
         for(i = 0; i < COMPUTATION_LOAD; ++i)
         {
             binary_search(rand() % 15);
         }
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -145,9 +157,9 @@ int main()
     /* Set BINSRCH manipulation process */
     th_attr_binsrch.ENTRY_POINT   = binsrch_thread;
     th_attr_binsrch.DEADLINE      = HARD;
-    th_attr_binsrch.PERIOD        = 100000000;
+    th_attr_binsrch.PERIOD        = 200000000;
     th_attr_binsrch.STACK_SIZE    = 1000;
-    th_attr_binsrch.TIME_CAPACITY = 100000000;
+    th_attr_binsrch.TIME_CAPACITY = 200000000;
     th_attr_binsrch.BASE_PRIORITY = 1;
     memcpy(th_attr_binsrch.NAME, "BINSRCH_A653\0", 9 * sizeof(char));
 
@@ -17,6 +17,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -240,13 +243,22 @@ void* compress_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Compressing text of %u elements\n", IN_COUNT);
 
 
         compress();
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
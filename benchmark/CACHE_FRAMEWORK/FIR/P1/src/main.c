@@ -17,6 +17,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -245,8 +248,14 @@ void* fir_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Computing FIR values\n");
         for(int j = 0; j < SAMPLE_SIZE; ++j)
         {
@@ -271,6 +280,9 @@ void* fir_thread(void)
             #endif
         }
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -297,9 +309,9 @@ int main()
     /* Set FIR manipulation process */
     th_attr_fir.ENTRY_POINT   = fir_thread;
     th_attr_fir.DEADLINE      = HARD;
-    th_attr_fir.PERIOD        = 200000000;
+    th_attr_fir.PERIOD        = 400000000;
     th_attr_fir.STACK_SIZE    = 4096;
-    th_attr_fir.TIME_CAPACITY = 200000000;
+    th_attr_fir.TIME_CAPACITY = 400000000;
     th_attr_fir.BASE_PRIORITY = 1;
     memcpy(th_attr_fir.NAME, "FIR_A653\0", 9 * sizeof(char));
 
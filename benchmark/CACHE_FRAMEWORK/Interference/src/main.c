@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * ARINC-653 RTOS Benchmark
+ *
+ *
+ * Test: Cache interference
+ *
+ * This partition runs in the time window following the benchmark partition
+ * and evicts its lines from the cache by walking over a buffer which is
+ * larger than the cache. The benchmark partition then restarts with a cold
+ * cache, unless the partitions are given disjoint cache colors.
+ *
+ * To measure the interference, compare execution times printed by the
+ * benchmark partition when built with "scons" and with "scons coloring=1".
+ *
+ ******************************************************************************/
+
+#include "../../BenchmarksTools/benc_config.h"
+
+/*******************************************************************************
+ * TESTS SETTINGS
+ ******************************************************************************/
+#define BUFFER_SIZE (512 * 1024)
+
+static volatile uint8_t __attribute__ ((aligned (CACHE_LINE_SIZE_L1_DATA)))
+    buffer[BUFFER_SIZE];
+
+/*******************************************************************************
+ * TESTS FUNCTIONS
+ ******************************************************************************/
+
+void* interference_thread(void)
+{
+    /*
+     * Aperiodic process: it is shared by benchmarks with different
+     * major frames, and simply uses all time of its window.
+     */
+    while(1)
+    {
+        for(unsigned int i = 0; i < BUFFER_SIZE; i += CACHE_LINE_SIZE_L1_DATA)
+        {
+            buffer[i]++;
+        }
+    }
+
+    return (void*)0;
+}
+
+
+/*******************************************************************************
+ * TESTS MAIN
+ ******************************************************************************/
+int main()
+{
+    PROCESS_ID_TYPE        thread_interference;
+    PROCESS_ATTRIBUTE_TYPE th_attr_interference;
+
+    RETURN_CODE_TYPE       ret_type;
+
+
+    /* Set interference process */
+    th_attr_interference.ENTRY_POINT   = interference_thread;
+    th_attr_interference.DEADLINE      = SOFT;
+    th_attr_interference.PERIOD        = INFINITE_TIME_VALUE;
+    th_attr_interference.STACK_SIZE    = 4096;
+    th_attr_interference.TIME_CAPACITY = INFINITE_TIME_VALUE;
+    th_attr_interference.BASE_PRIORITY = 1;
+    memcpy(th_attr_interference.NAME, "INTERFERENCE_A653\0", 18* sizeof(char));
+
+    OUTPUT("Init INTERFERENCE partition\n");
+
+    /* Create processes */
+    CREATE_PROCESS(&th_attr_interference, &thread_interference, &ret_type);
+    if(ret_type != NO_ERROR)
+    {
+        OUTPUT("Cannot create INTERFERENCE process [%d]\n", ret_type);
+        return -1;
+    }
+
+    /* Start all processes */
+    START(thread_interference, &ret_type);
+    if(ret_type != NO_ERROR)
+    {
+        OUTPUT("Cannot start INTERFERENCE process[%d]\n", ret_type);
+        return -1;
+    }
+
+    /* Partition has been initialized, now switch to normal mode */
+    OUTPUT("INTERFERENCE partition switching to normal mode\n");
+    SET_PARTITION_MODE(NORMAL, &ret_type);
+    if(ret_type != NO_ERROR)
+    {
+        OUTPUT("Cannot switch INTERFERENCE partition to NORMAL state[%d]\n", ret_type);
+        return -1;
+    }
+
+    STOP_SELF();
+
+    return 0;
+}
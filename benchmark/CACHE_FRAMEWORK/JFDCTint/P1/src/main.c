@@ -18,6 +18,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -341,8 +344,14 @@ void* dct_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Computing DCT\n");
 
         int i, seed;
@@ -358,6 +367,9 @@ void* dct_thread(void)
         jpeg_fdct_islow();
 
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -384,9 +396,9 @@ int main()
     /* Set DCT manipulation process */
     th_attr_dct.ENTRY_POINT   = dct_thread;
     th_attr_dct.DEADLINE      = HARD;
-    th_attr_dct.PERIOD        = 100000000;
+    th_attr_dct.PERIOD        = 200000000;
     th_attr_dct.STACK_SIZE    = 1000;
-    th_attr_dct.TIME_CAPACITY = 100000000;
+    th_attr_dct.TIME_CAPACITY = 200000000;
     th_attr_dct.BASE_PRIORITY = 1;
     memcpy(th_attr_dct.NAME, "DCT_A653\0", 9 * sizeof(char));
 
@@ -18,6 +18,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -150,8 +153,14 @@ void* lms_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Applying LMS\n");
 
         float d[N],b[21];
@@ -180,6 +189,9 @@ void* lms_thread(void)
                 x = d[k];
             }
         }
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -206,9 +218,9 @@ int main()
     /* Set LMS manipulation process */
     th_attr_lms.ENTRY_POINT   = lms_thread;
     th_attr_lms.DEADLINE      = HARD;
-    th_attr_lms.PERIOD        = 100000000;
+    th_attr_lms.PERIOD        = 200000000;
     th_attr_lms.STACK_SIZE    = 4096;
-    th_attr_lms.TIME_CAPACITY = 100000000;
+    th_attr_lms.TIME_CAPACITY = 200000000;
     th_attr_lms.BASE_PRIORITY = 1;
     memcpy(th_attr_lms.NAME, "LMS_A653\0", 9 * sizeof(char));
 
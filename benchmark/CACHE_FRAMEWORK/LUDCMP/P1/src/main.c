@@ -20,6 +20,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -94,8 +97,14 @@ void* ludcmp_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Solving %u equations\n", EQU_COUNT);
 
         int i, j, n = EQU_COUNT, chkerr;
@@ -119,6 +128,9 @@ void* ludcmp_thread(void)
         OUTPUT("Result: %d\n", chkerr);
 
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -145,9 +157,9 @@ int main()
     /* Set LUDCMP manipulation process */
     th_attr_ludcmp.ENTRY_POINT   = ludcmp_thread;
     th_attr_ludcmp.DEADLINE      = HARD;
-    th_attr_ludcmp.PERIOD        = 100000000;
+    th_attr_ludcmp.PERIOD        = 200000000;
     th_attr_ludcmp.STACK_SIZE    = 16384;
-    th_attr_ludcmp.TIME_CAPACITY = 100000000;
+    th_attr_ludcmp.TIME_CAPACITY = 200000000;
     th_attr_ludcmp.BASE_PRIORITY = 1;
     memcpy(th_attr_ludcmp.NAME, "LUDCMP_A653\0", 9 * sizeof(char));
 
@@ -18,6 +18,9 @@
 
 #include "../../../BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -107,8 +110,14 @@ void* qsort_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Sorting %u floating points.\n", ARRAY_SIZE);
         for(i = 0; i < ARRAY_SIZE; ++i)
         {
@@ -122,6 +131,9 @@ void* qsort_thread(void)
                 OUTPUT("Error, sorting did not go well\n");
             }
         }
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -148,9 +160,9 @@ int main()
     /* Set QSORT manipulation process */
     th_attr_qsort.ENTRY_POINT   = qsort_thread;
     th_attr_qsort.DEADLINE      = HARD;
-    th_attr_qsort.PERIOD        = 100000000;
+    th_attr_qsort.PERIOD        = 200000000;
     th_attr_qsort.STACK_SIZE    = 1000;
-    th_attr_qsort.TIME_CAPACITY = 100000000;
+    th_attr_qsort.TIME_CAPACITY = 200000000;
     th_attr_qsort.BASE_PRIORITY = 1;
     memcpy(th_attr_qsort.NAME, "QSORT_A653\0", 9 * sizeof(char));
 
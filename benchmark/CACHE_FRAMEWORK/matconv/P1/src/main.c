@@ -14,6 +14,9 @@
 
 #include "../../../../A653_Benchmarks/BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -95,11 +98,20 @@ void* matconv_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Convolution\n");
         matconv();
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -126,9 +138,9 @@ int main()
     /* Set MATCONV manipulation process */
     th_attr_matconv.ENTRY_POINT   = matconv_thread;
     th_attr_matconv.DEADLINE      = HARD;
-    th_attr_matconv.PERIOD        = 1000000000;
+    th_attr_matconv.PERIOD        = 2000000000;
     th_attr_matconv.STACK_SIZE    = 4096;
-    th_attr_matconv.TIME_CAPACITY = 1000000000;
+    th_attr_matconv.TIME_CAPACITY = 2000000000;
     th_attr_matconv.BASE_PRIORITY = 1;
     memcpy(th_attr_matconv.NAME, "MATCONV_A653\0", 13* sizeof(char));
 
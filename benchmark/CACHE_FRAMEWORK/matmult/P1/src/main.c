@@ -14,6 +14,9 @@
 
 #include "../../../../A653_Benchmarks/BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -65,11 +68,20 @@ void* matmult_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Multiplication\n");
         matmult();
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -96,9 +108,9 @@ int main()
     /* Set MATMULT manipulation process */
     th_attr_matmult.ENTRY_POINT   = matmult_thread;
     th_attr_matmult.DEADLINE      = HARD;
-    th_attr_matmult.PERIOD        = 1000000000;
+    th_attr_matmult.PERIOD        = 2000000000;
     th_attr_matmult.STACK_SIZE    = 4096;
-    th_attr_matmult.TIME_CAPACITY = 1000000000;
+    th_attr_matmult.TIME_CAPACITY = 2000000000;
     th_attr_matmult.BASE_PRIORITY = 1;
     memcpy(th_attr_matmult.NAME, "MATMULT_A653\0", 13* sizeof(char));
 
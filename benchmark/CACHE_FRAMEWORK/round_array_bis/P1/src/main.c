@@ -51,7 +51,7 @@
 
 #define NB_LOOP 1
 
-#define PROC_PERIOD     100000000ll
+#define PROC_PERIOD     200000000ll
 #define PROC_DEADLINE   PROC_PERIOD
 
 
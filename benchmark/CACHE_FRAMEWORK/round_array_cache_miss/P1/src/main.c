@@ -47,7 +47,7 @@
 
 #define NB_PROCESSES 5
 
-#define PROC_PERIOD     100000000ll
+#define PROC_PERIOD     1000000000ll
 #define PROC_DEADLINE   PROC_PERIOD
 
 /*******************************************************************************
@@ -15,6 +15,9 @@
 
 #include "../../../../A653_Benchmarks/BenchmarksTools/benc_config.h"
 
+#define GET_STAT 1
+#include "../../../BenchmarksTools/get_stat.h"
+
 /*******************************************************************************
  * TESTS SETTINGS
  ******************************************************************************/
@@ -136,11 +139,20 @@ void* transitive_thread(void)
         return (void*)1;
     }
 
+    /* Probing point */
+    GET_ET_STAT_1_3
+
     while(1)
     {
+        /* Probing point */
+        GET_ET_STAT_2_3
+
         OUTPUT("Transitive closure\n");
         closure();
 
+        /* Probing point */
+        GET_ET_STAT_3_3
+
         PERIODIC_WAIT(&ret_type);
         if(ret_type != NO_ERROR)
         {
@@ -167,9 +179,9 @@ int main()
     /* Set TRANSITIVE manipulation process */
     th_attr_transitive.ENTRY_POINT   = transitive_thread;
     th_attr_transitive.DEADLINE      = HARD;
-    th_attr_transitive.PERIOD        = 1000000000;
+    th_attr_transitive.PERIOD        = 2000000000;
     th_attr_transitive.STACK_SIZE    = 4096;
-    th_attr_transitive.TIME_CAPACITY = 1000000000;
+    th_attr_transitive.TIME_CAPACITY = 2000000000;
     th_attr_transitive.BASE_PRIORITY = 1;
     memcpy(th_attr_transitive.NAME, "TRANSITIVE_A653\0", 13* sizeof(char));
 
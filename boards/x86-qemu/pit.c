@@ -30,10 +30,10 @@
 
 #define OSCILLATOR_RATE 1193180 /** The oscillation rate of x86 clock */
 #define PIT_BASE 0x40
+#define PIT_PORT_B 0x61 /* Gate of channel 2 and its output. */
 
-/* Two parts of system time, each one can be upated atomically. */
-volatile uint32_t system_time_low;
-volatile uint32_t system_time_high;
+/* TSC frequency is measured during 1/PIT_CALIBRATE_HZ second. */
+#define PIT_CALIBRATE_HZ 20
 
 /*
  * Hardcoded calendar time at the beginning of the OS loading.
@@ -42,29 +42,72 @@ volatile uint32_t system_time_high;
  */
 static time_t base_calendar_time = 1480330081; // On 28.11.2016
 
+/*
+ * System time is read from TSC. PIT is used only for generate
+ * interrupts and for measure TSC frequency.
+ */
+
+/* TSC value at the time initialization. */
+static uint64_t tsc_first;
+
+/* Conversion from TSC ticks to nanoseconds. */
+static struct jet_time_scale tsc_to_ns;
+
+static inline uint64_t rdtsc(void)
+{
+   uint32_t low, high;
+
+   asm volatile ("rdtsc" : "=a" (low), "=d" (high));
+
+   return ((uint64_t)high << 32) | low;
+}
+
+/* Return TSC frequency, measured with PIT channel 2. */
+static uint64_t tsc_calibrate(void)
+{
+   uint32_t latch = OSCILLATOR_RATE / PIT_CALIBRATE_HZ;
+   uint64_t tsc_start, tsc_end;
+
+   /* Enable gate of channel 2, disable speaker. */
+   outb (PIT_PORT_B, (inb (PIT_PORT_B) & ~0x02) | 0x01);
+
+   outb (PIT_BASE + 3, 0xb0); /* Channel2, interrupt on terminal count, Set LSB then MSB */
+   outb (PIT_BASE + 2, latch & 0xff);
+   outb (PIT_BASE + 2, (latch >> 8) & 0xff);
+
+   tsc_start = rdtsc();
+   /* Wait until output of channel 2 becomes high. */
+   while((inb (PIT_PORT_B) & 0x20) == 0);
+   tsc_end = rdtsc();
+
+   return (tsc_end - tsc_start) * PIT_CALIBRATE_HZ;
+}
+
+/* Measure TSC frequency and start system time. */
+static void tsc_init(void)
+{
+   uint64_t tsc_freq = tsc_calibrate();
+
+   jet_time_scale_init(&tsc_to_ns, tsc_freq, 1000000000);
+   tsc_first = rdtsc();
+}
+
+#ifndef POK_NEEDS_TICKLESS
 
 void ja_bsp_process_timer(interrupt_frame* frame)
 {
    (void) frame;
    pok_pic_eoi (PIT_IRQ);
 
-   uint32_t system_time_low_new = system_time_low + (1000000000 / POK_TIMER_FREQUENCY);
-   if(system_time_low_new < (1000000000 / POK_TIMER_FREQUENCY)) {
-      // Overflow of low part.
-      system_time_high++;
-   }
-
-   system_time_low = system_time_low_new;
-
    jet_on_tick();
 }
 
 void pok_x86_qemu_timer_init(void)
 {
-   system_time_low = system_time_high = 0;
-
    uint16_t pit_freq;
 
+   tsc_init();
+
    pit_freq = POK_TIMER_FREQUENCY;
 
    outb (PIT_BASE + 3, 0x34); /* Channel0, rate generator, Set LSB then MSB */
@@ -74,22 +117,85 @@ void pok_x86_qemu_timer_init(void)
    pok_pic_unmask (PIT_IRQ);
 }
 
+#else /* POK_NEEDS_TICKLESS */
+
+/*
+ * In tickless mode channel 0 of PIT works in "interrupt on terminal
+ * count" mode and is reprogrammed by the scheduler after every interrupt.
+ */
+
+/* Maximum period, which can be programmed, in PIT counts. */
+#define PIT_MAX_PERIOD 0xffff
+
+/* Conversion from nanoseconds to PIT counts. */
+static struct jet_time_scale ns_to_pit;
+
+static void pit_start(uint32_t period)
+{
+   outb (PIT_BASE + 3, 0x30); /* Channel0, interrupt on terminal count, Set LSB then MSB */
+   outb (PIT_BASE, period & 0xff);
+   outb (PIT_BASE, (period >> 8) & 0xff);
+}
+
+void ja_bsp_process_timer(interrupt_frame* frame)
+{
+   (void) frame;
+   pok_pic_eoi (PIT_IRQ);
+
+   jet_on_tick();
+}
+
+void ja_timer_set_oneshot(pok_time_t timepoint)
+{
+   pok_time_t now = ja_system_time();
+   uint64_t period;
+
+   if(timepoint <= now)
+   {
+      period = 1; /* Fire as soon as possible. */
+   }
+   else
+   {
+      /* Round up, so interrupt doesn't fire before 'timepoint'. */
+      period = jet_time_scale_apply(&ns_to_pit, timepoint - now) + 1;
+      if(period > PIT_MAX_PERIOD)
+         period = PIT_MAX_PERIOD; /* Fire earlier, timer will be reprogrammed. */
+   }
+
+   pit_start((uint32_t)period);
+}
+
+void pok_x86_qemu_timer_init(void)
+{
+   tsc_init();
+   jet_time_scale_init(&ns_to_pit, 1000000000, OSCILLATOR_RATE);
+
+   /* Scheduler will program the first event. */
+   pit_start(PIT_MAX_PERIOD);
+
+   pok_pic_unmask (PIT_IRQ);
+}
+
+#endif /* POK_NEEDS_TICKLESS */
+
+pok_bool_t ja_system_time_params(uint64_t* counter_base,
+   struct jet_time_scale* scale)
+{
+   // TSC is readable in user space (CR4.TSD is not set).
+   *counter_base = tsc_first;
+   *scale = tsc_to_ns;
+
+   return TRUE;
+}
+
+uint64_t ja_time_counter(void)
+{
+   return rdtsc();
+}
+
 pok_time_t ja_system_time(void)
 {
-   uint32_t low, high;
-   uint32_t high1 = system_time_high;
-
-   /*
-    * Repeat reading parts of time while high part is updated during
-    * that reading.
-    */
-   do {
-      high = high1;
-      low = system_time_low;
-      high1 = system_time_high;
-   } while(high != high1);
-
-   return (((uint64_t)(high) << 32) + low);
+   return jet_time_scale_apply(&tsc_to_ns, rdtsc() - tsc_first);
 }
 
 time_t ja_calendar_time(void)
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/time.h>
+#include <arinc653/queueing.h>
+#include <arinc653/sampling.h>
+
+QUEUING_PORT_ID_TYPE QP_OUT;
+SAMPLING_PORT_ID_TYPE SP_OUT;
+#define SECOND 1000000000LL
+
+static void first_process(void)
+{
+    RETURN_CODE_TYPE ret;
+
+    struct {
+        unsigned x;
+        char message[32];
+        unsigned y;
+    } __attribute__((packed)) msg;
+
+    msg.x = 0;
+    strcpy(msg.message, "test multicast message");
+    msg.y = -1;
+
+    while (1) {
+        printf("P1: sending messages %u..%u\n", msg.x, msg.x + 9);
+        for (int i = 0; i < 10; i++) {
+            // Sender never waits: full receivers lose their oldest messages.
+            SEND_QUEUING_MESSAGE(QP_OUT, (MESSAGE_ADDR_TYPE) &msg, sizeof(msg), 0, &ret);
+            if (ret != NO_ERROR) {
+                printf("P1: qp error: %d\n", (int) ret);
+            }
+
+            msg.x++;
+            msg.y--;
+        }
+
+        // Both receivers read the same last message.
+        WRITE_SAMPLING_MESSAGE(SP_OUT, (MESSAGE_ADDR_TYPE) &msg, sizeof(msg), &ret);
+        if (ret != NO_ERROR) {
+            printf("P1: sp error: %d\n", (int) ret);
+        }
+
+        TIMED_WAIT(SECOND, &ret);
+    }
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .BASE_PRIORITY = MIN_PRIORITY_VALUE,
+        .DEADLINE = SOFT,
+    };
+
+    // create process 1
+    process_attrs.ENTRY_POINT = first_process;
+    strncpy(process_attrs.NAME, "process 1", sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process 1: %d\n", (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process 1: %d\n", (int) ret);
+        return 1;
+    }
+
+    // create ports
+    CREATE_QUEUING_PORT("QP_OUT", 64, 10, SOURCE, FIFO, &QP_OUT, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port QP_OUT: %d\n", (int) ret);
+        return 1;
+    }
+
+    CREATE_SAMPLING_PORT("SP_OUT", 64, SOURCE, SECOND, &SP_OUT, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port SP_OUT: %d\n", (int) ret);
+        return 1;
+    }
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    printf("going to NORMAL mode...\n");
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    STOP_SELF();
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
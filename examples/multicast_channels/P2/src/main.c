@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/time.h>
+#include <arinc653/queueing.h>
+#include <arinc653/sampling.h>
+
+#define PART_NAME "P2"
+// Size of QP_IN buffer, as in the partition's config.xml.
+#define QP_IN_NB_MESSAGE 10
+
+QUEUING_PORT_ID_TYPE QP_IN;
+SAMPLING_PORT_ID_TYPE SP_IN;
+#define SECOND 1000000000LL
+
+static void first_process(void)
+{
+    RETURN_CODE_TYPE ret;
+
+    struct {
+        unsigned x;
+        char message[32];
+        unsigned y;
+    } __attribute__((packed)) msg;
+
+    unsigned last_x = 0;
+
+    while (1) {
+        MESSAGE_SIZE_TYPE len;
+        VALIDITY_TYPE validity;
+
+        // Wait for the next message, then read all queued ones.
+        RECEIVE_QUEUING_MESSAGE(QP_IN, INFINITE_TIME_VALUE, (MESSAGE_ADDR_TYPE) &msg, &len, &ret);
+
+        while (ret == NO_ERROR || ret == INVALID_CONFIG) {
+            // INVALID_CONFIG: message is received, but some older ones were overwritten.
+            if (ret == INVALID_CONFIG || (last_x != 0 && msg.x != last_x + 1)) {
+                printf(PART_NAME ": messages %u..%u have been overwritten\n", last_x + 1, msg.x - 1);
+            }
+            last_x = msg.x;
+
+            RECEIVE_QUEUING_MESSAGE(QP_IN, 0, (MESSAGE_ADDR_TYPE) &msg, &len, &ret);
+        }
+
+        if (ret != NOT_AVAILABLE) {
+            printf(PART_NAME ": qp error: %d\n", (int) ret);
+        } else {
+            printf(PART_NAME ": received messages up to %u\n", last_x);
+        }
+
+        READ_SAMPLING_MESSAGE(SP_IN, (MESSAGE_ADDR_TYPE) &msg, &len, &validity, &ret);
+        if (ret == NO_ERROR) {
+            printf(PART_NAME ": sampling message {%u, \"%s\", %u}\n", msg.x, msg.message, msg.y);
+        } else {
+            printf(PART_NAME ": sp error: %d\n", (int) ret);
+        }
+    }
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .BASE_PRIORITY = MIN_PRIORITY_VALUE,
+        .DEADLINE = SOFT,
+    };
+
+    // create process 1
+    process_attrs.ENTRY_POINT = first_process;
+    strncpy(process_attrs.NAME, "process 1", sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process 1: %d\n", (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process 1: %d\n", (int) ret);
+        return 1;
+    }
+
+    // create ports
+    CREATE_QUEUING_PORT("QP_IN", 64, QP_IN_NB_MESSAGE, DESTINATION, FIFO, &QP_IN, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port QP_IN: %d\n", (int) ret);
+        return 1;
+    }
+
+    CREATE_SAMPLING_PORT("SP_IN", 64, DESTINATION, SECOND, &SP_IN, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port SP_IN: %d\n", (int) ret);
+        return 1;
+    }
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    printf("going to NORMAL mode...\n");
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    STOP_SELF();
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
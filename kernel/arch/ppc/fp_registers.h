@@ -21,6 +21,8 @@
 struct jet_fp_store
 {
   double fp_regs[32];
+  /* FPSCR in the low word, as stored by mffs. */
+  double fpscr;
 };
 
 #endif /* __JET_PPC_FP_REGISTERS_H__ */
@@ -20,3 +20,20 @@ struct jet_fp_store* ja_alloc_fp_store(void)
 {
     return ja_mem_alloc_aligned(sizeof(struct jet_fp_store), 8);
 }
+
+/*
+ * Whether MSR[FP] should be set on return to user space.
+ *
+ * Used in pok_arch_rfi and pok_arch_rfdi_for_debug.
+ */
+uint32_t ja_fp_user_enabled = 0;
+
+void ja_fp_enable(void)
+{
+    ja_fp_user_enabled = 1;
+}
+
+void ja_fp_disable(void)
+{
+    ja_fp_user_enabled = 0;
+}
@@ -21,6 +21,9 @@
 #ifndef __JET_PPC_DEPLOYMENT_H__
 #define __JET_PPC_DEPLOYMENT_H__
 
+#include <config.h>
+#include <types.h>
+
 /* 
  * Virtual address where partition's memory starts.
  * 
@@ -48,8 +51,20 @@ struct ja_ppc_space
     size_t      size_heap;
     /* Total size of memory block */
     size_t      size_total;
+    /* Size of the memory for user stacks (used with POK_NEEDS_TLB0_PAGING). */
+    size_t      size_stack;
+    /*
+     * Mask of cache colors for the memory pages, 0 for contiguous memory
+     * (used with POK_NEEDS_CACHE_COLORING).
+     */
+    uint32_t    cache_colors;
     /* State of the user stack allocator. */
     uint32_t    ustack_state;
+    /*
+     * Memory below the stacks used by read-only mappings
+     * (see ja_space_map_ro(), used with POK_NEEDS_TLB0_PAGING).
+     */
+    size_t      size_shared;
 };
 
 /*
@@ -60,6 +75,16 @@ struct ja_ppc_space
 extern struct ja_ppc_space ja_spaces[];
 extern int ja_spaces_n;
 
+#ifdef POK_NEEDS_TLB0_PAGING
+/*
+ * Page table of every user space, indexed by (space_id - 1).
+ *
+ * Should be defined in deployment.c, tables are allocated on
+ * initialization (see space.c).
+ */
+extern uint32_t* ja_ppc_page_tables[];
+#endif
+
 
 /*
  * TLB for memory maping
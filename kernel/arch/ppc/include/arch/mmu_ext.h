@@ -79,6 +79,11 @@
 #define MAS3_SPSIZE             0x0000003e
 #define MAS3_SPSIZE_SHIFT       1
 
+#define MAS4_TLBSELD(x)         MAS0_TLBSEL(x)
+#define MAS4_TSIZED(x)          MAS1_TSIZE(x)
+
+#define MAS6_SPID(x)            (((x) << 16) & 0x3FFF0000)
+
 #define MAS7_RPN                0xFFFFFFFF
 
 
@@ -29,6 +29,7 @@
 #include "timer.h"
 #include "syscalls.h"
 #include "interrupt_context.h"
+#include <asp/entries.h>
 
 
 
@@ -190,7 +191,9 @@ void pok_int_program(struct jet_interrupt_context* ea) {
 
 void pok_int_fp_unavail(struct jet_interrupt_context* ea) {
     (void) ea;
-    pok_fatal("FP unavailable interrupt");
+    // MSR[FP] is cleared on return to user by lazy FP switching.
+    if(!jet_fp_unavailable())
+        pok_fatal("FP unavailable interrupt");
 }
 
 unsigned long pok_int_system_call(struct jet_interrupt_context* ea,
@@ -214,6 +217,15 @@ void pok_int_watchdog(struct jet_interrupt_context* ea) {
     pok_fatal("Watchdog interrupt");
 }
 
+void pok_int_perf_monitor(struct jet_interrupt_context* ea) {
+    (void) ea;
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_overflow();
+#else
+    pok_fatal("Performance monitor interrupt");
+#endif
+}
+
 void pok_int_data_tlb_miss(struct jet_interrupt_context* vctx, uintptr_t dear, unsigned long esr) {
     pok_arch_handle_page_fault(vctx, dear, esr, PF_DATA_TLB_MISS);
 }
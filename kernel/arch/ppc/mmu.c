@@ -95,6 +95,18 @@ void pok_ppc_tlb_clear_entry(
     asm volatile("isync; msync; tlbwe; isync":::"memory");
 
 }
+pok_bool_t pok_ppc_tlb_lookup(
+        uint32_t virtual,
+        unsigned pid
+    )
+{
+    mtspr(SPRN_MAS6, MAS6_SPID(pid));
+
+    asm volatile("isync; tlbsx 0, %0; isync" : : "r" (virtual) : "memory");
+
+    return (mfspr(SPRN_MAS1) & MAS1_VALID) != 0;
+}
+
 /*
 unsigned pok_ppc_get_tlb_nentry(unsigned tlbsel) {
     static unsigned regid[] =  { SPRN_TLB0CFG,
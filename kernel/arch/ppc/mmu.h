@@ -19,6 +19,7 @@
 #include <arch/mmu_ext.h>
 
 #define TLBnCFG_N_ENTRY_MASK    0x00000fff
+#define TLBnCFG_ASSOC(cfg)      ((cfg) >> 24)
 
 /**
  * Write address mapping into the specified TLB entry.
@@ -53,6 +54,17 @@ void pok_ppc_tlb_clear_entry(
         unsigned entry
     );
 
+/**
+ * Returns TRUE if there is a valid TLB entry for the given address
+ * and process ID.
+ *
+ * MAS registers are clobbered.
+ */
+pok_bool_t pok_ppc_tlb_lookup(
+        uint32_t virtual,
+        unsigned pid
+    );
+
 /*
  * @ requires tlbsel < 2;
  */
@@ -0,0 +1,52 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Layout of the page tables for partition memory (POK_NEEDS_TLB0_PAGING).
+ *
+ * Page table of the space is a flat array of JA_PPC_PAGES_N entries,
+ * one per 4K page of the partition window. Non-zero entry is the value
+ * for MAS3 register (RPN and permissions), zero entry means the page
+ * is not mapped.
+ *
+ * The array is followed by the ring of the pages recently loaded into
+ * TLB0: byte offset of the next element in the ring and the page
+ * indices. These pages are preloaded when the space is switched to.
+ *
+ * This header is used by assembler code too.
+ */
+
+#ifndef __JET_PPC_PAGING_H__
+#define __JET_PPC_PAGING_H__
+
+/* Should be equal to POK_PARTITION_MEMORY_BASE and POK_PARTITION_MEMORY_SIZE. */
+#define JA_PPC_PARTITION_BASE   0x80000000
+#define JA_PPC_PARTITION_SIZE   0x1000000
+
+#define JA_PPC_PAGE_SHIFT       12
+#define JA_PPC_PAGE_SIZE        (1 << JA_PPC_PAGE_SHIFT)
+
+#define JA_PPC_PAGES_N          (JA_PPC_PARTITION_SIZE >> JA_PPC_PAGE_SHIFT)
+
+/* Number of elements in the ring of recently loaded pages. Power of 2. */
+#define JA_PPC_HOT_PAGES_N      8
+
+/* Offsets (in bytes) within the page table. */
+#define JA_PPC_PT_HOT_NEXT      (JA_PPC_PAGES_N * 4)
+#define JA_PPC_PT_HOT_PAGES     (JA_PPC_PT_HOT_NEXT + 4)
+
+#define JA_PPC_PT_SIZE          (JA_PPC_PT_HOT_PAGES + JA_PPC_HOT_PAGES_N * 4)
+
+#endif /* __JET_PPC_PAGING_H__ */
@@ -0,0 +1,243 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Performance monitor of the e500 core.
+ *
+ * Its first counter implements the memory access counter for
+ * POK_NEEDS_MEMGUARD (see asp/memguard.h), following counters are
+ * used for performance counters of partitions (POK_NEEDS_PERF_COUNTERS,
+ * see asp/perf.h). Counters are frozen one by one, so they don't
+ * affect each other.
+ *
+ * The core monitor cannot count misses of the platform cache, so
+ * reloads of the L1 data cache are counted instead: every such reload
+ * is a memory access which has missed in L1. TLB misses are not
+ * counted at all.
+ *
+ * Overflow of the memguard counter is signalled with performance
+ * monitor interrupt (IVOR35), which is masked together with external
+ * ones.
+ */
+
+#include <config.h>
+
+#if defined(POK_NEEDS_MEMGUARD) || defined(POK_NEEDS_PERF_COUNTERS)
+
+#include <types.h>
+#include <asp/memguard.h>
+#include <asp/perf.h>
+#include <asp/cpu.h>
+#include <assert.h>
+#include "reg.h"
+
+/* Performance monitor registers, numbers for mfpmr/mtpmr. */
+#define PMRN_PMC0   16
+#define PMRN_PMC1   17
+#define PMRN_PMC2   18
+#define PMRN_PMC3   19
+#define PMRN_PMLCA0 144
+#define PMRN_PMLCA1 145
+#define PMRN_PMLCA2 146
+#define PMRN_PMLCA3 147
+#define PMRN_PMLCB0 272
+#define PMRN_PMLCB1 273
+#define PMRN_PMLCB2 274
+#define PMRN_PMLCB3 275
+#define PMRN_PMGC0  400
+
+#define PMGC0_PMIE  0x40000000 /* Performance monitor interrupt enable. */
+
+#define PMLCA_FC    0x80000000 /* Freeze counter. */
+#define PMLCA_CE    0x04000000 /* Condition enable. */
+#define PMLCA_EVENT(event) (((event) << 16) & 0x00ff0000)
+
+#define PMU_COUNTERS_N 4
+
+/* Events of the core. */
+#define PMU_EVENT_CYCLES       1
+#define PMU_EVENT_INSTRUCTIONS 2
+#define PMU_EVENT_DL1_RELOADS  41
+
+/* Counter used by memguard. Other counters are given to partitions. */
+#ifdef POK_NEEDS_MEMGUARD
+#define PMU_MEMGUARD_COUNTER 0
+#define PMU_PERF_FIRST 1
+#else
+#define PMU_PERF_FIRST 0
+#endif
+
+/* Registers of the counters are accessed with immediate numbers only. */
+#define PMU_ACCESS(n, op, reg) \
+    switch(n) { \
+    case 0: op(reg ## 0); break; \
+    case 1: op(reg ## 1); break; \
+    case 2: op(reg ## 2); break; \
+    default: op(reg ## 3); break; \
+    }
+
+static uint32_t pmc_read(unsigned n)
+{
+    uint32_t value;
+#define PMC_READ(pmr) value = mfpmr(pmr)
+    PMU_ACCESS(n, PMC_READ, PMRN_PMC);
+#undef PMC_READ
+    return value;
+}
+
+static void pmc_write(unsigned n, uint32_t value)
+{
+#define PMC_WRITE(pmr) mtpmr(pmr, value)
+    PMU_ACCESS(n, PMC_WRITE, PMRN_PMC);
+#undef PMC_WRITE
+}
+
+static void pmlca_write(unsigned n, uint32_t value)
+{
+#define PMLCA_WRITE(pmr) mtpmr(pmr, value)
+    PMU_ACCESS(n, PMLCA_WRITE, PMRN_PMLCA);
+#undef PMLCA_WRITE
+}
+
+static void pmlcb_write(unsigned n, uint32_t value)
+{
+#define PMLCB_WRITE(pmr) mtpmr(pmr, value)
+    PMU_ACCESS(n, PMLCB_WRITE, PMRN_PMLCB);
+#undef PMLCB_WRITE
+}
+
+/* Freeze and clear given counter. */
+static void pmu_counter_stop(unsigned n)
+{
+    pmlca_write(n, PMLCA_FC);
+    pmlcb_write(n, 0);
+    pmc_write(n, 0);
+}
+
+/* Clear given counter and count given event with it. */
+static void pmu_counter_start(unsigned n, uint32_t pmlca)
+{
+    pmu_counter_stop(n);
+    // Count in both user and supervisor modes.
+    pmlca_write(n, pmlca);
+}
+
+#endif /* POK_NEEDS_MEMGUARD || POK_NEEDS_PERF_COUNTERS */
+
+#ifdef POK_NEEDS_MEMGUARD
+
+/* Condition (and interrupt) happens when the most significant bit is set. */
+#define PMU_OVERFLOW 0x80000000UL
+
+/* Limit of the running counter on every CPU. */
+static uint32_t pmu_limit[POK_CONFIG_NB_CPUS];
+
+pok_bool_t ja_memguard_init(void)
+{
+    pmu_counter_stop(PMU_MEMGUARD_COUNTER);
+
+    // Only memguard counter enables condition, so interrupt is for it.
+    mtpmr(PMRN_PMGC0, PMGC0_PMIE);
+
+    return TRUE;
+}
+
+void ja_memguard_start(uint32_t limit)
+{
+    assert(limit > 0);
+
+    if(limit > PMU_OVERFLOW - 1) limit = PMU_OVERFLOW - 1;
+
+    pmu_limit[ja_cpu_id()] = limit;
+
+    pmu_counter_start(PMU_MEMGUARD_COUNTER, PMLCA_FC);
+    pmc_write(PMU_MEMGUARD_COUNTER, PMU_OVERFLOW - limit);
+    pmlca_write(PMU_MEMGUARD_COUNTER,
+        PMLCA_CE | PMLCA_EVENT(PMU_EVENT_DL1_RELOADS));
+}
+
+uint32_t ja_memguard_stop(void)
+{
+    uint32_t counter;
+
+    pmlca_write(PMU_MEMGUARD_COUNTER, PMLCA_FC);
+
+    counter = pmc_read(PMU_MEMGUARD_COUNTER);
+
+    // Interrupt is signalled while the condition holds, so clear it.
+    pmu_counter_stop(PMU_MEMGUARD_COUNTER);
+
+    return counter - (PMU_OVERFLOW - pmu_limit[ja_cpu_id()]);
+}
+
+#endif /* POK_NEEDS_MEMGUARD */
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+
+unsigned ja_perf_init(void)
+{
+    unsigned n = PMU_COUNTERS_N - PMU_PERF_FIRST;
+
+    if(n > JET_PERF_COUNTERS_MAX) n = JET_PERF_COUNTERS_MAX;
+
+    for(unsigned i = 0; i < n; i++)
+        pmu_counter_stop(PMU_PERF_FIRST + i);
+
+    return n;
+}
+
+pok_bool_t ja_perf_event_supported(jet_perf_event_t event)
+{
+    switch(event)
+    {
+    case JET_PERF_EVENT_CYCLES:
+    case JET_PERF_EVENT_INSTRUCTIONS:
+    case JET_PERF_EVENT_CACHE_MISSES:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+void ja_perf_start(unsigned index, jet_perf_event_t event)
+{
+    unsigned counter = PMU_PERF_FIRST + index;
+    uint32_t pmu_event;
+
+    switch(event)
+    {
+    case JET_PERF_EVENT_CYCLES:
+        pmu_event = PMU_EVENT_CYCLES;
+        break;
+    case JET_PERF_EVENT_INSTRUCTIONS:
+        pmu_event = PMU_EVENT_INSTRUCTIONS;
+        break;
+    case JET_PERF_EVENT_CACHE_MISSES:
+        pmu_event = PMU_EVENT_DL1_RELOADS;
+        break;
+    default:
+        pmu_counter_stop(counter);
+        return;
+    }
+
+    pmu_counter_start(counter, PMLCA_EVENT(pmu_event));
+}
+
+uint64_t ja_perf_read(unsigned index)
+{
+    return pmc_read(PMU_PERF_FIRST + index);
+}
+
+#endif /* POK_NEEDS_PERF_COUNTERS */
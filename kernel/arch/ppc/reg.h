@@ -27,6 +27,7 @@
 #define SPRN_IVOR13     0x19d   /* Interrupt Vector Offset Register 13 */
 #define SPRN_IVOR14     0x19e   /* Interrupt Vector Offset Register 14 */
 #define SPRN_IVOR15     0x19f   /* Interrupt Vector Offset Register 15 */
+#define SPRN_IVOR35     0x213   /* Interrupt Vector Offset Register 35 */
 #define SPRN_IVOR38     0x1b0   /* Interrupt Vector Offset Register 38 */
 #define SPRN_IVOR39     0x1b1   /* Interrupt Vector Offset Register 39 */
 #define SPRN_IVOR40     0x1b2   /* Interrupt Vector Offset Register 40 */
@@ -37,6 +38,7 @@
 
 #define SPRN_CSRR0      0x03A   /* Critical Save and Restore Register 0 */
 #define SPRN_CSRR1      0x03B   /* Critical Save and Restore Register 1 */
+#define SPRN_SRR0       0x01A   /* Save and Restore Register 0 */
 #define SPRN_DEAR       0x03D   /* Data Error Address Register */
 #define SPRN_ESR        0x03E   /* Exception Syndrome Register */
 #define SPRN_PIR        0x11E   /* Processor Identification Register */
@@ -57,6 +59,9 @@
 
 #define SPRN_PID        0x030   /* Process ID */
 
+#define SPRN_SPRG4R     0x104   /* SPRG4 (user, R/O) */
+#define SPRN_SPRG4W     0x114   /* SPRG4 (super, R/W) */
+
 #define SPRN_MAS0       0x270   /* MMU Assist Register 0 */
 #define SPRN_MAS1       0x271   /* MMU Assist Register 1 */
 #define SPRN_MAS2       0x272   /* MMU Assist Register 2 */
@@ -87,6 +92,14 @@
 #define mtspr(rn, v)    asm volatile("mtspr " __stringify(rn) ",%0" : \
                                              : "r" ((unsigned long)(v)) \
                                              : "memory")
+
+/* Performance monitor registers (PMRs). */
+#define mfpmr(rn)       ({unsigned long rval; \
+                                asm volatile("mfpmr %0," __stringify(rn) \
+                                                                    : "=r" (rval)); rval;})
+#define mtpmr(rn, v)    asm volatile("mtpmr " __stringify(rn) ",%0" : \
+                                             : "r" ((unsigned long)(v)) \
+                                             : "memory")
 #endif // __ASSEMBLY__
 
 #endif
@@ -39,6 +39,37 @@
 //FIXME
 #include <arch/deployment.h>
 
+/* Physical memory, mapped for the kernel by the first TLB1 entry. */
+#define KERNEL_MEMORY_SIZE 0x10000000UL
+
+#ifdef POK_NEEDS_TLB0_PAGING
+#include <asp/alloc.h>
+#include <core/cache_color.h>
+#include "paging.h"
+
+#if POK_PARTITION_MEMORY_BASE != JA_PPC_PARTITION_BASE \
+    || POK_PARTITION_MEMORY_SIZE != JA_PPC_PARTITION_SIZE
+#error Partition memory window in paging.h differs from the one in arch/deployment.h
+#endif
+
+/* Permissions for all pages of the partition. */
+#define PAGE_PERMISSIONS (MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR | MAS3_UX)
+
+/* Number of pages for code, data and heap of the space. */
+static size_t space_pages_normal(const struct ja_ppc_space* space)
+{
+    return ALIGN_VAL((unsigned long)space->size_total, JA_PPC_PAGE_SIZE) >> JA_PPC_PAGE_SHIFT;
+}
+
+/* Number of pages for stacks of the space. They are at the end of the window. */
+static size_t space_pages_stack(const struct ja_ppc_space* space)
+{
+    return ALIGN_VAL((unsigned long)space->size_stack, JA_PPC_PAGE_SIZE) >> JA_PPC_PAGE_SHIFT;
+}
+
+static void tlb0_preload(jet_space_id space_id);
+#endif /* POK_NEEDS_TLB0_PAGING */
+
 void ja_space_layout_get(jet_space_id space_id,
     struct jet_space_layout* space_layout)
 {
@@ -50,6 +81,61 @@ void ja_space_layout_get(jet_space_id space_id,
 }
 
 
+/* TLB has no dirty bits, so modifications are not tracked. */
+pok_bool_t ja_space_is_dirty(jet_space_id space_id,
+    const char __user* user_addr, size_t size)
+{
+    (void)space_id;
+    (void)user_addr;
+    (void)size;
+    return TRUE;
+}
+
+void ja_space_dirty_clear(jet_space_id space_id)
+{
+    (void)space_id;
+}
+
+const void __user* ja_space_map_ro(jet_space_id space_id,
+    const void* addr, size_t size)
+{
+#ifdef POK_NEEDS_TLB0_PAGING
+    struct ja_ppc_space* space = &ja_spaces[space_id - 1];
+    uint32_t* pt = ja_ppc_page_tables[space_id - 1];
+    size_t size_shared = space->size_shared + size;
+
+    assert(((uintptr_t)addr & (JA_PPC_PAGE_SIZE - 1)) == 0);
+    assert((size & (JA_PPC_PAGE_SIZE - 1)) == 0);
+
+    size_t pages_end = JA_PPC_PAGES_N - space_pages_stack(space);
+    size_t pages_n = size_shared >> JA_PPC_PAGE_SHIFT;
+
+    if(space_pages_normal(space) + pages_n > pages_end)
+    {
+        printf("Space %d has no room for read-only mapping of 0x%lx bytes.\n",
+            (int)space_id, (unsigned long)size);
+        pok_fatal("Partition memory exceeds its window");
+    }
+
+    size_t page_first = pages_end - pages_n;
+
+    // Kernel memory is identity mapped.
+    for(size_t n = 0; n < (size >> JA_PPC_PAGE_SHIFT); n++) {
+        pt[page_first + n] = ((uintptr_t)addr + (n << JA_PPC_PAGE_SHIFT))
+            | MAS3_SR | MAS3_UR;
+    }
+
+    space->size_shared = size_shared;
+
+    return (const void __user*)(POK_PARTITION_MEMORY_BASE + (page_first << JA_PPC_PAGE_SHIFT));
+#else
+    (void)space_id;
+    (void)addr;
+    (void)size;
+    return NULL;
+#endif
+}
+
 struct jet_kernel_shared_data* __kuser ja_space_shared_data(jet_space_id space_id)
 {
     return (struct jet_kernel_shared_data* __kuser)POK_PARTITION_MEMORY_BASE;
@@ -67,7 +153,16 @@ void __user* ja_space_get_heap(jet_space_id space_id)
 
 void ja_space_switch (jet_space_id space_id)
 {
+    /*
+     * TLB entries are tagged with PID, so entries of other spaces
+     * remain valid and are not flushed.
+     */
     mtspr(SPRN_PID, space_id);
+
+#ifdef POK_NEEDS_TLB0_PAGING
+    if(space_id != 0)
+        tlb0_preload(space_id);
+#endif
 }
 
 jet_space_id ja_space_get_current (void)
@@ -91,7 +186,14 @@ jet_ustack_t ja_ustack_alloc (jet_space_id space_id, size_t stack_size)
 
     size_t size_real = ALIGN_VAL(stack_size, 16);
 
+#ifdef POK_NEEDS_TLB0_PAGING
+    // Only the last 'size_stack' bytes of the window are mapped for stacks.
+    if(POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE - (*ustack_state_p - size_real)
+        > space_pages_stack(&ja_spaces[space_id - 1]) << JA_PPC_PAGE_SHIFT)
+        return 0;
+#else
     // TODO: Check boundaries.
+#endif
     jet_ustack_t result = *ustack_state_p;
 
     *ustack_state_p -= size_real;
@@ -204,6 +306,7 @@ static inline const char* pok_ppc_tlb_size(unsigned size)
     }
 }
 
+#ifdef POK_NEEDS_TLB0_PAGING
 /*
  *  Quote from the manual:
  *
@@ -212,9 +315,178 @@ static inline const char* pok_ppc_tlb_size(unsigned size)
  *
  *      TLB0 entry replacement is also implemented by software. To assist the software with TLB0 replacement,
  *      the core provides a hint that can be used for implementing a round-robin replacement algorithm. <...>
+ *
+ * Usual TLB0 misses are handled by TLB0_REFILL in entry.S, which uses
+ * the hint. Functions below are used for preloading and for misses
+ * which fall into the slow path.
+ */
+
+/* Number of ways in TLB0 and the way for the next write. */
+static unsigned tlb0_ways;
+static unsigned tlb0_next_way;
+
+/*
+ * Load page of the space into TLB0, unless it is already there.
+ *
+ * Returns FALSE if the page is not mapped.
+ */
+static pok_bool_t tlb0_load_page(jet_space_id space_id, unsigned page)
+{
+    uint32_t pte = ja_ppc_page_tables[space_id - 1][page];
+    uint32_t virtual = POK_PARTITION_MEMORY_BASE + (page << JA_PPC_PAGE_SHIFT);
+
+    if(pte == 0) return FALSE;
+
+    if(pok_ppc_tlb_lookup(virtual, space_id)) return TRUE;
+
+    pok_ppc_tlb_write(0,
+        virtual,
+        pte & MAS3_RPN,
+        E500MC_PGSIZE_4K,
+        pte & MAS3_BAP_MASK,
+        0,
+        space_id,
+        tlb0_next_way,
+        TRUE);
+
+    tlb0_next_way = (tlb0_next_way + 1) % tlb0_ways;
+
+    return TRUE;
+}
+
+/*
+ * Load pages recently used by the space, so it doesn't suffer
+ * from TLB misses after its entries have been evicted by other spaces.
  */
-// XXX not implemented
-void pok_insert_tlb0();
+static void tlb0_preload(jet_space_id space_id)
+{
+    const char* pt = (const char*)ja_ppc_page_tables[space_id - 1];
+    const uint32_t* hot_pages = (const uint32_t*)(pt + JA_PPC_PT_HOT_PAGES);
+
+    for(int i = 0; i < JA_PPC_HOT_PAGES_N; i++) {
+        tlb0_load_page(space_id, hot_pages[i]);
+    }
+}
+
+/* Index in the window of the n-th page of the space. */
+static size_t space_page_index(const struct ja_ppc_space* space, size_t n)
+{
+    size_t pages_normal = space_pages_normal(space);
+
+    if(n < pages_normal) return n;
+
+    return JA_PPC_PAGES_N - space_pages_stack(space) + (n - pages_normal);
+}
+
+/* Allocate page table for the space. */
+static uint32_t* space_alloc_page_table(int i)
+{
+    const struct ja_ppc_space* space = &ja_spaces[i];
+    size_t pages_n = space_pages_normal(space) + space_pages_stack(space);
+    uint32_t* pt;
+
+    if(pages_n > JA_PPC_PAGES_N) {
+        printf("Space %d requires %lu pages, but only %lu fit into the window.\n",
+            i + 1, (unsigned long)pages_n, (unsigned long)JA_PPC_PAGES_N);
+        pok_fatal("Partition memory exceeds its window");
+    }
+
+    pt = ja_mem_alloc_aligned(JA_PPC_PT_SIZE, 4);
+    memset(pt, 0, JA_PPC_PT_SIZE);
+
+    ja_ppc_page_tables[i] = pt;
+
+    return pt;
+}
+
+/*
+ * Place spaces one after another in physical memory and create
+ * page tables for them.
+ *
+ * With cache coloring, spaces with colors are built after all
+ * contiguous ones from the pages of their colors.
+ */
+static void space_init_paging(void)
+{
+    uintptr_t phys_start = ja_spaces[0].phys_base;
+
+    /* Defaults for MAS registers on TLB miss, used by TLB0_REFILL. */
+    mtspr(SPRN_MAS4, MAS4_TLBSELD(0) | MAS4_TSIZED(E500MC_PGSIZE_4K));
+
+    tlb0_ways = TLBnCFG_ASSOC(mfspr(SPRN_TLB0CFG));
+    assert(tlb0_ways > 0);
+
+    for(int i = 0; i < ja_spaces_n; i++)
+    {
+        struct ja_ppc_space* space = &ja_spaces[i];
+        size_t pages_n = space_pages_normal(space) + space_pages_stack(space);
+
+#ifdef POK_NEEDS_CACHE_COLORING
+        if(space->cache_colors != 0) continue;
+#endif
+
+        uint32_t* pt = space_alloc_page_table(i);
+
+        space->phys_base = phys_start;
+
+        for(size_t n = 0; n < pages_n; n++) {
+            pt[space_page_index(space, n)] =
+                (phys_start + (n << JA_PPC_PAGE_SHIFT)) | PAGE_PERMISSIONS;
+        }
+
+        phys_start += pages_n << JA_PPC_PAGE_SHIFT;
+    }
+
+#ifdef POK_NEEDS_CACHE_COLORING
+    // Pages are accessed by the kernel via its own mapping.
+    jet_cache_color_init(phys_start, KERNEL_MEMORY_SIZE);
+
+    for(int i = 0; i < ja_spaces_n; i++)
+    {
+        struct ja_ppc_space* space = &ja_spaces[i];
+        size_t pages_n = space_pages_normal(space) + space_pages_stack(space);
+        unsigned color_next = 0;
+
+        if(space->cache_colors == 0) continue;
+
+        uint32_t* pt = space_alloc_page_table(i);
+
+        for(size_t n = 0; n < pages_n; n++) {
+            uintptr_t phys = jet_cache_color_page_alloc(space->cache_colors, &color_next);
+
+            if(n == 0) space->phys_base = phys;
+
+            pt[space_page_index(space, n)] = phys | PAGE_PERMISSIONS;
+        }
+    }
+#endif /* POK_NEEDS_CACHE_COLORING */
+}
+#endif /* POK_NEEDS_TLB0_PAGING */
+
+/*
+ * Load mapping for the address in partition memory into TLB.
+ *
+ * Returns FALSE if the address is not mapped.
+ */
+static pok_bool_t space_load_mapping(jet_space_id space_id, uintptr_t address)
+{
+#ifdef POK_NEEDS_TLB0_PAGING
+    return tlb0_load_page(space_id,
+        (address - POK_PARTITION_MEMORY_BASE) >> JA_PPC_PAGE_SHIFT);
+#else
+    pok_insert_tlb1(
+        POK_PARTITION_MEMORY_BASE,
+        ja_spaces[space_id - 1].phys_base,
+        E500MC_PGSIZE_16M,
+        MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR | MAS3_UX,
+        0,
+        space_id,
+        FALSE
+    );
+
+    return TRUE;
+#endif
+}
 
 
 void pok_arch_space_init (void)
@@ -225,7 +497,7 @@ void pok_arch_space_init (void)
     pok_insert_tlb1(
         0,
         0,
-        E500MC_PGSIZE_256M,  //TODO make smaller
+        E500MC_PGSIZE_256M,  //TODO make smaller (KERNEL_MEMORY_SIZE)
         MAS3_SW | MAS3_SR | MAS3_SX,
         0,
         0, // any pid
@@ -278,6 +550,10 @@ void pok_arch_space_init (void)
         // This should be checked when generate deployment.c too.
         assert(space->size_total < POK_PARTITION_MEMORY_SIZE);
     }
+
+#ifdef POK_NEEDS_TLB0_PAGING
+    space_init_paging();
+#endif
 }
 
 //TODO get this values from devtree!
@@ -292,23 +568,19 @@ void pok_arch_handle_page_fault(
 {
     int tlb_miss = (type == PF_INST_TLB_MISS || type == PF_DATA_TLB_MISS);
     unsigned pid = mfspr(SPRN_PID);
+#ifdef POK_NEEDS_TLB0_PAGING
+    // Page is selected precisely, and DEAR isn't set on instruction TLB miss.
+    if (type == PF_INST_TLB_MISS)
+        faulting_address = vctx->srr0;
+#endif
     if (
             tlb_miss &&
             pid != 0 &&
             faulting_address >= POK_PARTITION_MEMORY_BASE &&
-            faulting_address < POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE)
+            faulting_address < POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE &&
+            space_load_mapping(pid, faulting_address))
     {
-        jet_space_id space_id = pid;
-
-        pok_insert_tlb1(
-            POK_PARTITION_MEMORY_BASE,
-            ja_spaces[space_id - 1].phys_base,
-            E500MC_PGSIZE_16M,
-            MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR | MAS3_UX,
-            0,
-            pid,
-            FALSE
-        );
+        // Mapping is loaded, the access will be repeated.
     } else {
 #ifdef POK_NEEDS_DEBUG
         if (vctx->srr1 & MSR_PR) {
@@ -339,13 +611,66 @@ uintptr_t pok_virt_to_phys(uintptr_t virt)
 
     jet_space_id space_id = ja_space_get_current();
 
+#ifdef POK_NEEDS_TLB0_PAGING
+    uint32_t pte = ja_ppc_page_tables[space_id - 1][
+        (virt - POK_PARTITION_MEMORY_BASE) >> JA_PPC_PAGE_SHIFT];
+
+    if(pte == 0)
+    {
+        printf("pok_virt_to_phys: unmapped virtual address %p\n", (void*)virt);
+        pok_fatal("wrong pointer in pok_virt_to_phys\n");
+    }
+
+    return (pte & MAS3_RPN) + (virt & (JA_PPC_PAGE_SIZE - 1));
+#else
     return virt - POK_PARTITION_MEMORY_BASE + ja_spaces[space_id - 1].phys_base;
+#endif
 }
 
 uintptr_t pok_phys_to_virt(uintptr_t phys)
 {
     jet_space_id space_id = ja_space_get_current();
 
+#ifdef POK_NEEDS_TLB0_PAGING
+    const struct ja_ppc_space* space = &ja_spaces[space_id - 1];
+
+#ifdef POK_NEEDS_CACHE_COLORING
+    if(space->cache_colors != 0)
+    {
+        // Pages are scattered, so search the page table.
+        const uint32_t* pt = ja_ppc_page_tables[space_id - 1];
+
+        for(size_t page = 0; page < JA_PPC_PAGES_N; page++)
+        {
+            if(pt[page] != 0 && (pt[page] & MAS3_RPN) == (phys & MAS3_RPN))
+                return POK_PARTITION_MEMORY_BASE + (page << JA_PPC_PAGE_SHIFT)
+                    + (phys & (JA_PPC_PAGE_SIZE - 1));
+        }
+
+        printf("pok_phys_to_virt: wrong physical address %p\n", (void*)phys);
+        pok_fatal("wrong pointer in pok_phys_to_virt\n");
+    }
+#endif /* POK_NEEDS_CACHE_COLORING */
+
+    size_t size_normal = space_pages_normal(space) << JA_PPC_PAGE_SHIFT;
+    size_t size_stack = space_pages_stack(space) << JA_PPC_PAGE_SHIFT;
+
+    if((phys < space->phys_base)
+        || (phys >= space->phys_base + size_normal + size_stack))
+    {
+        // Fatal error despite it is called from user space!!
+        printf("pok_phys_to_virt: wrong physical address %p\n", (void*)phys);
+        pok_fatal("wrong pointer in pok_phys_to_virt\n");
+    }
+
+    if(phys < space->phys_base + size_normal)
+        return phys - space->phys_base + POK_PARTITION_MEMORY_BASE;
+
+    // Stacks are mapped at the end of the window.
+    return phys - space->phys_base - size_normal
+        + POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE - size_stack;
+#endif
+
     if((phys < ja_spaces[space_id - 1].phys_base)
         || (phys >= ja_spaces[space_id - 1].phys_base + POK_PARTITION_MEMORY_SIZE))
     {
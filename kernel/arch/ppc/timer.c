@@ -26,12 +26,16 @@
 /* First value of decrementer.  */
 static uint64_t time_first;
 
-
+#ifndef POK_NEEDS_TICKLESS
 /* Last time when decr was set.  */
 static uint64_t time_last;
 
 /* Decrementer optimal value.  */
 static uint32_t time_inter;
+#endif
+
+/* Conversion from timebase ticks to nanoseconds.  */
+static struct jet_time_scale timebase_to_ns;
 
 /*
  * Hardcoded calendar time at the beginning of the OS loading.
@@ -55,6 +59,7 @@ static uint64_t get_timebase(void)
     }
 }
 
+#ifndef POK_NEEDS_TICKLESS
 /* Compute new value for the decrementer.  If the value is in the future,
    sets the decrementer else returns an error.  */
 static int set_decrementer(void)
@@ -97,15 +102,86 @@ void ja_time_init (void)
 {
   time_inter = pok_bsp.timebase_freq / POK_TIMER_FREQUENCY;
   printf("Timer interval: %lu\n", (long unsigned int)time_inter);
+  jet_time_scale_init(&timebase_to_ns, pok_bsp.timebase_freq, 1000000000);
   time_first = time_last = get_timebase ();
   set_decrementer();
 
   mtspr(SPRN_TCR, TCR_DIE); // enable decrementer
 }
 
+#else /* POK_NEEDS_TICKLESS */
+
+/* Maximum value written to the decrementer. */
+#define DEC_MAX 0x7fffffff
+
+/* Conversion from nanoseconds to timebase ticks.  */
+static struct jet_time_scale ns_to_timebase;
+
+/* Called by the interrupt handled.  */
+void pok_arch_decr_int (void)
+{
+  // clear pending intrerrupt
+  mtspr(SPRN_TSR, TSR_DIS);
+
+  // Decrementer will be reprogrammed by the scheduler.
+  jet_on_tick();
+}
+
+void ja_timer_set_oneshot(pok_time_t timepoint)
+{
+  /*
+   * Round up, so ja_system_time() at that timebase value will be
+   * not less than 'timepoint'.
+   */
+  uint64_t time_new = time_first
+    + jet_time_scale_apply(&ns_to_timebase, (uint64_t)timepoint) + 1;
+  uint64_t time_cur = get_timebase();
+  uint32_t delta;
+
+  if (time_new <= time_cur)
+    delta = 1; // Fire as soon as possible.
+  else if (time_new - time_cur > DEC_MAX)
+    delta = DEC_MAX; // Fire earlier, timer will be reprogrammed.
+  else
+    delta = time_new - time_cur;
+
+  mtspr(SPRN_DEC, delta);
+}
+
+void ja_time_init (void)
+{
+  printf("Timebase frequency: %lu (tickless)\n",
+    (long unsigned int)pok_bsp.timebase_freq);
+  jet_time_scale_init(&timebase_to_ns, pok_bsp.timebase_freq, 1000000000);
+  jet_time_scale_init(&ns_to_timebase, 1000000000, pok_bsp.timebase_freq);
+  time_first = get_timebase ();
+
+  // Scheduler will program the first interrupt.
+  mtspr(SPRN_DEC, DEC_MAX);
+
+  mtspr(SPRN_TCR, TCR_DIE); // enable decrementer
+}
+
+#endif /* POK_NEEDS_TICKLESS */
+
+pok_bool_t ja_system_time_params(uint64_t* counter_base,
+  struct jet_time_scale* scale)
+{
+  // Timebase is readable in user space.
+  *counter_base = time_first;
+  *scale = timebase_to_ns;
+
+  return TRUE;
+}
+
+uint64_t ja_time_counter(void)
+{
+  return get_timebase();
+}
+
 pok_time_t ja_system_time(void)
 {
-  return ((get_timebase() - time_first) / time_inter) * 1000000;
+  return jet_time_scale_apply(&timebase_to_ns, get_timebase() - time_first);
 }
 
 time_t ja_calendar_time(void)
@@ -28,7 +28,7 @@
 #include <core/cons.h>
 #include "cons.h"
 
-#if defined (POK_NEEDS_CONSOLE) || defined (POK_NEEDS_DEBUG) || defined (POK_NEEDS_INSTRUMENTATION) || defined (POK_NEEDS_COVERAGE_INFOS)
+#if defined (POK_NEEDS_CONSOLE) || defined (POK_NEEDS_DEBUG) || defined (POK_NEEDS_COVERAGE_INFOS)
 
 static void write_serial(char a)
 {
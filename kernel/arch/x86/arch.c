@@ -22,6 +22,7 @@
 #include "event.h"
 #include "gdt.h"
 #include "space.h"
+#include "fp.h"
 #include <bsp/bsp.h>
 
 void pok_arch_init (void)
@@ -30,6 +31,7 @@ void pok_arch_init (void)
   ja_event_init ();
   ja_bsp_init();
   ja_space_init();
+  ja_fp_hw_init();
 }
 
 void ja_preempt_disable(void)
@@ -37,11 +37,16 @@ void ja_event_init (void)
 
 void ja_idt_init (void)
 {
-   sysdesc_t sysdesc;
-
    /* Clear table */
    memset(pok_idt, 0, sizeof (idt_entry_t) * IDT_SIZE);
 
+   ja_idt_load();
+}
+
+void ja_idt_load (void)
+{
+   sysdesc_t sysdesc;
+
    /* Load IDT */
    sysdesc.limit = sizeof (pok_idt);
    sysdesc.base = (uint32_t)pok_idt;
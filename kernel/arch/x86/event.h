@@ -67,10 +67,17 @@ typedef struct
 // TODO: Currently this is hardcoded exception vector for syscall. This value is used in libpok.
 #define EXCEPTION_SYSCALL 42
 
+/* Interrupts of the local APIC (see lapic.c). */
+#define EXCEPTION_LOCAL_TIMER		0xf0
+#define EXCEPTION_PMC			0xf1
+#define EXCEPTION_SPURIOUS		0xff
+
 void  pok_idt_set_gate(uint8_t     index,
                        void (*entry)(void),
                        e_idte_type  t);
 void ja_idt_init(void);
+/* Load (already initialized) IDT. Used by secondary CPUs. */
+void ja_idt_load(void);
 void ja_exception_init(void);
 void ja_event_init(void);
 
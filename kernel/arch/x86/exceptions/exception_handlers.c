@@ -24,6 +24,9 @@
 
 
 #include <bsp/bsp.h>
+#include <asp/entries.h>
+#include <lapic.h>
+#include <pmu.h>
 
 // Declare exception functions. They are defined in exception_entries.S
 void exception_DIVIDE_ERROR(void);
@@ -46,6 +49,9 @@ void exception_MACHINE_CHECK(void);
 void exception_SIMD_FAULT(void);
 void exception_SYSCALL(void);
 void exception_TIMER(void);
+void exception_LOCAL_TIMER(void);
+void exception_PMC(void);
+void exception_SPURIOUS(void);
 
 
 const struct exception_descriptor exception_list[] =
@@ -70,6 +76,9 @@ const struct exception_descriptor exception_list[] =
     {EXCEPTION_SIMD_FAULT, exception_SIMD_FAULT},
     {EXCEPTION_SYSCALL, exception_SYSCALL},
     {EXCEPTION_TIMER, exception_TIMER},
+    {EXCEPTION_LOCAL_TIMER, exception_LOCAL_TIMER},
+    {EXCEPTION_PMC, exception_PMC},
+    {EXCEPTION_SPURIOUS, exception_SPURIOUS},
     {0, NULL}
 };
 
@@ -172,6 +181,8 @@ void exception_INVALIDOPCODE_handler(interrupt_frame* frame)
 }
 void exception_NOMATH_COPROC_handler(interrupt_frame* frame)
 {
+    if(jet_fp_unavailable())
+        return;
     raise_error_from_interrupt_dump(POK_ERROR_ID_ILLEGAL_REQUEST,
       /*TODO: User or kernel*/TRUE,
       /*TODO: Failed address*/NULL,
@@ -263,3 +274,15 @@ void exception_TIMER_handler(interrupt_frame* frame)
 {
     ja_bsp_process_timer(frame);
 }
+void exception_LOCAL_TIMER_handler(interrupt_frame* frame)
+{
+    ja_lapic_process_timer(frame);
+}
+void exception_PMC_handler(interrupt_frame* frame)
+{
+    ja_pmu_process_overflow(frame);
+}
+void exception_SPURIOUS_handler(interrupt_frame* frame)
+{
+    (void) frame; // Should not be acknowledged.
+}
@@ -51,14 +51,14 @@ void ja_exception_init(void)
 __attribute__((unused))
 static void dump_registers (interrupt_frame *frame)
 {
-  printf ("ES: %lx, DS: %lx\n",  frame->es, frame->ds);
-  printf ("CS: %lx, SS: %lx\n",  frame->cs, frame->ss);
-  printf ("EDI: %lx, ESI: %lx\n", frame->edi, frame->esi);
-  printf ("EBP: %lx, ESP: %lx\n", frame->ebp, frame->esp);
-  printf ("EAX: %lx, ECX: %lx\n", frame->eax, frame->ecx);
-  printf ("EDX: %lx, EBX: %lx\n", frame->edx, frame->ebx);
-  printf ("EIP: %lx, ErrorCode: %lx\n", frame->eip, frame->error);
-  printf ("EFLAGS: %lx\n\n", frame->eflags);
+  printf ("ES: %lx, DS: %lx\n",  (unsigned long)frame->es, (unsigned long)frame->ds);
+  printf ("CS: %lx, SS: %lx\n",  (unsigned long)frame->cs, (unsigned long)frame->ss);
+  printf ("EDI: %lx, ESI: %lx\n", (unsigned long)frame->edi, (unsigned long)frame->esi);
+  printf ("EBP: %lx, ESP: %lx\n", (unsigned long)frame->ebp, (unsigned long)frame->esp);
+  printf ("EAX: %lx, ECX: %lx\n", (unsigned long)frame->eax, (unsigned long)frame->ecx);
+  printf ("EDX: %lx, EBX: %lx\n", (unsigned long)frame->edx, (unsigned long)frame->ebx);
+  printf ("EIP: %lx, ErrorCode: %lx\n", (unsigned long)frame->eip, (unsigned long)frame->error);
+  printf ("EFLAGS: %lx\n\n", (unsigned long)frame->eflags);
 }
 
 /* 
@@ -98,6 +98,9 @@ static void dump_registers (interrupt_frame *frame)
 {%for exception in exceptions%}
 void exception_{{exception.id}}_handler(interrupt_frame* frame)
 {
+{%if exception.code %}
+    {{exception.code | trim | indent(4)}}
+{%endif%}
 {%if exception.raise_error %}
     raise_error_from_interrupt{%if exception.raise_error.dump_registers%}_dump{%endif%}(POK_ERROR_ID_{{exception.raise_error.error_id}},
       /*TODO: User or kernel*/TRUE,
@@ -107,8 +110,6 @@ void exception_{{exception.id}}_handler(interrupt_frame* frame)
 {%endfor%}
 {%endif%}
     );
-{%else%}
-    {{exception.code}}
 {%endif%}
 }
 {%endfor%}
@@ -0,0 +1,234 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Floating point (x87, SSE and, if present, AVX) registers.
+ *
+ * Registers are switched lazily: CR0.TS is set when registers belong
+ * to other thread, and first FP instruction raises #NM, which is
+ * processed by jet_fp_unavailable().
+ */
+
+#include <config.h>
+#include <types.h>
+#include <libc.h>
+#include <assert.h>
+#include <core/debug.h>
+#include <asp/space.h>
+#include <asp/alloc.h>
+#include "fp.h"
+
+#define CR0_MP (1 << 1)
+#define CR0_EM (1 << 2)
+#define CR0_TS (1 << 3)
+
+#define CR4_OSFXSR (1 << 9)
+#define CR4_OSXMMEXCPT (1 << 10)
+#define CR4_OSXSAVE (1 << 18)
+
+#define CPUID_1_EDX_FXSR (1 << 24)
+#define CPUID_1_ECX_XSAVE (1 << 26)
+#define CPUID_D_1_EAX_XSAVEOPT (1 << 0)
+
+/* State components which may be enabled in XCR0: x87, SSE, AVX. */
+#define XCR0_SUPPORTED 0x7
+
+/* Offsets in FXSAVE area (which is also the beginning of XSAVE area). */
+#define FXSAVE_FCW 0
+#define FXSAVE_MXCSR 24
+
+#define FCW_DEFAULT 0x037f
+#define MXCSR_DEFAULT 0x1f80
+
+enum fp_method
+{
+    FP_METHOD_FXSAVE,
+    FP_METHOD_XSAVE,
+    FP_METHOD_XSAVEOPT,
+};
+
+static enum fp_method fp_method;
+/* Size of the store area. */
+static size_t fp_store_size;
+/* Mask of components for XSAVE/XRSTOR. */
+static uint32_t fp_xcr0;
+/*
+ * Initial state of the registers: all zeroes except control words.
+ *
+ * XSAVE header (zero) means "initial state" for every component.
+ */
+static struct jet_fp_store* fp_store_init;
+
+static inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+    asm volatile ("cpuid"
+        : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+        : "a" (leaf), "c" (subleaf));
+}
+
+static inline uint32_t read_cr0(void)
+{
+    uint32_t val;
+    asm volatile ("mov %%cr0, %0" : "=r" (val));
+    return val;
+}
+
+static inline void write_cr0(uint32_t val)
+{
+    asm volatile ("mov %0, %%cr0" : : "r" (val) : "memory");
+}
+
+static inline uint32_t read_cr4(void)
+{
+    uint32_t val;
+    asm volatile ("mov %%cr4, %0" : "=r" (val));
+    return val;
+}
+
+static inline void write_cr4(uint32_t val)
+{
+    asm volatile ("mov %0, %%cr4" : : "r" (val) : "memory");
+}
+
+static inline void xsetbv(uint32_t index, uint32_t low, uint32_t high)
+{
+    asm volatile ("xsetbv" : : "c" (index), "a" (low), "d" (high));
+}
+
+/* Enable instructions, selected by ja_fp_hw_init(), on the current CPU. */
+static void fp_cpu_enable(void)
+{
+    // Native FPU, with WAIT/FWAIT affected by TS.
+    write_cr0((read_cr0() & ~CR0_EM) | CR0_MP);
+    write_cr4(read_cr4() | CR4_OSFXSR | CR4_OSXMMEXCPT);
+
+    if(fp_method != FP_METHOD_FXSAVE)
+    {
+        write_cr4(read_cr4() | CR4_OSXSAVE);
+        xsetbv(0, fp_xcr0, 0);
+    }
+}
+
+void ja_fp_hw_init(void)
+{
+    uint32_t regs[4];
+
+    cpuid(1, 0, regs);
+
+    if(!(regs[3] & CPUID_1_EDX_FXSR))
+        pok_fatal("FXSAVE is not supported by CPU");
+
+    fp_method = FP_METHOD_FXSAVE;
+    fp_store_size = 512;
+
+    if(regs[2] & CPUID_1_ECX_XSAVE)
+    {
+        cpuid(0xd, 0, regs);
+        fp_xcr0 = regs[0] & XCR0_SUPPORTED;
+
+        cpuid(0xd, 1, regs);
+        fp_method = (regs[0] & CPUID_D_1_EAX_XSAVEOPT)
+            ? FP_METHOD_XSAVEOPT : FP_METHOD_XSAVE;
+    }
+
+    fp_cpu_enable();
+
+    if(fp_method != FP_METHOD_FXSAVE)
+    {
+        // EBX is size of the area for components enabled in XCR0.
+        cpuid(0xd, 0, regs);
+        fp_store_size = regs[1];
+    }
+
+    fp_store_init = ja_mem_alloc_aligned(fp_store_size, 64);
+    memset(fp_store_init, 0, fp_store_size);
+    *(uint16_t*)((char*)fp_store_init + FXSAVE_FCW) = FCW_DEFAULT;
+    *(uint32_t*)((char*)fp_store_init + FXSAVE_MXCSR) = MXCSR_DEFAULT;
+
+    // Nobody owns registers yet.
+    ja_fp_disable();
+}
+
+#ifdef POK_NEEDS_SMP
+void ja_fp_hw_init_secondary(void)
+{
+    fp_cpu_enable();
+
+    // Nobody owns registers yet.
+    ja_fp_disable();
+}
+#endif /* POK_NEEDS_SMP */
+
+/*
+ * Allocate place for store floating point registers.
+ *
+ * May be called only during OS init.
+ */
+struct jet_fp_store* ja_alloc_fp_store(void)
+{
+    struct jet_fp_store* res;
+
+    assert(fp_store_init);
+
+    res = ja_mem_alloc_aligned(fp_store_size, 64);
+    memcpy(res, fp_store_init, fp_store_size);
+
+    return res;
+}
+
+/* Save floating point registers into given place. */
+void ja_fp_save(struct jet_fp_store* fp_store)
+{
+    switch(fp_method)
+    {
+    case FP_METHOD_FXSAVE:
+        asm volatile ("fxsave (%0)" : : "r" (fp_store) : "memory");
+        break;
+    case FP_METHOD_XSAVE:
+        asm volatile ("xsave (%0)" : : "r" (fp_store), "a" (fp_xcr0), "d" (0)
+            : "memory");
+        break;
+    case FP_METHOD_XSAVEOPT:
+        asm volatile ("xsaveopt (%0)" : : "r" (fp_store), "a" (fp_xcr0), "d" (0)
+            : "memory");
+        break;
+    }
+}
+
+/* Restore floating point registers into given place. */
+void ja_fp_restore(struct jet_fp_store* fp_store)
+{
+    if(fp_method == FP_METHOD_FXSAVE)
+        asm volatile ("fxrstor (%0)" : : "r" (fp_store) : "memory");
+    else
+        asm volatile ("xrstor (%0)" : : "r" (fp_store), "a" (fp_xcr0), "d" (0)
+            : "memory");
+}
+
+/* Initialize floating point registers with zero. */
+void ja_fp_init(void)
+{
+    ja_fp_restore(fp_store_init);
+}
+
+void ja_fp_enable(void)
+{
+    asm volatile ("clts");
+}
+
+void ja_fp_disable(void)
+{
+    write_cr0(read_cr0() | CR0_TS);
+}
@@ -0,0 +1,37 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_X86_FP_H__
+#define __JET_X86_FP_H__
+
+#include <config.h>
+
+/*
+ * Enable FPU and SSE and select instructions for save/restore
+ * their state (FXSAVE, XSAVE or XSAVEOPT).
+ *
+ * Should be called before any FP store is allocated.
+ */
+void ja_fp_hw_init(void);
+
+#ifdef POK_NEEDS_SMP
+/*
+ * Enable FPU and SSE on the secondary CPU, the same way as
+ * ja_fp_hw_init() has done on the boot one.
+ */
+void ja_fp_hw_init_secondary(void);
+#endif
+
+#endif /* __JET_X86_FP_H__ */
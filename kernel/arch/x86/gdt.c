@@ -21,31 +21,30 @@
 #include <types.h>
 #include <errno.h>
 #include <core/partition_arinc.h>
+#include <asp/cpu.h>
 
 #include "gdt.h"
 #include "sysdesc.h"
 #include "tss.h"
 
-#define GDT_SIZE 256
-
-gdt_entry_t	pok_gdt[GDT_SIZE];
+/*
+ * GDT of every CPU.
+ *
+ * Descriptors are the same in all tables, only 'present' bits of
+ * the space segments differ: every CPU enables segments of the space
+ * it currently executes.
+ */
+gdt_entry_t	pok_gdt[POK_CONFIG_NB_CPUS][GDT_SIZE];
 
-tss_t	pok_tss;
+tss_t	pok_tss[POK_CONFIG_NB_CPUS];
 
-pok_ret_t pok_gdt_init()
+/* Load GDT of given CPU and reload segment registers. */
+static void gdt_load(unsigned int cpu)
 {
    sysdesc_t sysdesc;
 
-   /* Set null descriptor and clear table */
-   memset(pok_gdt, 0, sizeof (gdt_entry_t) * GDT_SIZE);
-
-   /* Set kernel descriptors */
-   gdt_set_segment(GDT_CORE_CODE_SEGMENT, 0, ~0UL, GDTE_CODE, 0);
-   gdt_set_segment(GDT_CORE_DATA_SEGMENT, 0, ~0UL, GDTE_DATA, 0);
-
-   /* Load GDT */
-   sysdesc.limit = sizeof (pok_gdt);
-   sysdesc.base = (uint32_t)pok_gdt;
+   sysdesc.limit = sizeof (pok_gdt[cpu]);
+   sysdesc.base = (uint32_t)pok_gdt[cpu];
 
    asm ("lgdt %0"
          :
@@ -64,6 +63,35 @@ pok_ret_t pok_gdt_init()
          : "i" (GDT_CORE_CODE_SEGMENT << 3),
          "i" (GDT_CORE_DATA_SEGMENT << 3)
          : "eax");
+}
+
+/* Load TSS of given CPU into the task register. */
+static void tss_load(unsigned int cpu)
+{
+   uint16_t sel = GDT_BUILD_SELECTOR(GDT_TSS_SEGMENT(cpu), 0, 0);
+
+   asm ("ltr %0" : :"m"(sel));
+}
+
+/* Copy descriptor from the GDT of the first CPU to GDTs of others. */
+static void gdt_propagate(uint16_t index)
+{
+   unsigned int cpu;
+
+   for(cpu = 1; cpu < POK_CONFIG_NB_CPUS; cpu++)
+      pok_gdt[cpu][index] = pok_gdt[0][index];
+}
+
+pok_ret_t pok_gdt_init()
+{
+   /* Set null descriptor and clear table */
+   memset(pok_gdt, 0, sizeof (pok_gdt));
+
+   /* Set kernel descriptors */
+   gdt_set_segment(GDT_CORE_CODE_SEGMENT, 0, ~0UL, GDTE_CODE, 0);
+   gdt_set_segment(GDT_CORE_DATA_SEGMENT, 0, ~0UL, GDTE_DATA, 0);
+
+   gdt_load(0);
 
    pok_tss_init();
 
@@ -72,22 +100,33 @@ pok_ret_t pok_gdt_init()
 
 int pok_tss_init()
 {
-   uint16_t sel = GDT_BUILD_SELECTOR(GDT_TSS_SEGMENT, 0, 0);
+   unsigned int cpu;
 
-   memset(&pok_tss, 0, sizeof (tss_t));
+   for(cpu = 0; cpu < POK_CONFIG_NB_CPUS; cpu++)
+   {
+      memset(&pok_tss[cpu], 0, sizeof (tss_t));
 
-   pok_tss.ss0 = GDT_BUILD_SELECTOR(GDT_CORE_DATA_SEGMENT, 0, 0);
+      pok_tss[cpu].ss0 = GDT_BUILD_SELECTOR(GDT_CORE_DATA_SEGMENT, 0, 0);
 
-   gdt_set_system(GDT_TSS_SEGMENT, (uint32_t)&pok_tss,
-         sizeof (tss_t), GDTE_TSS, 0);
+      gdt_set_system(GDT_TSS_SEGMENT(cpu), (uint32_t)&pok_tss[cpu],
+            sizeof (tss_t), GDTE_TSS, 0);
+   }
 
-   asm ("ltr %0" : :"m"(sel));
+   tss_load(0);
    return (POK_ERRNO_OK);
 }
 
+#ifdef POK_NEEDS_SMP
+void pok_gdt_init_secondary(unsigned int cpu)
+{
+   gdt_load(cpu);
+   tss_load(cpu);
+}
+#endif /* POK_NEEDS_SMP */
+
 void tss_set_esp0(uint32_t esp0)
 {
-   pok_tss.esp0 = esp0;
+   pok_tss[ja_cpu_id()].esp0 = esp0;
 }
 
 void gdt_set_segment(uint16_t index,
@@ -98,27 +137,29 @@ void gdt_set_segment(uint16_t index,
 {
    if (limit > (1 << 20)) /* 4K granularity */
    {
-      pok_gdt[index].limit_low = (limit >> 12) & 0xFFFF;
-      pok_gdt[index].limit_high = (limit >> 28) & 0xF;
-      pok_gdt[index].granularity = 1;
+      pok_gdt[0][index].limit_low = (limit >> 12) & 0xFFFF;
+      pok_gdt[0][index].limit_high = (limit >> 28) & 0xF;
+      pok_gdt[0][index].granularity = 1;
    }
    else /* 1B granularity */
    {
-      pok_gdt[index].limit_low = limit & 0xFFFF;
-      pok_gdt[index].limit_high = (limit >> 16) & 0xFF;
-      pok_gdt[index].granularity = 0;
+      pok_gdt[0][index].limit_low = limit & 0xFFFF;
+      pok_gdt[0][index].limit_high = (limit >> 16) & 0xFF;
+      pok_gdt[0][index].granularity = 0;
    }
 
-   pok_gdt[index].base_low = base_address & 0xFFFFFF;
-   pok_gdt[index].base_high = (base_address >> 24) & 0xFF;
+   pok_gdt[0][index].base_low = base_address & 0xFFFFFF;
+   pok_gdt[0][index].base_high = (base_address >> 24) & 0xFF;
 
-   pok_gdt[index].type = t & 0xF;
-   pok_gdt[index].dpl = dpl & 0x3;
+   pok_gdt[0][index].type = t & 0xF;
+   pok_gdt[0][index].dpl = dpl & 0x3;
 
-   pok_gdt[index].s = 1;		      /* Segment is data/code type */
-   pok_gdt[index].present = 1;
-   pok_gdt[index].available = 0;
-   pok_gdt[index].op_size = 1;	      /* We work on 32 bits segments */
+   pok_gdt[0][index].s = 1;		      /* Segment is data/code type */
+   pok_gdt[0][index].present = 1;
+   pok_gdt[0][index].available = 0;
+   pok_gdt[0][index].op_size = 1;	      /* We work on 32 bits segments */
+
+   gdt_propagate(index);
 }
 
 void gdt_set_system(uint16_t index,
@@ -127,36 +168,40 @@ void gdt_set_system(uint16_t index,
       e_gdte_type t,
       int dpl)
 {
-   pok_gdt[index].limit_low = limit & 0xFFFF;
-   pok_gdt[index].limit_high = (limit >> 16) & 0xFF;
-   pok_gdt[index].base_low = base_address & 0xFFFFFF;
-   pok_gdt[index].base_high = (base_address >> 24) & 0xFF;
-
-   pok_gdt[index].type = t & 0xF;
-   pok_gdt[index].dpl = dpl & 0x3;
-
-   pok_gdt[index].s = 0;		      /* Segment is system type */
-   pok_gdt[index].present = 1;
-   pok_gdt[index].available = 0;
-   pok_gdt[index].op_size = 0;
+   pok_gdt[0][index].limit_low = limit & 0xFFFF;
+   pok_gdt[0][index].limit_high = (limit >> 16) & 0xFF;
+   pok_gdt[0][index].base_low = base_address & 0xFFFFFF;
+   pok_gdt[0][index].base_high = (base_address >> 24) & 0xFF;
+
+   pok_gdt[0][index].type = t & 0xF;
+   pok_gdt[0][index].dpl = dpl & 0x3;
+
+   pok_gdt[0][index].s = 0;		      /* Segment is system type */
+   pok_gdt[0][index].present = 1;
+   pok_gdt[0][index].available = 0;
+   pok_gdt[0][index].op_size = 0;
+
+   gdt_propagate(index);
 }
 
 void gdt_enable(uint16_t index)
 {
-   pok_gdt[index].present = 1;
+   pok_gdt[ja_cpu_id()][index].present = 1;
 }
 
 void gdt_disable(uint16_t index)
 {
-   pok_gdt[index].present = 0;
+   pok_gdt[ja_cpu_id()][index].present = 0;
 }
 
 int current_segment()
 {
-    if (pok_gdt[GDT_CORE_CODE_SEGMENT].present == 1)
+    gdt_entry_t* gdt = pok_gdt[ja_cpu_id()];
+
+    if (gdt[GDT_CORE_CODE_SEGMENT].present == 1)
         return 0;
     for(int i = 1; i < pok_partitions_arinc_n; i++)
-        if (pok_gdt[GDT_PARTITION_CODE_SEGMENT(i - 1)].present == 1){
+        if (gdt[GDT_PARTITION_CODE_SEGMENT(i - 1)].present == 1){
             return i;
         }
     return -1;
@@ -19,6 +19,7 @@
 #define __POK_X86_GDT_H__
 
 #include <types.h>
+#include <arch/cpu.h>
 
 typedef enum e_gdte_type
 {
@@ -42,9 +43,11 @@ typedef struct
    uint32_t	base_high:8;
 } __attribute__((packed)) gdt_entry_t;
 
+#define GDT_SIZE		JA_X86_GDT_SIZE
+
 #define GDT_CORE_CODE_SEGMENT	1
 #define GDT_CORE_DATA_SEGMENT	2
-#define GDT_TSS_SEGMENT		3
+#define GDT_TSS_SEGMENT(cpu)	JA_X86_GDT_TSS_SEGMENT(cpu)
 
 #define GDT_PARTITION_CODE_SEGMENT(space_id)	(2 + 2 * space_id)
 #define GDT_PARTITION_DATA_SEGMENT(space_id)	(2 + 2 * space_id + 1)
@@ -55,6 +58,11 @@ typedef struct
 pok_ret_t   pok_gdt_init();
 int         pok_tss_init();
 
+#ifdef POK_NEEDS_SMP
+/* Load GDT and TSS of the given secondary CPU. Called on that CPU. */
+void        pok_gdt_init_secondary(unsigned int cpu);
+#endif
+
 void        tss_set_esp0(uint32_t esp0);
 
 void        gdt_set_segment (uint16_t index,
@@ -0,0 +1,44 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_X86_CPU_H__
+#define __JET_X86_CPU_H__
+
+#include <config.h>
+#include <stdint.h>
+
+/* Number of descriptors in the GDT (of every CPU). */
+#define JA_X86_GDT_SIZE 256
+
+/*
+ * Every CPU has its own GDT and TSS. Descriptor of the TSS is placed
+ * at the end of the GDT in reverse order of CPUs, so index of
+ * the descriptor loaded into the task register identifies the CPU.
+ */
+#define JA_X86_GDT_TSS_SEGMENT(cpu) (JA_X86_GDT_SIZE - 1 - (cpu))
+
+#ifdef POK_NEEDS_SMP
+static inline unsigned int ja_cpu_id(void)
+{
+    uint16_t sel;
+
+    /* Not volatile: kernel contexts never migrate between CPUs. */
+    asm ("str %0" : "=r" (sel));
+
+    return JA_X86_GDT_TSS_SEGMENT(0) - (sel >> 3);
+}
+#endif /* POK_NEEDS_SMP */
+
+#endif /* __JET_X86_CPU_H__ */
@@ -53,6 +53,13 @@ struct ja_x86_space
      * Set in deployment.c.
      */
     size_t size_stack;
+
+    /*
+     * Mask of cache colors for the memory pages, 0 for contiguous memory.
+     * 
+     * Set in deployment.c, used with POK_NEEDS_CACHE_COLORING.
+     */
+    uint32_t cache_colors;
     
     /* 
      * Total size for partition's use.
@@ -71,6 +78,11 @@ struct ja_x86_space
      * Memory currently used for stacks.
      */
     size_t size_stack_used;
+    /*
+     * Memory at the end of the window used by read-only mappings
+     * (see ja_space_map_ro()).
+     */
+    size_t size_shared;
 };
 
 /*
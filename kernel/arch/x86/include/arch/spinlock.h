@@ -20,8 +20,10 @@
 
 typedef unsigned char pok_spinlock_t;
 
+/* Compiler barrier: stores of x86 are not reordered with older ones. */
 #define SPIN_UNLOCK(_spin_)                                     \
 {                                                               \
+  asm volatile ("" : : : "memory");                             \
   (_spin_) = 0;                                                 \
 }
 
@@ -33,6 +35,6 @@ typedef unsigned char pok_spinlock_t;
                 "jnz 1b                 \n\t"                   \
                 :                                               \
                 : "m" (_spin_)                                  \
-                : "%al")
+                : "%al", "memory")
 
 #endif /* !__POK_SPINLOCK_H__ */
@@ -17,6 +17,7 @@
 
 #include "interrupt.h"
 #include "tss.h"
+#include <asp/cpu.h>
 #include <gdb.h>
 #include <libc.h>
 
@@ -28,7 +29,7 @@ void update_tss (interrupt_frame* frame)
 {
   if ((frame->cs & 0xffff) != 0x8)
   {
-    pok_tss.esp0 = (uint32_t)frame + sizeof (interrupt_frame);
+    pok_tss[ja_cpu_id()].esp0 = (uint32_t)frame + sizeof (interrupt_frame);
   }
 }
 
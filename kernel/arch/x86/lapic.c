@@ -0,0 +1,162 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <errno.h>
+
+#include "lapic.h"
+#include "event.h"
+
+#include <asp/time.h>
+#include <asp/entries.h>
+#include <core/time.h>
+#include <assert.h>
+
+#define MSR_APIC_BASE 0x1b
+#define MSR_APIC_BASE_ENABLE (1 << 11)
+#define MSR_APIC_BASE_ADDR_MASK 0xfffff000
+
+/* Registers, as offsets from the base. */
+#define LAPIC_EOI           0x0b0
+#define LAPIC_SVR           0x0f0
+#define LAPIC_ICR_LOW       0x300
+#define LAPIC_ICR_HIGH      0x310
+#define LAPIC_LVT_TIMER     0x320
+#define LAPIC_LVT_PMC       0x340
+#define LAPIC_LVT_LINT0     0x350
+#define LAPIC_TIMER_INITIAL 0x380
+#define LAPIC_TIMER_CURRENT 0x390
+#define LAPIC_TIMER_DIVIDE  0x3e0
+
+#define LAPIC_SVR_ENABLE (1 << 8)
+
+#define LAPIC_LVT_MASKED   (1 << 16)
+#define LAPIC_LVT_EXTINT   (7 << 8)
+#define LAPIC_LVT_PERIODIC (1 << 17)
+
+#define LAPIC_ICR_INIT          (5 << 8)
+#define LAPIC_ICR_STARTUP       (6 << 8)
+#define LAPIC_ICR_PENDING       (1 << 12)
+#define LAPIC_ICR_ASSERT        (1 << 14)
+#define LAPIC_ICR_ALL_EXCLUDING (3 << 18)
+
+#define LAPIC_TIMER_DIVIDE_16 0x3
+
+/* Timer counts are measured during 1/LAPIC_CALIBRATE_HZ second. */
+#define LAPIC_CALIBRATE_HZ 100
+
+/* Base address of the local APIC registers. Same for all CPUs. */
+static uintptr_t lapic_base;
+
+/* Initial count of the timer for POK_TIMER_FREQUENCY. */
+static uint32_t lapic_timer_period;
+
+static inline uint64_t rdmsr(uint32_t msr)
+{
+   uint32_t low, high;
+
+   asm volatile ("rdmsr" : "=a" (low), "=d" (high) : "c" (msr));
+
+   return ((uint64_t)high << 32) | low;
+}
+
+static inline uint32_t lapic_read(uint32_t reg)
+{
+   return *(volatile uint32_t*)(lapic_base + reg);
+}
+
+static inline void lapic_write(uint32_t reg, uint32_t value)
+{
+   *(volatile uint32_t*)(lapic_base + reg) = value;
+}
+
+void ja_lapic_init(pok_bool_t is_boot_cpu)
+{
+   uint64_t apic_base = rdmsr(MSR_APIC_BASE);
+
+   assert(apic_base & MSR_APIC_BASE_ENABLE);
+
+   lapic_base = (uintptr_t)(apic_base & MSR_APIC_BASE_ADDR_MASK);
+
+   lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | EXCEPTION_SPURIOUS);
+
+   lapic_write(LAPIC_LVT_LINT0,
+      is_boot_cpu ? LAPIC_LVT_EXTINT : LAPIC_LVT_MASKED);
+   lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | EXCEPTION_LOCAL_TIMER);
+   lapic_write(LAPIC_LVT_PMC, LAPIC_LVT_MASKED | EXCEPTION_PMC);
+}
+
+void ja_lapic_eoi(void)
+{
+   lapic_write(LAPIC_EOI, 0);
+}
+
+static void lapic_send_ipi_all(uint32_t command)
+{
+   lapic_write(LAPIC_ICR_HIGH, 0);
+   lapic_write(LAPIC_ICR_LOW, LAPIC_ICR_ALL_EXCLUDING | LAPIC_ICR_ASSERT | command);
+
+   while(lapic_read(LAPIC_ICR_LOW) & LAPIC_ICR_PENDING);
+}
+
+void ja_lapic_pmc_unmask(void)
+{
+   lapic_write(LAPIC_LVT_PMC, EXCEPTION_PMC);
+}
+
+void ja_lapic_send_init_all(void)
+{
+   lapic_send_ipi_all(LAPIC_ICR_INIT);
+}
+
+void ja_lapic_send_startup_all(uint8_t vector)
+{
+   lapic_send_ipi_all(LAPIC_ICR_STARTUP | vector);
+}
+
+void ja_lapic_timer_calibrate(void)
+{
+   pok_time_t end;
+   uint32_t counts;
+
+   lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+   lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | EXCEPTION_LOCAL_TIMER);
+
+   end = ja_system_time() + 1000000000 / LAPIC_CALIBRATE_HZ;
+   lapic_write(LAPIC_TIMER_INITIAL, 0xffffffff);
+   while(ja_system_time() < end);
+   counts = 0xffffffff - lapic_read(LAPIC_TIMER_CURRENT);
+
+   lapic_write(LAPIC_TIMER_INITIAL, 0);
+
+   lapic_timer_period = (uint32_t)((uint64_t)counts * LAPIC_CALIBRATE_HZ / POK_TIMER_FREQUENCY);
+   assert(lapic_timer_period > 0);
+}
+
+void ja_lapic_timer_start(void)
+{
+   assert(lapic_timer_period > 0);
+
+   lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+   lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_PERIODIC | EXCEPTION_LOCAL_TIMER);
+   lapic_write(LAPIC_TIMER_INITIAL, lapic_timer_period);
+}
+
+void ja_lapic_process_timer(interrupt_frame* frame)
+{
+   (void) frame;
+   ja_lapic_eoi();
+
+   jet_on_tick();
+}
@@ -0,0 +1,75 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Local APIC of the current CPU.
+ *
+ * It is used for start secondary CPUs and for generate timer
+ * interrupts on them, and for deliver overflow interrupts of the
+ * performance monitor (see pmu.h). Boot CPU continues to receive PIT interrupts
+ * via 8259 PIC, which is connected to LINT0 pin of its local APIC.
+ */
+
+#ifndef __JET_X86_LAPIC_H__
+#define __JET_X86_LAPIC_H__
+
+#include <types.h>
+#include <interrupt.h>
+
+/*
+ * Enable local APIC of the current CPU.
+ *
+ * On the boot CPU external interrupts (from PIC) are passed through,
+ * on other CPUs they are masked.
+ */
+void ja_lapic_init(pok_bool_t is_boot_cpu);
+
+/* Acknowledge interrupt, delivered by the local APIC. */
+void ja_lapic_eoi(void);
+
+/*
+ * Allow EXCEPTION_PMC interrupt from the performance monitor.
+ *
+ * Delivery of that interrupt masks it again.
+ */
+void ja_lapic_pmc_unmask(void);
+
+/* Send INIT IPI to all CPUs except the current one. */
+void ja_lapic_send_init_all(void);
+
+/*
+ * Send STARTUP IPI to all CPUs except the current one.
+ *
+ * Receivers start execution in real mode at 'vector' * 4096.
+ */
+void ja_lapic_send_startup_all(uint8_t vector);
+
+/*
+ * Measure frequency of the local APIC timer.
+ *
+ * Should be called on the boot CPU after system time is initialized.
+ */
+void ja_lapic_timer_calibrate(void);
+
+/*
+ * Start periodic interrupts with POK_TIMER_FREQUENCY
+ * from the timer of the current local APIC.
+ */
+void ja_lapic_timer_start(void);
+
+/* Handler for EXCEPTION_LOCAL_TIMER interrupt. */
+void ja_lapic_process_timer(interrupt_frame* frame);
+
+#endif /* __JET_X86_LAPIC_H__ */
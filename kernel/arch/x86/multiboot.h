@@ -45,6 +45,7 @@
  */
 #define MULTIBOOT_STACK_SIZE            0x4000
 
+#define MULTIBOOT_MEMORY 1
 #define MULTIBOOT_CMDLINE 4
 #define MULTIBOOT_MODS 8
 
@@ -0,0 +1,395 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_X86_PAGING
+
+#include <types.h>
+#include <libc.h>
+#include <assert.h>
+#include <common.h>
+#include <core/debug.h>
+#include <asp/cpu.h>
+#include <asp/alloc.h>
+#include <arch/deployment.h>
+
+#include "paging.h"
+
+#define CR0_PG (1UL << 31)
+
+#define CR4_PAE (1 << 5)
+#define CR4_PGE (1 << 7)
+
+#define MSR_EFER 0xc0000080
+#define EFER_NXE (1 << 11)
+
+#define CPUID_80000001_EDX_NX (1 << 20)
+
+/* Bits of the page directory and page table entries. */
+#define PTE_PRESENT (1ULL << 0)
+#define PTE_WRITE   (1ULL << 1)
+#define PTE_USER    (1ULL << 2)
+#define PTE_PWT     (1ULL << 3)
+#define PTE_PCD     (1ULL << 4)
+#define PTE_DIRTY   (1ULL << 6)
+#define PTE_LARGE   (1ULL << 7)
+#define PTE_GLOBAL  (1ULL << 8)
+#define PTE_NX      (1ULL << 63)
+
+#define PTE_ADDR_MASK 0x000ffffffffff000ULL
+
+#define PAGE_SIZE       0x1000UL
+#define LARGE_PAGE_SIZE 0x200000UL
+
+/* Number of entries in every table. */
+#define ENTRIES_N 512
+
+/* Index of the directory for the user window in PDPT. */
+#define USER_WINDOW_PDPTE (JA_X86_USER_WINDOW_BASE >> 30)
+
+typedef uint64_t pte_t;
+
+/* Page tables of one space. */
+struct paging_space
+{
+    /* Page directory pointer table, which is loaded into CR3. */
+    pte_t* pdpt;
+    /* Page directory for the user window. */
+    pte_t* pd_user;
+};
+
+/* Tables for the kernel only (space_id = 0). Window isn't mapped. */
+static struct paging_space paging_kernel;
+
+/* Tables for every user space, indexed by space_id - 1. */
+static struct paging_space* paging_spaces;
+
+/* Page directories for the kernel quarters of the address space. */
+static pte_t* paging_kernel_pds[4];
+
+/* PTE_NX if it is supported by the processor, 0 otherwise. */
+static pte_t paging_nx;
+
+/* Space which tables are currently loaded on every CPU. */
+static jet_space_id paging_current[POK_CONFIG_NB_CPUS];
+
+static inline void cpuid(uint32_t leaf, uint32_t regs[4])
+{
+    asm volatile ("cpuid"
+        : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+        : "a" (leaf), "c" (0));
+}
+
+static inline uint64_t rdmsr(uint32_t msr)
+{
+    uint32_t low, high;
+
+    asm volatile ("rdmsr" : "=a" (low), "=d" (high) : "c" (msr));
+
+    return ((uint64_t)high << 32) | low;
+}
+
+static inline void wrmsr(uint32_t msr, uint64_t value)
+{
+    asm volatile ("wrmsr" : : "c" (msr), "a" ((uint32_t)value),
+        "d" ((uint32_t)(value >> 32)));
+}
+
+static inline void write_cr3(const pte_t* pdpt)
+{
+    asm volatile ("mov %0, %%cr3" : : "r" (pdpt) : "memory");
+}
+
+/* Allocate zeroed table. Kernel memory is identity mapped. */
+static pte_t* paging_alloc_table(size_t size)
+{
+    pte_t* table = ja_mem_alloc_aligned(size, size);
+
+    memset(table, 0, size);
+
+    return table;
+}
+
+static void paging_space_create(struct paging_space* space, pte_t* pd_user)
+{
+    space->pdpt = paging_alloc_table(4 * sizeof(pte_t));
+    space->pd_user = pd_user;
+
+    for(int i = 0; i < 4; i++)
+    {
+        pte_t* pd = (i == USER_WINDOW_PDPTE) ? pd_user : paging_kernel_pds[i];
+
+        if(pd != NULL)
+            space->pdpt[i] = (uintptr_t)pd | PTE_PRESENT;
+    }
+}
+
+/* Enable paging with kernel tables on the current CPU. */
+static void paging_enable(void)
+{
+    uint32_t cr0, cr4;
+
+    if(paging_nx)
+        wrmsr(MSR_EFER, rdmsr(MSR_EFER) | EFER_NXE);
+
+    asm volatile ("mov %%cr4, %0" : "=r" (cr4));
+    asm volatile ("mov %0, %%cr4" : : "r" (cr4 | CR4_PAE) : "memory");
+
+    write_cr3(paging_kernel.pdpt);
+
+    asm volatile ("mov %%cr0, %0" : "=r" (cr0));
+    asm volatile ("mov %0, %%cr0" : : "r" (cr0 | CR0_PG) : "memory");
+
+    /* Global pages may be enabled only when paging is on. */
+    asm volatile ("mov %0, %%cr4" : : "r" (cr4 | CR4_PAE | CR4_PGE) : "memory");
+}
+
+void ja_paging_init(void)
+{
+    uint32_t regs[4];
+
+    cpuid(0x80000000, regs);
+    if(regs[0] >= 0x80000001)
+    {
+        cpuid(0x80000001, regs);
+        if(regs[3] & CPUID_80000001_EDX_NX)
+            paging_nx = PTE_NX;
+    }
+
+    for(int i = 0; i < 4; i++)
+    {
+        pte_t flags = PTE_PRESENT | PTE_WRITE | PTE_LARGE | PTE_GLOBAL;
+
+        if(i == USER_WINDOW_PDPTE) continue;
+
+        // Last quarter contains only devices.
+        if(i == 3) flags |= PTE_PCD | PTE_PWT;
+
+        paging_kernel_pds[i] = paging_alloc_table(ENTRIES_N * sizeof(pte_t));
+
+        for(int j = 0; j < ENTRIES_N; j++)
+        {
+            uint64_t phys = ((uint64_t)i << 30) + (uint64_t)j * LARGE_PAGE_SIZE;
+            paging_kernel_pds[i][j] = phys | flags;
+        }
+    }
+
+    paging_space_create(&paging_kernel, NULL);
+
+    paging_spaces = ja_mem_alloc_aligned(ja_spaces_n * sizeof(*paging_spaces), 4);
+
+    for(int i = 0; i < ja_spaces_n; i++)
+    {
+        paging_space_create(&paging_spaces[i],
+            paging_alloc_table(ENTRIES_N * sizeof(pte_t)));
+    }
+
+    paging_enable();
+}
+
+void ja_paging_init_secondary(void)
+{
+    paging_enable();
+}
+
+void ja_paging_map(jet_space_id space_id, uintptr_t user_addr,
+    uintptr_t phys, size_t size, unsigned access)
+{
+    assert(space_id != 0 && space_id <= ja_spaces_n);
+    assert((user_addr & (PAGE_SIZE - 1)) == 0);
+    assert((phys & (PAGE_SIZE - 1)) == 0);
+    assert(user_addr >= JA_X86_USER_WINDOW_BASE);
+    assert(user_addr + size <= JA_X86_USER_WINDOW_BASE + JA_X86_USER_WINDOW_SIZE);
+
+    pte_t* pd = paging_spaces[space_id - 1].pd_user;
+    pte_t flags = PTE_PRESENT | PTE_USER;
+
+    if(access & JA_X86_PAGE_WRITE) flags |= PTE_WRITE;
+    if(!(access & JA_X86_PAGE_EXEC)) flags |= paging_nx;
+
+    while(size > 0)
+    {
+        unsigned pd_index = (user_addr - JA_X86_USER_WINDOW_BASE) / LARGE_PAGE_SIZE;
+
+        if((user_addr & (LARGE_PAGE_SIZE - 1)) == 0
+            && (phys & (LARGE_PAGE_SIZE - 1)) == 0
+            && size >= LARGE_PAGE_SIZE)
+        {
+            assert(pd[pd_index] == 0);
+            pd[pd_index] = (pte_t)phys | flags | PTE_LARGE;
+
+            user_addr += LARGE_PAGE_SIZE;
+            phys += LARGE_PAGE_SIZE;
+            size -= LARGE_PAGE_SIZE;
+            continue;
+        }
+
+        if(pd[pd_index] == 0)
+        {
+            // Access rights are checked on every level, so the directory entry allows everything.
+            pte_t* pt_new = paging_alloc_table(ENTRIES_N * sizeof(pte_t));
+            pd[pd_index] = (uintptr_t)pt_new | PTE_PRESENT | PTE_WRITE | PTE_USER;
+        }
+        assert(!(pd[pd_index] & PTE_LARGE));
+
+        pte_t* pt = (pte_t*)(uintptr_t)(pd[pd_index] & PTE_ADDR_MASK);
+        unsigned pt_index = (user_addr / PAGE_SIZE) % ENTRIES_N;
+
+        pt[pt_index] = (pte_t)phys | flags;
+
+        user_addr += PAGE_SIZE;
+        phys += PAGE_SIZE;
+        size = (size > PAGE_SIZE) ? size - PAGE_SIZE : 0;
+    }
+}
+
+uintptr_t ja_paging_virt_to_phys(jet_space_id space_id, uintptr_t user_addr)
+{
+    assert(space_id != 0 && space_id <= ja_spaces_n);
+
+    if(user_addr < JA_X86_USER_WINDOW_BASE
+        || user_addr >= JA_X86_USER_WINDOW_BASE + JA_X86_USER_WINDOW_SIZE)
+        return 0;
+
+    pte_t pde = paging_spaces[space_id - 1].pd_user[
+        (user_addr - JA_X86_USER_WINDOW_BASE) / LARGE_PAGE_SIZE];
+
+    if(!(pde & PTE_PRESENT)) return 0;
+
+    if(pde & PTE_LARGE)
+        return (uintptr_t)(pde & PTE_ADDR_MASK) + (user_addr & (LARGE_PAGE_SIZE - 1));
+
+    pte_t* pt = (pte_t*)(uintptr_t)(pde & PTE_ADDR_MASK);
+    pte_t pte = pt[(user_addr / PAGE_SIZE) % ENTRIES_N];
+
+    if(!(pte & PTE_PRESENT)) return 0;
+
+    return (uintptr_t)(pte & PTE_ADDR_MASK) + (user_addr & (PAGE_SIZE - 1));
+}
+
+uintptr_t ja_paging_phys_to_virt(jet_space_id space_id, uintptr_t phys)
+{
+    assert(space_id != 0 && space_id <= ja_spaces_n);
+
+    const pte_t* pd = paging_spaces[space_id - 1].pd_user;
+
+    for(int i = 0; i < ENTRIES_N; i++)
+    {
+        uintptr_t pd_addr = JA_X86_USER_WINDOW_BASE + i * LARGE_PAGE_SIZE;
+
+        if(!(pd[i] & PTE_PRESENT)) continue;
+
+        if(pd[i] & PTE_LARGE)
+        {
+            uintptr_t page = (uintptr_t)(pd[i] & PTE_ADDR_MASK);
+
+            if(phys >= page && phys < page + LARGE_PAGE_SIZE)
+                return pd_addr + (phys - page);
+
+            continue;
+        }
+
+        const pte_t* pt = (const pte_t*)(uintptr_t)(pd[i] & PTE_ADDR_MASK);
+
+        for(int j = 0; j < ENTRIES_N; j++)
+        {
+            if((pt[j] & PTE_PRESENT)
+                && (uintptr_t)(pt[j] & PTE_ADDR_MASK) == (phys & ~(PAGE_SIZE - 1)))
+                return pd_addr + j * PAGE_SIZE + (phys & (PAGE_SIZE - 1));
+        }
+    }
+
+    return 0;
+}
+
+pok_bool_t ja_paging_is_dirty(jet_space_id space_id, uintptr_t user_addr, size_t size)
+{
+    assert(space_id != 0 && space_id <= ja_spaces_n);
+    assert(user_addr >= JA_X86_USER_WINDOW_BASE);
+    assert(user_addr + size <= JA_X86_USER_WINDOW_BASE + JA_X86_USER_WINDOW_SIZE);
+
+    const pte_t* pd = paging_spaces[space_id - 1].pd_user;
+    uintptr_t end = user_addr + size;
+
+    while(user_addr < end)
+    {
+        pte_t pde = pd[(user_addr - JA_X86_USER_WINDOW_BASE) / LARGE_PAGE_SIZE];
+
+        // Unmapped memory cannot be restored, so it is reported as dirty.
+        if(!(pde & PTE_PRESENT)) return TRUE;
+
+        if(pde & PTE_LARGE)
+        {
+            if(pde & PTE_DIRTY) return TRUE;
+
+            user_addr = (user_addr & ~(LARGE_PAGE_SIZE - 1)) + LARGE_PAGE_SIZE;
+            continue;
+        }
+
+        const pte_t* pt = (const pte_t*)(uintptr_t)(pde & PTE_ADDR_MASK);
+        pte_t pte = pt[(user_addr / PAGE_SIZE) % ENTRIES_N];
+
+        if(!(pte & PTE_PRESENT) || (pte & PTE_DIRTY)) return TRUE;
+
+        user_addr = (user_addr & ~(PAGE_SIZE - 1)) + PAGE_SIZE;
+    }
+
+    return FALSE;
+}
+
+void ja_paging_dirty_clear(jet_space_id space_id)
+{
+    assert(space_id != 0 && space_id <= ja_spaces_n);
+
+    pte_t* pd = paging_spaces[space_id - 1].pd_user;
+
+    for(int i = 0; i < ENTRIES_N; i++)
+    {
+        if(!(pd[i] & PTE_PRESENT)) continue;
+
+        if(pd[i] & PTE_LARGE)
+        {
+            pd[i] &= ~PTE_DIRTY;
+            continue;
+        }
+
+        pte_t* pt = (pte_t*)(uintptr_t)(pd[i] & PTE_ADDR_MASK);
+
+        for(int j = 0; j < ENTRIES_N; j++)
+            pt[j] &= ~PTE_DIRTY;
+    }
+
+    /*
+     * Processor doesn't set the dirty bit again while the page is in
+     * the TLB. Pages of the window aren't global, so reloading of CR3
+     * flushes them. Other CPUs never load this space.
+     */
+    if(paging_current[ja_cpu_id()] == space_id)
+        write_cr3(paging_spaces[space_id - 1].pdpt);
+}
+
+void ja_paging_switch(jet_space_id space_id)
+{
+    jet_space_id* current = &paging_current[ja_cpu_id()];
+
+    if(space_id == 0 || space_id == *current) return;
+
+    write_cr3(paging_spaces[space_id - 1].pdpt);
+
+    *current = space_id;
+}
+
+#endif /* POK_NEEDS_X86_PAGING */
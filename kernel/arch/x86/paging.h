@@ -0,0 +1,101 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * PAE paging for user spaces (POK_NEEDS_X86_PAGING).
+ *
+ * Virtual memory is split into 1G quarters, each described by its own
+ * page directory:
+ *
+ *   0..2G - identity mapping of the physical memory, kernel only.
+ *   2G..3G - window of the current user space (POK_PARTITION_MEMORY_BASE).
+ *   3G..4G - identity mapping of the devices (local APIC), kernel only.
+ *
+ * Kernel directories are shared by all spaces and their pages are global,
+ * so they are not flushed from the TLB when the space changes.
+ */
+
+#ifndef __JET_X86_PAGING_H__
+#define __JET_X86_PAGING_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_X86_PAGING
+
+#include <types.h>
+#include <asp/space.h>
+
+/* Window of the user space. Should be aligned on 1G. */
+#define JA_X86_USER_WINDOW_BASE 0x80000000UL
+#define JA_X86_USER_WINDOW_SIZE 0x40000000UL
+
+/* Access rights for user pages. */
+#define JA_X86_PAGE_EXEC  1
+#define JA_X86_PAGE_WRITE 2
+
+/* Create page tables for the kernel and enable paging on the boot CPU. */
+void ja_paging_init(void);
+
+/* Enable paging on the secondary CPU. */
+void ja_paging_init_secondary(void);
+
+/*
+ * Map range of the physical memory into the window of the space.
+ *
+ * 'user_addr', 'phys' and 'size' should be aligned on 4K. Large (2M)
+ * pages are used where both addresses allow that.
+ */
+void ja_paging_map(jet_space_id space_id, uintptr_t user_addr,
+    uintptr_t phys, size_t size, unsigned access);
+
+/*
+ * Translate address in the window of the space into physical one.
+ *
+ * Returns 0 if the address is not mapped.
+ */
+uintptr_t ja_paging_virt_to_phys(jet_space_id space_id, uintptr_t user_addr);
+
+/*
+ * Find address in the window of the space, which is mapped to given
+ * physical address.
+ *
+ * Returns 0 if the physical address is not mapped into the space.
+ */
+uintptr_t ja_paging_phys_to_virt(jet_space_id space_id, uintptr_t phys);
+
+/*
+ * Return whether any page of the window in given range has been written
+ * since the last ja_paging_dirty_clear() for the space.
+ *
+ * Dirty state is tracked by the processor with granularity of the page
+ * (4K or 2M).
+ */
+pok_bool_t ja_paging_is_dirty(jet_space_id space_id, uintptr_t user_addr, size_t size);
+
+/* Mark all pages of the space as clean. */
+void ja_paging_dirty_clear(jet_space_id space_id);
+
+/*
+ * Make page tables of the space current.
+ *
+ * With space_id = 0 tables of the previous space are left loaded:
+ * kernel threads don't access user memory via the window, and
+ * returning to the same space doesn't require TLB flush.
+ */
+void ja_paging_switch(jet_space_id space_id);
+
+#endif /* POK_NEEDS_X86_PAGING */
+
+#endif /* __JET_X86_PAGING_H__ */
@@ -0,0 +1,270 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#include "pmu.h"
+
+#include <asp/entries.h>
+#include <lapic.h>
+
+#if defined(POK_NEEDS_MEMGUARD) || defined(POK_NEEDS_PERF_COUNTERS)
+
+#include <asp/memguard.h>
+#include <asp/perf.h>
+#include <asp/cpu.h>
+#include <assert.h>
+
+#define CPUID_PMU_LEAF 0x0a
+
+/* Version of the architectural performance monitor, EAX[7:0]. */
+#define CPUID_PMU_VERSION(eax) ((eax) & 0xff)
+/* Number of general-purpose counters, EAX[15:8]. */
+#define CPUID_PMU_COUNTERS_N(eax) (((eax) >> 8) & 0xff)
+/* Width of the counters, EAX[23:16]. */
+#define CPUID_PMU_WIDTH(eax) (((eax) >> 16) & 0xff)
+/* Length of the EBX vector with unavailable events, EAX[31:24]. */
+#define CPUID_PMU_EVENTS_N(eax) (((eax) >> 24) & 0xff)
+
+/* Bits in EBX, set if corresponded architectural event is NOT available. */
+#define CPUID_PMU_NO_CYCLES       (1 << 0)
+#define CPUID_PMU_NO_INSTRUCTIONS (1 << 1)
+#define CPUID_PMU_NO_LLC_MISSES   (1 << 4)
+
+#define MSR_PMC(n)               (0x0c1 + (n))
+#define MSR_PERFEVTSEL(n)        (0x186 + (n))
+#define MSR_PERF_GLOBAL_CTRL     0x38f
+#define MSR_PERF_GLOBAL_OVF_CTRL 0x390
+
+#define EVTSEL_USR (1 << 16)
+#define EVTSEL_OS  (1 << 17)
+#define EVTSEL_INT (1 << 20)
+#define EVTSEL_EN  (1 << 22)
+
+/* Architectural event "LLC Misses": umask 0x41, event 0x2e. */
+#define EVTSEL_LLC_MISSES 0x412e
+
+/* Counter used by memguard. Other counters are given to partitions. */
+#ifdef POK_NEEDS_MEMGUARD
+#define PMU_MEMGUARD_COUNTER 0
+#define PMU_PERF_FIRST 1
+#else
+#define PMU_PERF_FIRST 0
+#endif
+
+/* Properties of the monitor. Same for all CPUs. */
+static uint8_t pmu_version;
+static uint8_t pmu_counters_n;
+static uint64_t pmu_counter_mask;
+/* Unavailable architectural events, as in EBX of CPUID. */
+static uint32_t pmu_events_unavailable;
+
+static inline void cpuid(uint32_t leaf, uint32_t regs[4])
+{
+    asm volatile ("cpuid"
+        : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+        : "a" (leaf), "c" (0));
+}
+
+static inline uint64_t rdmsr(uint32_t msr)
+{
+    uint32_t low, high;
+
+    asm volatile ("rdmsr" : "=a" (low), "=d" (high) : "c" (msr));
+
+    return ((uint64_t)high << 32) | low;
+}
+
+static inline void wrmsr(uint32_t msr, uint64_t value)
+{
+    asm volatile ("wrmsr" : : "c" (msr), "a" ((uint32_t)value),
+        "d" ((uint32_t)(value >> 32)));
+}
+
+/*
+ * Detect the monitor. Called on every CPU, so counters of the current
+ * one are enabled globally here.
+ *
+ * Return FALSE if there is no architectural monitor (e.g., QEMU
+ * without KVM reports version 0).
+ */
+static pok_bool_t pmu_detect(void)
+{
+    uint32_t regs[4];
+    unsigned events_n;
+
+    cpuid(0, regs);
+    if(regs[0] < CPUID_PMU_LEAF) return FALSE;
+
+    cpuid(CPUID_PMU_LEAF, regs);
+    if(CPUID_PMU_VERSION(regs[0]) == 0) return FALSE;
+
+    pmu_version = CPUID_PMU_VERSION(regs[0]);
+    pmu_counters_n = CPUID_PMU_COUNTERS_N(regs[0]);
+    pmu_counter_mask = ((uint64_t)1 << CPUID_PMU_WIDTH(regs[0])) - 1;
+
+    // Events beyond the vector are unavailable too.
+    events_n = CPUID_PMU_EVENTS_N(regs[0]);
+    pmu_events_unavailable = regs[1];
+    if(events_n < 32) pmu_events_unavailable |= ~((1UL << events_n) - 1);
+
+    for(unsigned i = 0; i < pmu_counters_n; i++)
+        wrmsr(MSR_PERFEVTSEL(i), 0);
+
+    // Since version 2 counters are also enabled globally.
+    if(pmu_version >= 2)
+        wrmsr(MSR_PERF_GLOBAL_CTRL, (1ULL << pmu_counters_n) - 1);
+
+    return TRUE;
+}
+
+#endif /* POK_NEEDS_MEMGUARD || POK_NEEDS_PERF_COUNTERS */
+
+#ifdef POK_NEEDS_MEMGUARD
+
+/* Writes to counters are sign-extended from 32 bits, so limit is below that. */
+#define PMU_LIMIT_MAX 0x7fffffffUL
+
+/* Limit of the running counter on every CPU. */
+static uint32_t pmu_limit[POK_CONFIG_NB_CPUS];
+
+pok_bool_t ja_memguard_init(void)
+{
+    if(!pmu_detect() || pmu_counters_n == 0
+        || (pmu_events_unavailable & CPUID_PMU_NO_LLC_MISSES))
+        return FALSE;
+
+#ifndef POK_NEEDS_SMP
+    // With SMP local APIC is already initialized by ja_cpu_start_secondary().
+    ja_lapic_init(TRUE);
+#endif
+
+    return TRUE;
+}
+
+void ja_memguard_start(uint32_t limit)
+{
+    assert(limit > 0);
+
+    if(limit > PMU_LIMIT_MAX) limit = PMU_LIMIT_MAX;
+
+    pmu_limit[ja_cpu_id()] = limit;
+
+    // Counter overflows after 'limit' events.
+    wrmsr(MSR_PMC(PMU_MEMGUARD_COUNTER), (uint32_t)(0 - limit));
+    // Delivery of the interrupt masks it in LVT.
+    ja_lapic_pmc_unmask();
+    wrmsr(MSR_PERFEVTSEL(PMU_MEMGUARD_COUNTER), EVTSEL_LLC_MISSES
+        | EVTSEL_USR | EVTSEL_OS | EVTSEL_INT | EVTSEL_EN);
+}
+
+uint32_t ja_memguard_stop(void)
+{
+    uint32_t counter;
+
+    wrmsr(MSR_PERFEVTSEL(PMU_MEMGUARD_COUNTER), 0);
+
+    counter = (uint32_t)rdmsr(MSR_PMC(PMU_MEMGUARD_COUNTER));
+
+    if(pmu_version >= 2)
+        wrmsr(MSR_PERF_GLOBAL_OVF_CTRL, 1ULL << PMU_MEMGUARD_COUNTER);
+
+    // Counter has started from -limit.
+    return counter + pmu_limit[ja_cpu_id()];
+}
+
+#endif /* POK_NEEDS_MEMGUARD */
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+
+/*
+ * Event selectors for partitions' events.
+ *
+ * TLB misses are not architectural events: encodings are of Intel Core
+ * processors since Nehalem (DTLB_LOAD_MISSES.MISS_CAUSES_A_WALK and
+ * ITLB_MISSES.MISS_CAUSES_A_WALK).
+ */
+static const uint32_t pmu_perf_events[] = {
+    [JET_PERF_EVENT_CYCLES] = 0x003c,
+    [JET_PERF_EVENT_INSTRUCTIONS] = 0x00c0,
+    [JET_PERF_EVENT_CACHE_MISSES] = EVTSEL_LLC_MISSES,
+    [JET_PERF_EVENT_DTLB_MISSES] = 0x0108,
+    [JET_PERF_EVENT_ITLB_MISSES] = 0x0185,
+};
+
+/* Whether monitor is detected. */
+static pok_bool_t pmu_perf_enabled;
+
+unsigned ja_perf_init(void)
+{
+    unsigned n;
+
+    pmu_perf_enabled = pmu_detect();
+    if(!pmu_perf_enabled || pmu_counters_n <= PMU_PERF_FIRST) return 0;
+
+    n = pmu_counters_n - PMU_PERF_FIRST;
+
+    return n < JET_PERF_COUNTERS_MAX ? n : JET_PERF_COUNTERS_MAX;
+}
+
+pok_bool_t ja_perf_event_supported(jet_perf_event_t event)
+{
+    if(!pmu_perf_enabled) return FALSE;
+
+    switch(event)
+    {
+    case JET_PERF_EVENT_CYCLES:
+        return !(pmu_events_unavailable & CPUID_PMU_NO_CYCLES);
+    case JET_PERF_EVENT_INSTRUCTIONS:
+        return !(pmu_events_unavailable & CPUID_PMU_NO_INSTRUCTIONS);
+    case JET_PERF_EVENT_CACHE_MISSES:
+        return !(pmu_events_unavailable & CPUID_PMU_NO_LLC_MISSES);
+    case JET_PERF_EVENT_DTLB_MISSES:
+    case JET_PERF_EVENT_ITLB_MISSES:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+void ja_perf_start(unsigned index, jet_perf_event_t event)
+{
+    unsigned counter = PMU_PERF_FIRST + index;
+
+    wrmsr(MSR_PERFEVTSEL(counter), 0);
+
+    if(event == JET_PERF_EVENT_NONE) return;
+
+    wrmsr(MSR_PMC(counter), 0);
+    wrmsr(MSR_PERFEVTSEL(counter), pmu_perf_events[event]
+        | EVTSEL_USR | EVTSEL_OS | EVTSEL_EN);
+}
+
+uint64_t ja_perf_read(unsigned index)
+{
+    return rdmsr(MSR_PMC(PMU_PERF_FIRST + index)) & pmu_counter_mask;
+}
+
+#endif /* POK_NEEDS_PERF_COUNTERS */
+
+void ja_pmu_process_overflow(interrupt_frame* frame)
+{
+    (void) frame;
+    ja_lapic_eoi();
+
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_overflow();
+#endif
+}
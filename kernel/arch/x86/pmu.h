@@ -0,0 +1,35 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Architectural performance monitor of the current CPU.
+ *
+ * Its first counter implements the memory access counter for
+ * POK_NEEDS_MEMGUARD (see asp/memguard.h): it counts last level cache
+ * misses and signals overflow with EXCEPTION_PMC interrupt of the
+ * local APIC. Following counters are used for performance counters of
+ * partitions (POK_NEEDS_PERF_COUNTERS, see asp/perf.h).
+ */
+
+#ifndef __JET_X86_PMU_H__
+#define __JET_X86_PMU_H__
+
+#include <types.h>
+#include <interrupt.h>
+
+/* Handler for EXCEPTION_PMC interrupt. */
+void ja_pmu_process_overflow(interrupt_frame* frame);
+
+#endif /* __JET_X86_PMU_H__ */
@@ -0,0 +1,138 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Start of the secondary CPUs (application processors).
+ *
+ * All processors are woken up with broadcast INIT-SIPI-SIPI sequence
+ * and start in real mode at the trampoline (smp_trampoline.S). It
+ * enters protected mode, takes the next CPU index and the stack for it,
+ * and calls ja_smp_secondary_entry().
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_SMP
+
+#include <types.h>
+#include <libc.h>
+#include <compiler.h>
+#include <assert.h>
+#include <core/debug.h>
+#include <asp/cpu.h>
+#include <asp/entries.h>
+#include <asp/stack.h>
+#include <asp/time.h>
+#include <asp/arch.h>
+
+#include "gdt.h"
+#include "event.h"
+#include "fp.h"
+#include "lapic.h"
+#include "paging.h"
+
+/* Should be the same as in smp_trampoline.S. */
+#define SMP_TRAMPOLINE_ADDR 0x8000
+
+#define SMP_STACK_SIZE 4096
+
+/* Time to wait for secondary CPUs, in nanoseconds. */
+#define SMP_START_TIMEOUT 1000000000
+
+/* Defined in smp_trampoline.S. */
+extern char ja_smp_trampoline_start[];
+extern char ja_smp_trampoline_end[];
+
+/*
+ * Index of the next CPU to start. Incremented by the trampoline.
+ *
+ * Boot CPU has index 0.
+ */
+volatile uint32_t ja_smp_cpu_next = 1;
+
+/* Initial stack for every CPU. Used by the trampoline. */
+jet_stack_t ja_smp_stacks[POK_CONFIG_NB_CPUS];
+
+/* Number of CPUs which have finished their initialization. */
+static volatile uint32_t smp_cpus_online = 1;
+
+static void smp_delay(pok_time_t ns)
+{
+   pok_time_t end = ja_system_time() + ns;
+
+   while(ja_system_time() < end);
+}
+
+void ja_smp_secondary_entry(uint32_t cpu);
+
+void ja_smp_secondary_entry(uint32_t cpu)
+{
+   pok_gdt_init_secondary(cpu);
+#ifdef POK_NEEDS_X86_PAGING
+   ja_paging_init_secondary();
+#endif
+   ja_idt_load();
+   ja_fp_hw_init_secondary();
+
+   ja_lapic_init(FALSE);
+   ja_lapic_timer_start();
+
+   assert(ja_cpu_id() == cpu);
+
+   asm volatile ("lock incl %0" : "+m" (smp_cpus_online) : : "memory");
+
+   jet_boot_secondary();
+
+   ja_inf_loop();
+}
+
+void ja_cpu_start_secondary(void)
+{
+   unsigned int cpu;
+   pok_time_t deadline;
+
+   for(cpu = 1; cpu < POK_CONFIG_NB_CPUS; cpu++)
+   {
+      ja_smp_stacks[cpu] = pok_stack_alloc(SMP_STACK_SIZE);
+   }
+
+   memcpy((void*)SMP_TRAMPOLINE_ADDR, ja_smp_trampoline_start,
+      ja_smp_trampoline_end - ja_smp_trampoline_start);
+
+   ja_lapic_init(TRUE);
+   ja_lapic_timer_calibrate();
+
+   ja_lapic_send_init_all();
+   smp_delay(10000000);
+
+   ja_lapic_send_startup_all(SMP_TRAMPOLINE_ADDR >> 12);
+   smp_delay(200000);
+   /* Second STARTUP IPI is ignored by already started CPUs. */
+   ja_lapic_send_startup_all(SMP_TRAMPOLINE_ADDR >> 12);
+
+   deadline = ja_system_time() + SMP_START_TIMEOUT;
+
+   while(smp_cpus_online < POK_CONFIG_NB_CPUS)
+   {
+      if(ja_system_time() > deadline)
+      {
+         printf("Only %u of %u CPUs are started.\n",
+            (unsigned)smp_cpus_online, (unsigned)POK_CONFIG_NB_CPUS);
+         pok_fatal("Not enough CPUs (run qemu with '-smp' option?)");
+      }
+   }
+}
+
+#endif /* POK_NEEDS_SMP */
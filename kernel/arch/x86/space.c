@@ -23,32 +23,103 @@
 
 #include "interrupt.h"
 #include <asp/arch.h>
+#include <asp/cpu.h>
 #include <arch/deployment.h>
 
 #include "gdt.h"
 #include "tss.h"
 
 #include "space.h"
+#include "paging.h"
+#include "multiboot.h"
 #include <core/sched.h>
+#include <core/cache_color.h>
 
 #include <asp/alloc.h>
 
 #define KERNEL_STACK_SIZE 16384
 
+#if defined(POK_NEEDS_X86_PAGING) && POK_PARTITION_MEMORY_BASE != JA_X86_USER_WINDOW_BASE
+#error Partition memory should start at the user window
+#endif
+
 void ja_space_layout_get(jet_space_id space_id,
     struct jet_space_layout* space_layout)
 {
     assert(space_id != 0 && space_id <= ja_spaces_n);
 
+#ifdef POK_NEEDS_X86_PAGING
+    // Space is loaded when it is current, so the kernel uses its window.
+    space_layout->kernel_addr = (char*)POK_PARTITION_MEMORY_BASE;
+#else
     space_layout->kernel_addr = (char*)ja_spaces[space_id - 1].phys_base;
+#endif
     space_layout->user_addr = (char* __user)POK_PARTITION_MEMORY_BASE;
     space_layout->size = ja_spaces[space_id - 1].size_normal;
 }
 
+pok_bool_t ja_space_is_dirty(jet_space_id space_id,
+    const char __user* user_addr, size_t size)
+{
+#ifdef POK_NEEDS_X86_PAGING
+    return ja_paging_is_dirty(space_id, (uintptr_t)user_addr, size);
+#else
+    (void)space_id;
+    (void)user_addr;
+    (void)size;
+    return TRUE;
+#endif
+}
+
+void ja_space_dirty_clear(jet_space_id space_id)
+{
+#ifdef POK_NEEDS_X86_PAGING
+    ja_paging_dirty_clear(space_id);
+#else
+    (void)space_id;
+#endif
+}
+
+const void __user* ja_space_map_ro(jet_space_id space_id,
+    const void* addr, size_t size)
+{
+#ifdef POK_NEEDS_X86_PAGING
+    struct ja_x86_space* space = &ja_spaces[space_id - 1];
+    size_t size_shared = space->size_shared + size;
+
+    assert(((uintptr_t)addr & 0xfff) == 0 && (size & 0xfff) == 0);
+
+    if(space->size_total > JA_X86_USER_WINDOW_SIZE - size_shared)
+    {
+        printf("Space %d has no room for read-only mapping of 0x%lx bytes.\n",
+            (int)space_id, (unsigned long)size);
+        pok_fatal("Partition memory exceeds its window");
+    }
+
+    uintptr_t user_addr = JA_X86_USER_WINDOW_BASE + JA_X86_USER_WINDOW_SIZE - size_shared;
+
+    // Kernel memory is identity mapped.
+    ja_paging_map(space_id, user_addr, (uintptr_t)addr, size, 0);
+
+    space->size_shared = size_shared;
+
+    return (const void __user*)user_addr;
+#else
+    (void)space_id;
+    (void)addr;
+    (void)size;
+    return NULL;
+#endif
+}
+
 struct jet_kernel_shared_data* __kuser ja_space_shared_data(jet_space_id space_id)
 {
+#ifdef POK_NEEDS_X86_PAGING
+    return (struct jet_kernel_shared_data* __kuser)POK_PARTITION_MEMORY_BASE;
+#else
     struct ja_x86_space* space = &ja_spaces[space_id - 1];
     return (struct jet_kernel_shared_data* __kuser)space->phys_base;
+#endif
 }
 
 /* FIX: Alexy Torres, variable unused, fix: comment */
@@ -63,7 +134,8 @@ void __user* ja_space_get_heap(jet_space_id space_id)
 }
 
 
-jet_space_id current_space_id = 0;
+/* Space executed on every CPU. */
+static jet_space_id current_space_id[POK_CONFIG_NB_CPUS];
 
 void ja_user_space_jump(
     jet_stack_t stack_kernel,
@@ -115,6 +187,60 @@ void ja_user_space_jump(
        );
 }
 
+#ifdef POK_NEEDS_X86_PAGING
+static void ja_space_create (jet_space_id space_id,
+                            uintptr_t addr,
+                            size_t size)
+{
+   struct ja_x86_space* space = &ja_spaces[space_id - 1];
+   size_t size_exec = ALIGN_VAL(space->size_normal, 0x1000);
+
+   if(size > JA_X86_USER_WINDOW_SIZE)
+   {
+      printf("Space %d requires 0x%lx bytes, but window has only 0x%lx.\n",
+         (int)space_id, (unsigned long)size, (unsigned long)JA_X86_USER_WINDOW_SIZE);
+      pok_fatal("Partition memory exceeds its window");
+   }
+
+   /*
+    * Segments are flat, isolation is provided by paging. They are
+    * never disabled, so segment registers of the user are not reloaded
+    * on space switch.
+    */
+   gdt_set_segment (GDT_PARTITION_CODE_SEGMENT (space_id),
+         0, ~0UL, GDTE_CODE, 3);
+
+   gdt_set_segment (GDT_PARTITION_DATA_SEGMENT (space_id),
+         0, ~0UL, GDTE_DATA, 3);
+
+#ifdef POK_NEEDS_CACHE_COLORING
+   if(space->cache_colors != 0)
+   {
+      unsigned color_next = 0;
+
+      for(size_t offset = 0; offset < size; offset += JET_CACHE_COLOR_PAGE_SIZE)
+      {
+         uintptr_t page = jet_cache_color_page_alloc(space->cache_colors, &color_next);
+
+         if(offset == 0) space->phys_base = page;
+
+         ja_paging_map(space_id, POK_PARTITION_MEMORY_BASE + offset, page,
+               JET_CACHE_COLOR_PAGE_SIZE,
+               offset < size_exec ? JA_X86_PAGE_EXEC | JA_X86_PAGE_WRITE : JA_X86_PAGE_WRITE);
+      }
+
+      return;
+   }
+#endif /* POK_NEEDS_CACHE_COLORING */
+
+   // Code and data. Code isn't separated from data in the image.
+   ja_paging_map(space_id, POK_PARTITION_MEMORY_BASE, addr, size_exec,
+         JA_X86_PAGE_EXEC | JA_X86_PAGE_WRITE);
+   // Heap and stacks.
+   ja_paging_map(space_id, POK_PARTITION_MEMORY_BASE + size_exec, addr + size_exec,
+         size - size_exec, JA_X86_PAGE_WRITE);
+}
+#else
 static void ja_space_create (jet_space_id space_id,
                             uintptr_t addr,
                             size_t size)
@@ -125,10 +251,41 @@ static void ja_space_create (jet_space_id space_id,
    gdt_set_segment (GDT_PARTITION_DATA_SEGMENT (space_id),
          addr, size, GDTE_DATA, 3);
 }
+#endif /* POK_NEEDS_X86_PAGING */
+
+#ifdef POK_NEEDS_CACHE_COLORING
+/* Set in entry.S. */
+extern uint32_t pok_multiboot_info;
+
+/*
+ * Return end of the physical memory, as reported by the boot loader.
+ *
+ * Memory above the identity mapping of the kernel is never used.
+ */
+static uintptr_t space_phys_end(void)
+{
+    const pok_multiboot_info_t* info =
+        (const pok_multiboot_info_t*)(uintptr_t)pok_multiboot_info;
+    uint64_t end;
+
+    if(info == NULL || !(info->flags & MULTIBOOT_MEMORY))
+        return JA_X86_USER_WINDOW_BASE;
+
+    // 'mem_upper' is amount of memory above 1M, in kilobytes.
+    end = 0x100000ULL + (uint64_t)info->mem_upper * 1024;
+
+    return end < JA_X86_USER_WINDOW_BASE ? (uintptr_t)end : JA_X86_USER_WINDOW_BASE;
+}
+#endif /* POK_NEEDS_CACHE_COLORING */
 
 void ja_space_init(void)
 {
     uintptr_t phys_start = POK_PARTITION_MEMORY_PHYS_START;
+
+#ifdef POK_NEEDS_X86_PAGING
+    ja_paging_init();
+#endif
+
     for(int i = 0; i < ja_spaces_n; i++)
     {
         struct ja_x86_space* space = &ja_spaces[i];
@@ -153,8 +310,18 @@ void ja_space_init(void)
         /* Such a way, next space will have alignment suitable for code and data. */
         space->size_total = ALIGN_VAL(size_total, 0x1000);
 
+#ifdef POK_NEEDS_CACHE_COLORING
+        /* Colored spaces are built after all contiguous ones. */
+        if(space->cache_colors != 0) continue;
+#endif
+
         if(space->phys_base == 0)
         {
+#ifdef POK_NEEDS_X86_PAGING
+            /* Big spaces are aligned for being mapped with large pages. */
+            if(space->size_total >= 0x200000)
+                phys_start = ALIGN_VAL(phys_start, 0x200000);
+#endif
             space->phys_base = ALIGN_VAL(phys_start, 0x1000);
             phys_start = space->phys_base + space->size_total;
         }
@@ -168,6 +335,18 @@ void ja_space_init(void)
         }
         ja_space_create(i + 1, (uintptr_t)space->phys_base, space->size_total);
     }
+
+#ifdef POK_NEEDS_CACHE_COLORING
+    jet_cache_color_init(phys_start, space_phys_end());
+
+    for(int i = 0; i < ja_spaces_n; i++)
+    {
+        struct ja_x86_space* space = &ja_spaces[i];
+
+        if(space->cache_colors != 0)
+            ja_space_create(i + 1, 0, space->size_total);
+    }
+#endif
 }
 
 void ja_ustack_init (jet_space_id space_id)
@@ -198,59 +377,27 @@ jet_ustack_t ja_ustack_alloc (jet_space_id space_id, size_t stack_size)
 
 void ja_space_switch (jet_space_id space_id)
 {
-    if(current_space_id != 0) {
-        gdt_disable (GDT_PARTITION_CODE_SEGMENT(current_space_id));
-        gdt_disable (GDT_PARTITION_DATA_SEGMENT(current_space_id));
+    jet_space_id* current = &current_space_id[ja_cpu_id()];
+
+#ifdef POK_NEEDS_X86_PAGING
+    ja_paging_switch(space_id);
+#else
+    if(*current != 0) {
+        gdt_disable (GDT_PARTITION_CODE_SEGMENT(*current));
+        gdt_disable (GDT_PARTITION_DATA_SEGMENT(*current));
     }
     if(space_id != 0) {
         gdt_enable (GDT_PARTITION_CODE_SEGMENT(space_id));
         gdt_enable (GDT_PARTITION_DATA_SEGMENT(space_id));
     }
+#endif
 
-    current_space_id = space_id;
+    *current = space_id;
 }
 
 jet_space_id ja_space_get_current (void)
 {
-    return current_space_id;
-}
-
-// TODO: Storage for floating point registers and operations with them.
-struct jet_fp_store
-{
-  int todo;
-};
-
-/*
- * Allocate place for store floating point registers.
- *
- * May be called only during OS init.
- */
-struct jet_fp_store* ja_alloc_fp_store(void)
-{
-    struct jet_fp_store* res = ja_mem_alloc_aligned(sizeof(*res), 4);
-
-    return res;
-}
-
-/* Save floating point registers into given place. */
-void ja_fp_save(struct jet_fp_store* fp_store)
-{
-    // TODO
-    (void)fp_store;
-}
-
-/* Restore floating point registers into given place. */
-void ja_fp_restore(struct jet_fp_store* fp_store)
-{
-    // TODO
-    (void)fp_store;
-}
-
-/* Initialize floating point registers with zero. */
-void ja_fp_init(void)
-{
-    // TODO
+    return current_space_id[ja_cpu_id()];
 }
 
 
@@ -266,11 +413,27 @@ uintptr_t pok_virt_to_phys(uintptr_t virt)
         pok_fatal("wrong pointer in pok_virt_to_phys\n");
     }
 
+#ifdef POK_NEEDS_X86_PAGING
+    return ja_paging_virt_to_phys(ja_space_get_current(), virt);
+#else
     return virt - POK_PARTITION_MEMORY_BASE + space->phys_base;
+#endif
 }
 
 uintptr_t pok_phys_to_virt(uintptr_t phys)
 {
+#ifdef POK_NEEDS_X86_PAGING
+    uintptr_t virt = ja_paging_phys_to_virt(ja_space_get_current(), phys);
+
+    if(virt == 0)
+    {
+        // Fatal error despite it is called from user space!!
+        printf("pok_phys_to_virt: wrong physical address %p\n", (void*)phys);
+        pok_fatal("wrong pointer in pok_phys_to_virt\n");
+    }
+
+    return virt;
+#else
     struct ja_x86_space* space = &ja_spaces[ja_space_get_current() - 1];
 
     if((phys < space->phys_base)
@@ -282,4 +445,5 @@ uintptr_t pok_phys_to_virt(uintptr_t phys)
     }
 
     return phys - space->phys_base + POK_PARTITION_MEMORY_BASE;
+#endif
 }
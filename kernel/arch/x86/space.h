@@ -23,6 +23,7 @@
 #ifndef __POK_X86_SPACE_H__
 #define __POK_X86_SPACE_H__
 
+#include <config.h>
 #include <types.h>
 #include "thread.h"
 #include <arch/deployment.h>
@@ -31,8 +32,13 @@
  * Virtual address where partition's memory starts.
  * 
  * DEV: Segment addressing cannot affect virtual addresses: they always starts from 0.
+ * With paging partition's memory is mapped into the window (see paging.h).
  */
+#ifdef POK_NEEDS_X86_PAGING
+#define POK_PARTITION_MEMORY_BASE 0x80000000ULL
+#else
 #define POK_PARTITION_MEMORY_BASE 0x0ULL
+#endif
 /*
  * Beginning of the phys memory used for partitions.
  */
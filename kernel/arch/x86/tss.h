@@ -18,6 +18,7 @@
 #ifndef __POK_X86_TSS_H__
 #define __POK_X86_TSS_H__
 
+#include <config.h>
 #include <types.h>
 
 typedef struct
@@ -51,7 +52,8 @@ typedef struct
    uint16_t	io_bit_map_offset;
 } __attribute__((packed)) tss_t;
 
-extern tss_t pok_tss;
+/* TSS of every CPU. */
+extern tss_t pok_tss[POK_CONFIG_NB_CPUS];
 
 #endif /* !__POK_X86_TSS_H__ */
 
@@ -56,9 +56,14 @@ static pok_bool_t x86_check_access(const void* __user addr, size_t size,
 static uint32_t user_space_shift(jet_space_id space_id)
 {
     assert(space_id != 0);
+#ifdef POK_NEEDS_X86_PAGING
+    // The kernel accesses memory of the current space via its window.
+    return 0;
+#else
     struct ja_x86_space* space = &ja_spaces[space_id - 1];
 
     return POK_PARTITION_MEMORY_BASE - space->phys_base;
+#endif
 }
 
 void* __kuser ja_user_to_kernel_space(void* __user addr, size_t size,
@@ -31,10 +31,12 @@
 #include <core/partition.h>
 #include <core/partition_arinc.h>
 #include <core/channel.h>
+#include <core/port.h>
 #include <asp/entries.h>
+#include <asp/cpu.h>
 #include <libc.h>
 
-#include <core/instrumentation.h>
+#include <core/trace.h>
 
 #ifdef POK_NEEDS_GDB
 #include <gdb.h>
@@ -44,6 +46,8 @@ void jet_boot (void)
 {
    kernel_state = POK_SYSTEM_STATE_OS_MOD; // TODO: is this choice for state right?
 
+   jet_trace_init();
+
 #ifdef POK_NEEDS_NETWORKING
    pok_network_init();
 #endif
@@ -64,28 +68,22 @@ void jet_boot (void)
 #if defined (POK_NEEDS_PORTS_QUEUEING) || defined (POK_NEEDS_PORTS_SAMPLING)
    pok_channels_init_all ();
 #endif
+#ifdef POK_NEEDS_SAMPLING_SHARED
+   pok_port_sampling_share_all ();
+#endif
 
 #if defined (POK_NEEDS_DEBUG) || defined (POK_NEEDS_CONSOLE)
   pok_cons_write ("JET OS kernel initialized\n", 26);
 #endif
 
-#ifdef POK_NEEDS_INSTRUMENTATION
-  uint32_t tmp;
-   printf ("[INSTRUMENTATION][CHEDDAR] <event_table>\n");
-   printf ("[INSTRUMENTATION][CHEDDAR] <processor>\n");
-   printf ("[INSTRUMENTATION][CHEDDAR] <name>pok_kernel</name>\n");
-
-   for (tmp = 0 ; tmp < POK_CONFIG_NB_THREADS ; tmp++)
-   {
-      printf ("[INSTRUMENTATION][CHEDDAR] <task_activation>   0   task %lu</task_activation>\n", tmp);
-   }
-#endif
-
 #ifdef POK_NEEDS_PARTITIONS
 #if defined(POK_NEEDS_GDB) && defined(POK_NEEDS_WAIT_FOR_GDB)
   printf("Waiting for GDB connection ...\n");
   printf("\n");
   pok_trap();
+#endif
+#ifdef POK_NEEDS_SMP
+  ja_cpu_start_secondary();
 #endif
   pok_sched_start();
 #else
@@ -99,3 +97,10 @@ void jet_boot (void)
   main ();
 #endif
 }
+
+#ifdef POK_NEEDS_SMP
+void jet_boot_secondary(void)
+{
+   pok_sched_start();
+}
+#endif
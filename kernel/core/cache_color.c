@@ -0,0 +1,83 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_CACHE_COLORING
+
+#include <core/cache_color.h>
+#include <core/debug.h>
+#include <common.h>
+#include <assert.h>
+
+#if POK_CONFIG_CACHE_COLORS < 1 || POK_CONFIG_CACHE_COLORS > 32
+#error POK_CONFIG_CACHE_COLORS should be in range [1; 32]
+#endif
+
+/* Next free page of every color. */
+static uintptr_t color_next_page[POK_CONFIG_CACHE_COLORS];
+
+/* End of the pool. */
+static uintptr_t color_pool_end;
+
+void jet_cache_color_init(uintptr_t phys_start, uintptr_t phys_end)
+{
+    uintptr_t page = ALIGN_VAL(phys_start, JET_CACHE_COLOR_PAGE_SIZE);
+
+    color_pool_end = phys_end;
+
+    for(int i = 0; i < POK_CONFIG_CACHE_COLORS; i++)
+    {
+        unsigned color = (page / JET_CACHE_COLOR_PAGE_SIZE) % POK_CONFIG_CACHE_COLORS;
+
+        color_next_page[color] = page;
+        page += JET_CACHE_COLOR_PAGE_SIZE;
+    }
+}
+
+uintptr_t jet_cache_color_page_alloc(uint32_t colors, unsigned* color_next)
+{
+    unsigned color = *color_next;
+    uintptr_t page;
+
+    assert(colors != 0);
+
+    if((colors & JET_CACHE_COLORS_ALL) != colors)
+    {
+        printf("Cache colors 0x%lx are outside of POK_CONFIG_CACHE_COLORS=%d.\n",
+            (unsigned long)colors, POK_CONFIG_CACHE_COLORS);
+        pok_fatal("Wrong cache colors of the partition");
+    }
+
+    while(!(colors & (1UL << color)))
+        color = (color + 1) % POK_CONFIG_CACHE_COLORS;
+
+    page = color_next_page[color];
+
+    if(page >= color_pool_end || color_pool_end - page < JET_CACHE_COLOR_PAGE_SIZE)
+    {
+        printf("No free pages of cache color %u below 0x%lx.\n",
+            color, (unsigned long)color_pool_end);
+        pok_fatal("Memory for cache colors is exhausted");
+    }
+
+    color_next_page[color] += POK_CONFIG_CACHE_COLORS * JET_CACHE_COLOR_PAGE_SIZE;
+
+    *color_next = (color + 1) % POK_CONFIG_CACHE_COLORS;
+
+    return page;
+}
+
+#endif /* POK_NEEDS_CACHE_COLORING */
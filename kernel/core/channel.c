@@ -20,24 +20,68 @@
 
 #include <core/sched.h>
 #include <alloc.h>
+#include <libc.h>
+#include <compiler.h>
+
+/*
+ * Sides of the channel may be executed on different CPUs.
+ *
+ * Every access to the channel's state is protected by the channel's
+ * lock in addition to disabled preemption.
+ */
+#ifdef POK_NEEDS_SMP
+#define channel_lock(channel) SPIN_LOCK((channel)->lock)
+#define channel_unlock(channel) SPIN_UNLOCK((channel)->lock)
+#else
+#define channel_lock(channel) do {} while(0)
+#define channel_unlock(channel) do {} while(0)
+#endif
 
 /*********************** Queuing channel ******************************/
 
 void pok_channel_queuing_init(pok_channel_queuing_t* channel)
 {
+    pok_message_range_t max_nb_message_recv = 0;
+
+    assert(channel->nb_recvs > 0);
+
+    for(int i = 0; i < channel->nb_recvs; i++)
+    {
+        struct pok_channel_queuing_side* recv = &channel->recvs[i];
+
+        if(recv->max_nb_message > max_nb_message_recv)
+            max_nb_message_recv = recv->max_nb_message;
+
+        recv->next_message = 0;
+        recv->generation = 0;
+        recv->is_notify = FALSE;
+        recv->message_discarded = FALSE;
+        recv->nb_discarded = 0;
+    }
+
+    // Messages are stored once, so the largest receiver buffer is sufficient.
     channel->max_nb_message =
-        channel->recv.max_nb_message + channel->send.max_nb_message;
+        max_nb_message_recv + channel->send.max_nb_message;
 
-    channel->border = channel->recv.next_message = channel->send.next_message = 0;
+    channel->border = channel->send.next_message = 0;
 
     const unsigned int message_alignment = __alignof__(int);
 
     channel->message_stride = ALIGN_VAL(channel->max_message_size,
         message_alignment);
 
-    channel->messages = ja_mem_alloc_aligned(
-        channel->message_stride * channel->max_nb_message,
-        message_alignment);
+    if(channel->is_zero_copy)
+    {
+        // Memory block is checked by the configurator for fit messages.
+        assert(channel->messages);
+        assert(((unsigned long)channel->messages % message_alignment) == 0);
+    }
+    else
+    {
+        channel->messages = ja_mem_alloc_aligned(
+            channel->message_stride * channel->max_nb_message,
+            message_alignment);
+    }
 
     channel->message_sizes = ja_mem_alloc_aligned(
         sizeof(*channel->message_sizes) * channel->max_nb_message,
@@ -45,11 +89,12 @@ void pok_channel_queuing_init(pok_channel_queuing_t* channel)
 
     channel->send.generation = 0;
     channel->send.is_notify = FALSE;
+    channel->send.message_discarded = FALSE;
+    channel->send.nb_discarded = 0;
 
-    channel->recv.generation = 0;
-    channel->recv.is_notify = FALSE;
-
-    channel->message_discarded = FALSE;
+    // Discarded message may be held by zero-copy operation.
+    assert(!channel->is_zero_copy
+        || channel->overflow_strategy != JET_CHANNEL_QUEUING_RECEIVER_OVERWRITE);
 }
 
 /*
@@ -108,27 +153,118 @@ static inline void channel_queuing_side_notify(struct pok_channel_queuing_side*
     }
 }
 
+/* Helper: Whether side of the channel is initialized by its partition. */
+static inline pok_bool_t channel_queuing_side_is_ready(
+    struct pok_channel_queuing_side* side)
+{
+    return side->part->partition_generation == side->generation;
+}
+
+/*
+ * Helper: Compute number of messages which can be moved into receivers
+ * buffers. This is the free space in the buffer of the slowest ready
+ * receiver.
+ *
+ * Return FALSE if no receiver is ready.
+ */
+static pok_bool_t channel_queuing_recv_space(pok_channel_queuing_t* channel,
+    pok_message_range_t* space)
+{
+    pok_bool_t is_ready = FALSE;
+
+    for(int i = 0; i < channel->nb_recvs; i++)
+    {
+        struct pok_channel_queuing_side* recv = &channel->recvs[i];
+
+        if(!channel_queuing_side_is_ready(recv)) continue;
+
+        pok_message_range_t recv_space = recv->max_nb_message
+            - channel_queuing_cyclic_sub(channel, channel->border, recv->next_message);
+
+        if(!is_ready || recv_space < *space) *space = recv_space;
+
+        is_ready = TRUE;
+    }
+
+    return is_ready;
+}
+
+/*
+ * Helper: Move messages from the sender buffer to the receivers
+ * buffers, as many as possible.
+ *
+ * Should be executed with global preemption disabled.
+ */
+static void channel_queuing_transfer(pok_channel_queuing_t* channel)
+{
+    pok_message_range_t n_send, space;
+
+    if(!channel_queuing_side_is_ready(&channel->send)) return;
+
+    n_send = channel_queuing_cyclic_sub(channel,
+        channel->send.next_message, channel->border);
+
+    if(n_send == 0) return;
+
+    if(!channel_queuing_recv_space(channel, &space))
+    {
+        // Just drop the messages and all previous ones which have been received.
+        channel->border = channel->send.next_message;
+        return;
+    }
+
+    if(space == 0) return;
+
+    if(n_send > space) n_send = space;
+
+    channel->border = channel_queuing_cyclic_add(channel, channel->border, n_send);
+
+    // Notify receivers and sender, if requested.
+    for(int i = 0; i < channel->nb_recvs; i++)
+    {
+        struct pok_channel_queuing_side* recv = &channel->recvs[i];
+
+        if(channel_queuing_side_is_ready(recv))
+            channel_queuing_side_notify(recv,
+                JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE);
+    }
+
+    channel_queuing_side_notify(&channel->send,
+        JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE);
+}
+
 void pok_channel_queuing_side_init(pok_channel_queuing_t* channel,
     struct pok_channel_queuing_side* side,
     uint16_t handler_id)
 {
     pok_preemption_disable();
+    channel_lock(channel);
     side->next_message = channel->border;
     side->is_notify = FALSE;
+    side->message_discarded = FALSE;
+    side->nb_discarded = 0;
     side->generation = side->part->partition_generation;
     side->handler_id = handler_id;
 
+    // Space in the receiver buffer may unblock the sender.
+    channel_queuing_transfer(channel);
+
+    channel_unlock(channel);
     __pok_preemption_enable();
 }
 
-pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* channel)
+pok_message_range_t pok_channel_queuing_r_n_messages(
+    pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv)
 {
     pok_preemption_disable();
+    channel_lock(channel);
 
     size_t n_messages = channel_queuing_cyclic_sub(channel,
         channel->border,
-        channel->recv.next_message);
+        recv->next_message);
 
+    channel_unlock(channel);
     __pok_preemption_enable();
 
     return n_messages;
@@ -136,53 +272,103 @@ pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* chan
 
 const char* pok_channel_queuing_r_get_message(
     pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
     pok_message_size_t* size,
     pok_bool_t subscribe)
 {
     const char* message;
 
     pok_preemption_disable();
+    channel_lock(channel);
 
-    if(channel->recv.next_message != channel->border)
+    if(recv->next_message != channel->border)
     {
-        message = channel_queuing_message_at(channel, channel->recv.next_message);
-        *size = channel->message_sizes[channel->recv.next_message];
+        message = channel_queuing_message_at(channel, recv->next_message);
+        *size = channel->message_sizes[recv->next_message];
     }
     else
     {
         message = NULL;
-        if(subscribe) channel->recv.is_notify = TRUE;
+        if(subscribe) recv->is_notify = TRUE;
     }
 
+    channel_unlock(channel);
     __pok_preemption_enable();
 
     return message;
 }
 
 
+/*
+ * Helper: consume the first message at receiver side.
+ *
+ * Should be executed with global preemption disabled.
+ */
+static void channel_queuing_r_consume_message(pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv)
+{
+    recv->next_message = channel_queuing_cyclic_add(channel,
+        recv->next_message, 1);
+
+    channel_queuing_transfer(channel);
+}
+
 void pok_channel_queuing_r_consume_message(
     pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
     pok_bool_t* message_discarded)
 {
-    assert(channel->recv.next_message != channel->border);
+    assert(recv->next_message != channel->border);
 
     pok_preemption_disable();
+    channel_lock(channel);
 
-    channel->recv.next_message = channel_queuing_cyclic_add(channel,
-        channel->recv.next_message, 1);
+    channel_queuing_r_consume_message(channel, recv);
 
-    if(channel->send.part->partition_generation == channel->send.generation
-        && channel->border != channel->send.next_message)
+    *message_discarded = recv->message_discarded;
+    recv->message_discarded = FALSE;
+    channel_unlock(channel);
+    pok_preemption_enable();
+}
+
+pok_message_range_t pok_channel_queuing_r_receive_messages(
+    pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
+    char* buffer,
+    pok_message_size_t stride,
+    pok_port_size_t* sizes,
+    pok_message_range_t n,
+    pok_bool_t* message_discarded)
+{
+    pok_message_range_t i;
+
+    pok_preemption_disable();
+    channel_lock(channel);
+
+    for(i = 0; i < n && recv->next_message != channel->border; i++)
+    {
+        pok_message_size_t size = channel->message_sizes[recv->next_message];
+
+        memcpy(buffer + i * stride,
+            channel_queuing_message_at(channel, recv->next_message),
+            size);
+        sizes[i] = size;
+
+        channel_queuing_r_consume_message(channel, recv);
+    }
+
+    *message_discarded = FALSE;
+
+    if(i > 0)
     {
-        channel->border = channel_queuing_cyclic_add(channel,
-            channel->border, 1);
-        channel_queuing_side_notify(&channel->send,
-            JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE);
+        *message_discarded = recv->message_discarded;
+        recv->message_discarded = FALSE;
     }
 
-    *message_discarded = channel->message_discarded;
-    channel->message_discarded = FALSE;
+    channel_unlock(channel);
     pok_preemption_enable();
+
+    return i;
 }
 
 char* pok_channel_queuing_s_get_message(
@@ -193,6 +379,7 @@ char* pok_channel_queuing_s_get_message(
     char* message;
 
     pok_preemption_disable();
+    channel_lock(channel);
 
     n_used = channel_queuing_cyclic_sub(channel,
         channel->send.next_message, channel->border);
@@ -208,11 +395,80 @@ char* pok_channel_queuing_s_get_message(
             channel->send.is_notify = TRUE;
     }
 
+    channel_unlock(channel);
     __pok_preemption_enable();
 
     return message;
 }
 
+/*
+ * Helper: mark message at sender side as produced.
+ *
+ * Should be executed with global preemption disabled.
+ */
+static void channel_queuing_s_produce_message(
+    pok_channel_queuing_t* channel,
+    pok_message_size_t size)
+{
+    channel->message_sizes[channel->send.next_message] = size;
+    channel->send.next_message = channel_queuing_cyclic_add(channel,
+        channel->send.next_message, 1);
+
+    channel_queuing_transfer(channel);
+
+    if(channel->border == channel->send.next_message)
+        return; // Message has been sent.
+
+    // Some receiver is full.
+    switch(channel->overflow_strategy)
+    {
+    case JET_CHANNEL_QUEUING_SENDER_BLOCK:
+        break;
+    case JET_CHANNEL_QUEUING_RECEIVER_DISCARD:
+        /* 
+         * Discard message and store note about that for every
+         * receiver, as all of them miss the message.
+         */
+        channel->send.next_message = channel->border;
+        channel->send.nb_discarded++;
+
+        for(int i = 0; i < channel->nb_recvs; i++)
+        {
+            struct pok_channel_queuing_side* recv = &channel->recvs[i];
+
+            if(channel_queuing_side_is_ready(recv))
+            {
+                recv->message_discarded = TRUE;
+                recv->nb_discarded++;
+            }
+        }
+        break;
+    case JET_CHANNEL_QUEUING_RECEIVER_OVERWRITE:
+        /* 
+         * Discard the oldest message for every full receiver and store
+         * note about that. Then the message fits into all receivers.
+         */
+        for(int i = 0; i < channel->nb_recvs; i++)
+        {
+            struct pok_channel_queuing_side* recv = &channel->recvs[i];
+
+            if(!channel_queuing_side_is_ready(recv)) continue;
+
+            if(channel_queuing_cyclic_sub(channel, channel->border,
+                recv->next_message) < recv->max_nb_message) continue;
+
+            recv->next_message = channel_queuing_cyclic_add(channel,
+                recv->next_message, 1);
+            recv->message_discarded = TRUE;
+            recv->nb_discarded++;
+        }
+
+        channel_queuing_transfer(channel);
+        assert(channel->border == channel->send.next_message);
+        break;
+    }
+}
+
 void pok_channel_queuing_s_produce_message(
     pok_channel_queuing_t* channel,
     pok_message_size_t size)
@@ -224,48 +480,59 @@ void pok_channel_queuing_s_produce_message(
     assert(size <= channel->max_message_size);
 
     pok_preemption_disable();
+    channel_lock(channel);
 
-    channel->message_sizes[channel->send.next_message] = size;
-    channel->send.next_message = channel_queuing_cyclic_add(channel,
-        channel->send.next_message, 1);
+    channel_queuing_s_produce_message(channel, size);
 
-    if(channel->recv.part->partition_generation == channel->recv.generation)
-    {
-        // Receiver is ready.
-        pok_message_range_t nb_message_receive = channel_queuing_cyclic_sub(
-            channel, channel->border, channel->recv.next_message);
+    channel_unlock(channel);
+    pok_preemption_enable();
+}
 
-        if(nb_message_receive < channel->recv.max_nb_message)
-        {
-            // Move message to the receiver buffer
-            channel->border = channel->send.next_message;
-            // And notify receiver, if requested.
-            channel_queuing_side_notify(&channel->recv,
-                JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE);
-        }
-        else if(channel->overflow_strategy == JET_CHANNEL_QUEUING_RECEIVER_DISCARD)
-        {
-            /* Discard message and store note about that.*/
-            channel->send.next_message = channel->border;
-            channel->message_discarded = TRUE;
-        }
-    }
-    else
+pok_message_range_t pok_channel_queuing_s_send_messages(
+    pok_channel_queuing_t* channel,
+    const char* buffer,
+    pok_message_size_t stride,
+    const pok_port_size_t* sizes,
+    pok_message_range_t n)
+{
+    pok_message_range_t i;
+
+    pok_preemption_disable();
+    channel_lock(channel);
+
+    for(i = 0; i < n; i++)
     {
-        // Just drop the message and all previous ones which have been received.
-        channel->border = channel->send.next_message;
+        // Size may be modified concurrently by the user: read it once.
+        pok_port_size_t size = ACCESS_ONCE(sizes[i]);
+
+        if(size == 0 || size > channel->max_message_size)
+            break; // Incorrect size.
+
+        if(channel_queuing_cyclic_sub(channel, channel->send.next_message,
+            channel->border) >= channel->send.max_nb_message)
+            break; // Sender buffer is full.
+
+        memcpy(channel_queuing_message_at(channel, channel->send.next_message),
+            buffer + i * stride, size);
+
+        channel_queuing_s_produce_message(channel, (pok_message_size_t)size);
     }
 
+    channel_unlock(channel);
     pok_preemption_enable();
+
+    return i;
 }
 
 pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* channel)
 {
     pok_preemption_disable();
+    channel_lock(channel);
 
     pok_message_range_t n_messages = channel_queuing_cyclic_sub(channel,
         channel->send.next_message, channel->border);
 
+    channel_unlock(channel);
     __pok_preemption_enable();
 
     return n_messages;
@@ -273,28 +540,110 @@ pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* chan
 
 /*********************** Sampling channel *****************************/
 
+/* Helper: Return slot for the next message formed by the sender. */
+static uint8_t channel_sampling_find_free_slot(pok_channel_sampling_t* channel)
+{
+    /* Slots used by the receivers. There are at most nb_readers + 1 of them. */
+    uint32_t used = 0;
+
+    for(int i = 0; i < channel->nb_readers; i++)
+    {
+        struct pok_channel_sampling_reader* reader = &channel->readers[i];
+
+        if(reader->read_pos != POK_CHANNEL_SAMPLING_POS_EMPTY)
+            used |= 1UL << reader->read_pos;
+        if(reader->read_pos_next != POK_CHANNEL_SAMPLING_POS_EMPTY)
+            used |= 1UL << reader->read_pos_next;
+    }
+
+    uint8_t pos;
+    for(pos = 0; used & (1UL << pos); pos++);
+
+    assert(pos < channel->nb_slots);
+
+    return pos;
+}
+
+#ifdef POK_NEEDS_SAMPLING_SHARED
+/* Mappings into user space are made with 4K pages on all arches. */
+#define SAMPLING_SHARED_ALIGNMENT 0x1000
+
+/*
+ * Publish message at 'pos' as the latest one for readers in user space.
+ *
+ * Should be called with channel locked. Sides of the channel on other
+ * CPUs are ordered by x86 itself (SMP is supported only there),
+ * so compiler barriers are sufficient.
+ */
+static void channel_sampling_publish(pok_channel_sampling_t* channel,
+    uint8_t pos)
+{
+    struct jet_sampling_shared* shared = channel->shared;
+
+    assert(pos != POK_CHANNEL_SAMPLING_POS_EMPTY);
+
+    shared->seq++;
+    barrier();
+
+    shared->pos = pos;
+    shared->size = channel->message_sizes[pos];
+    shared->timestamp = channel->timestamps[pos];
+
+    barrier();
+    shared->seq++;
+}
+#else
+#define channel_sampling_publish(channel, pos) do {} while(0)
+#endif /* POK_NEEDS_SAMPLING_SHARED */
+
 void pok_channel_sampling_init(pok_channel_sampling_t* channel)
 {
     const unsigned int message_alignment = __alignof__(int);
 
+    /* Every reader holds at most one slot, plus the newest message and the sender. */
+    channel->nb_slots = channel->nb_readers + 2;
+    assert(channel->nb_slots <= 32);
+
     channel->message_stride = ALIGN_VAL(channel->max_message_size,
         message_alignment);
-    channel->messages = ja_mem_alloc_aligned(3 * channel->message_stride,
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    channel->shared_size = ALIGN_VAL(sizeof(*channel->shared)
+        + channel->nb_slots * channel->message_stride,
+        SAMPLING_SHARED_ALIGNMENT);
+    channel->shared = ja_mem_alloc_aligned(channel->shared_size, SAMPLING_SHARED_ALIGNMENT);
+    // Nothing else from the kernel should be visible in the mapped pages.
+    memset(channel->shared, 0, channel->shared_size);
+
+    channel->shared->max_message_size = channel->max_message_size;
+    channel->shared->message_stride = channel->message_stride;
+    channel->shared->nb_slots = channel->nb_slots;
+    channel->messages = channel->shared->messages;
+#else
+    channel->messages = ja_mem_alloc_aligned(
+        channel->nb_slots * channel->message_stride,
         message_alignment);
+#endif
 
-    channel->read_pos_next = 0;
-    channel->read_pos = 0;
+    channel->message_sizes = ja_mem_alloc_aligned(
+        sizeof(*channel->message_sizes) * channel->nb_slots,
+        __alignof__(*channel->message_sizes));
+    channel->timestamps = ja_mem_alloc_aligned(
+        sizeof(*channel->timestamps) * channel->nb_slots,
+        __alignof__(*channel->timestamps));
 
-    // Mark the first message as empty.
-    channel->message_sizes[0] = 0;
+    for(int i = 0; i < channel->nb_readers; i++)
+    {
+        channel->readers[i].read_pos = POK_CHANNEL_SAMPLING_POS_EMPTY;
+        channel->readers[i].read_pos_next = POK_CHANNEL_SAMPLING_POS_EMPTY;
+    }
 
-    channel->write_pos = 1;
+    channel->write_pos = 0;
 }
 
 char* channel_sampling_message_at(
     pok_channel_sampling_t* channel, int pos)
 {
-    assert(pos <= 2);
+    assert(pos < channel->nb_slots);
 
     return &channel->messages[pos * channel->message_stride];
 }
@@ -312,42 +661,57 @@ char* channel_sampling_message_at(
  */
 const char* pok_channel_sampling_r_get_message(
     pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader,
     pok_message_size_t* size,
     pok_time_t* timestamp)
 {
     uint8_t read_pos;
 
     pok_preemption_disable();
-    read_pos = channel->read_pos = channel->read_pos_next;
+    channel_lock(channel);
+    read_pos = reader->read_pos = reader->read_pos_next;
+    channel_unlock(channel);
     __pok_preemption_enable();
 
-    pok_message_size_t message_size = channel->message_sizes[read_pos];
-    if(!message_size) return NULL;
+    if(read_pos == POK_CHANNEL_SAMPLING_POS_EMPTY) return NULL;
 
-    *size = message_size;
+    *size = channel->message_sizes[read_pos];
     *timestamp = channel->timestamps[read_pos];
 
-    return channel_sampling_message_at(channel, read_pos);;
+    return channel_sampling_message_at(channel, read_pos);
 }
 
-void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel)
+void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader)
 {
     pok_preemption_disable();
-    channel->message_sizes[channel->read_pos] = 0;
+    channel_lock(channel);
+    /* 
+     * Slot may be used by other readers, so only forget it.
+     * 
+     * Newest message, if it is the same, is cleared too.
+     */
+    if(reader->read_pos_next == reader->read_pos)
+        reader->read_pos_next = POK_CHANNEL_SAMPLING_POS_EMPTY;
+    reader->read_pos = POK_CHANNEL_SAMPLING_POS_EMPTY;
+    channel_unlock(channel);
     __pok_preemption_enable();
 }
 
-pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel)
+pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader)
 {
     pok_bool_t ret = FALSE;
 
     pok_preemption_disable();
-    if(channel->read_pos != channel->read_pos_next)
+    channel_lock(channel);
+    if(reader->read_pos != reader->read_pos_next)
     {
         ret = TRUE;
         // TODO: This mark message as consumed. Do we need that?
-        channel->read_pos = channel->read_pos_next;
+        reader->read_pos = reader->read_pos_next;
     }
+    channel_unlock(channel);
     __pok_preemption_enable();
 
     return ret;
@@ -368,25 +732,38 @@ void pok_channel_sampling_send_message(
     assert(size);
 
     pok_preemption_disable();
-    channel->read_pos_next = read_pos_next = channel->write_pos;
+    channel_lock(channel);
+    read_pos_next = channel->write_pos;
     channel->timestamps[read_pos_next] = jet_system_time();
     channel->message_sizes[read_pos_next] = size;
 
-    /*
-     * The only choice for `write_pos`, which can differ from both
-     * `read_pos` and `read_pos_next`.
-     * 
-     * (read_pos + read_pos_next + write_pos = 0 + 1 + 2 = 3).
-     */
-    channel->write_pos = 3 - channel->read_pos - read_pos_next;
+    for(int i = 0; i < channel->nb_readers; i++)
+        channel->readers[i].read_pos_next = read_pos_next;
+
+    /* Slot, which differs from ones used by all readers. */
+    channel->write_pos = channel_sampling_find_free_slot(channel);
+    channel_sampling_publish(channel, read_pos_next);
+    channel_unlock(channel);
     __pok_preemption_enable();
 }
 
 void pok_channel_sampling_s_clear_message(pok_channel_sampling_t* channel)
 {
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    /*
+     * Readers in user space see only the newest message, there is no
+     * previous one to revert to. So the newest message is kept for all
+     * readers.
+     */
+    (void)channel;
+#else
     pok_preemption_disable();
-    channel->read_pos_next = channel->read_pos;
+    channel_lock(channel);
+    for(int i = 0; i < channel->nb_readers; i++)
+        channel->readers[i].read_pos_next = channel->readers[i].read_pos;
+    channel_unlock(channel);
     __pok_preemption_enable();
+#endif
 }
 
 /**********************************************************************/
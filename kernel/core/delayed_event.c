@@ -16,6 +16,174 @@
 #include <core/delayed_event.h>
 #include <libc.h>
 
+#ifdef POK_NEEDS_DELAYED_EVENT_HEAP
+
+#include <asp/alloc.h>
+#include <assert.h>
+
+/*
+ * Binary min-heap of events.
+ *
+ * Event with index 'i' (0-based) in q->heap has 'heap_index' field
+ * equal to 'i + 1'.
+ */
+
+/* Whether event 'a' should be fired before event 'b'. */
+static inline pok_bool_t event_before(const struct delayed_event* a,
+    const struct delayed_event* b)
+{
+    if(a->timepoint != b->timepoint) return a->timepoint < b->timepoint;
+    /* Compare sequence numbers with wraparound. */
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+static inline void heap_set(struct delayed_event_queue* q,
+    uint16_t index, struct delayed_event* event)
+{
+    q->heap[index] = event;
+    event->heap_index = index + 1;
+}
+
+/* Move event at given index towards the root while it is needed. */
+static void heap_sift_up(struct delayed_event_queue* q, uint16_t index)
+{
+    struct delayed_event* event = q->heap[index];
+
+    while(index > 0)
+    {
+        uint16_t parent = (index - 1) / 2;
+        if(!event_before(event, q->heap[parent])) break;
+
+        heap_set(q, index, q->heap[parent]);
+        index = parent;
+    }
+
+    heap_set(q, index, event);
+}
+
+/* Move event at given index towards the leaves while it is needed. */
+static void heap_sift_down(struct delayed_event_queue* q, uint16_t index)
+{
+    struct delayed_event* event = q->heap[index];
+
+    while(1)
+    {
+        uint16_t child = index * 2 + 1;
+        if(child >= q->n_events) break;
+
+        if(child + 1 < q->n_events
+            && event_before(q->heap[child + 1], q->heap[child]))
+            child++;
+
+        if(!event_before(q->heap[child], event)) break;
+
+        heap_set(q, index, q->heap[child]);
+        index = child;
+    }
+
+    heap_set(q, index, event);
+}
+
+/* Remove event from the heap. Event should be in the heap. */
+static void heap_remove(struct delayed_event_queue* q,
+    struct delayed_event* event)
+{
+    uint16_t index = event->heap_index - 1;
+    struct delayed_event* last;
+
+    assert(index < q->n_events && q->heap[index] == event);
+
+    event->heap_index = 0;
+
+    last = q->heap[--q->n_events];
+    if(last == event) return; // Event was the last one.
+
+    q->heap[index] = last;
+    if(index > 0 && event_before(last, q->heap[(index - 1) / 2]))
+        heap_sift_up(q, index);
+    else
+        heap_sift_down(q, index);
+}
+
+void delayed_event_queue_alloc(struct delayed_event_queue* q,
+    uint16_t max_events)
+{
+    q->heap = ja_mem_alloc_aligned(max_events * sizeof(*q->heap),
+        __alignof__(*q->heap));
+    q->max_events = max_events;
+    q->n_events = 0;
+}
+
+void delayed_event_queue_init(struct delayed_event_queue* q)
+{
+    q->n_events = 0;
+    q->next_seq = 0;
+}
+
+void delayed_event_queue_check(struct delayed_event_queue* q,
+    pok_time_t time)
+{
+    while(q->n_events > 0)
+    {
+        struct delayed_event* event = q->heap[0];
+        if(event->timepoint > time) break;
+
+        heap_remove(q, event);
+
+        event->process_event(event->handler_id);
+    }
+}
+
+void delayed_event_init(struct delayed_event* event)
+{
+    event->heap_index = 0;
+}
+
+void delayed_event_add(struct delayed_event_queue* q,
+    struct delayed_event* event, pok_time_t timepoint,
+    uint16_t handler_id, process_event_t process_event)
+{
+    if(event->heap_index)
+        heap_remove(q, event);
+
+    event->timepoint = timepoint;
+    event->handler_id = handler_id;
+    event->process_event = process_event;
+    event->seq = q->next_seq++;
+
+    assert(q->n_events < q->max_events);
+
+    q->heap[q->n_events] = event;
+    heap_sift_up(q, q->n_events++);
+}
+
+void delayed_event_remove(struct delayed_event_queue* q,
+    struct delayed_event* event)
+{
+    if(event->heap_index == 0) return; // Event is not in the queue.
+
+    heap_remove(q, event);
+}
+
+pok_time_t delayed_event_queue_get_check_time(struct delayed_event_queue* q)
+{
+    if(q->n_events > 0) {
+        return q->heap[0]->timepoint;
+    }
+    else {
+        return 0;
+    }
+}
+
+#else /* POK_NEEDS_DELAYED_EVENT_HEAP */
+
+void delayed_event_queue_alloc(struct delayed_event_queue* q,
+    uint16_t max_events)
+{
+    (void)q;
+    (void)max_events;
+}
+
 void delayed_event_queue_init(struct delayed_event_queue* q)
 {
     q->first_event = NULL;
@@ -111,3 +279,5 @@ pok_time_t delayed_event_queue_get_check_time(struct delayed_event_queue* q)
         return 0;
     }
 }
+
+#endif /* POK_NEEDS_DELAYED_EVENT_HEAP */
@@ -17,6 +17,7 @@
 #include <core/error.h>
 #include <core/sched.h>
 #include <asp/arch.h>
+#include <core/trace.h>
 
 // TODO: this should be modified somewhere
 pok_system_state_t kernel_state = POK_SYSTEM_STATE_INIT_PARTOS;
@@ -121,6 +122,9 @@ void pok_raise_error(pok_error_id_t error_id, pok_bool_t user_space, void* faile
     pok_bool_t need_call_process_partition_error = FALSE;
     pok_bool_t preempt_local_disabled_old = !ja_preempt_enabled();
 
+    jet_trace(JET_TRACE_CLASS_ERROR, JET_TRACE_EVENT_ERROR,
+        JET_TRACE_THREAD_NONE, error_id);
+
     if(!preempt_local_disabled_old)
         pok_preemption_disable();
 
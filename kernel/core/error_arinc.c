@@ -29,6 +29,7 @@
 #include <assert.h>
 #include <libc.h>
 #include <core/uaccess.h>
+#include <core/trace.h>
 #include "thread_internal.h"
 #include <cons.h>
 
@@ -258,6 +259,9 @@ static void thread_clear_error_bit(pok_thread_t* thread,
 static void thread_emit_sync_error(pok_thread_t* thread,
     pok_error_id_t error_id, void* __user failed_addr)
 {
+    jet_trace(JET_TRACE_CLASS_ERROR, JET_TRACE_EVENT_ERROR,
+        JET_TRACE_THREAD(thread), error_id);
+
     current_partition_arinc->sync_error = error_id;
     current_partition_arinc->sync_error_failed_addr = failed_addr;
 
@@ -295,6 +299,9 @@ void pok_partition_arinc_process_error(
 
 void pok_thread_emit_deadline_missed(pok_thread_t* thread)
 {
+    jet_trace(JET_TRACE_CLASS_ERROR, JET_TRACE_EVENT_ERROR,
+        JET_TRACE_THREAD(thread), POK_ERROR_ID_DEADLINE_MISSED);
+
     if(process_error_partition(POK_SYSTEM_STATE_USER,
         POK_ERROR_ID_DEADLINE_MISSED)) return;
 
@@ -307,6 +314,9 @@ void pok_thread_emit_deadline_missed(pok_thread_t* thread)
 
 void pok_thread_emit_deadline_oor(pok_thread_t* thread)
 {
+    jet_trace(JET_TRACE_CLASS_ERROR, JET_TRACE_EVENT_ERROR,
+        JET_TRACE_THREAD(thread), POK_ERROR_ID_ILLEGAL_REQUEST);
+
     thread_set_unrecoverable(thread);
 
     if(process_error_partition(POK_SYSTEM_STATE_USER,
@@ -39,20 +39,133 @@
 #include <elf.h>
 
 #include <core/space.h>
+#include <common.h>
+#include <assert.h>
 
 #include <core/loader.h>
+#include <core/lz4.h>
 
 extern size_t pok_elf_sizes[];
 extern char __archive2_begin;
 
+#ifdef POK_NEEDS_LZ4_IMAGES
+/*
+ * Compressed image of the partition, produced from its elf at build
+ * time (see misc/lz4_image.py). Content of every segment is single
+ * LZ4 block, which is decompressed directly into the space.
+ */
+#define LZ4_IMAGE_MAGIC 0x4a4c5a34
+
+struct lz4_image_header
+{
+    uint32_t magic;
+    uint32_t entry;
+    uint32_t nsegments;
+};
+
+struct lz4_image_segment
+{
+    uint32_t vaddr;
+    uint32_t filesz;
+    uint32_t memsz;
+    /* Offset of the compressed content from the image start. */
+    uint32_t offset;
+    uint32_t csize;
+};
+
+static pok_bool_t loader_segment_decompress(const struct jet_loader_segment* segment)
+{
+    if(!jet_lz4_decompress((const uint8_t*)segment->src, segment->csize,
+        (uint8_t*)segment->kernel_dest, segment->filesz))
+        return FALSE;
+
+    memset(segment->kernel_dest + segment->filesz, 0, segment->memsz - segment->filesz);
+
+    return TRUE;
+}
+
+/*
+ * Load compressed image into the space.
+ *
+ * Return FALSE if the image is incorrect (error is raised).
+ */
+static pok_bool_t loader_lz4_load(const char* image_start, size_t image_size,
+    const struct jet_space_layout* space_layout,
+    struct jet_loader_image* image)
+{
+    const struct lz4_image_header* header = (const struct lz4_image_header*)image_start;
+    const struct lz4_image_segment* segments = (const struct lz4_image_segment*)(header + 1);
+
+    if (image_size < sizeof(*header)
+        || header->magic != LZ4_IMAGE_MAGIC
+        || header->nsegments > JET_LOADER_SEGMENTS_MAX
+        || image_size < sizeof(*header) + header->nsegments * sizeof(*segments))
+    {
+        printf("Partition's image has incorrect format.\n");
+        pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+        return FALSE;
+    }
+
+    image->entry = (void (*)(void))(uintptr_t)header->entry;
+
+    for (uint32_t i = 0; i < header->nsegments; i++)
+    {
+        const struct lz4_image_segment* s = &segments[i];
+        char* user_dest = (char*)(uintptr_t)s->vaddr;
+
+        if (s->filesz > s->memsz
+            || user_dest < space_layout->user_addr
+            || s->memsz > space_layout->size
+            || (size_t)(user_dest - space_layout->user_addr) > space_layout->size - s->memsz)
+        {
+            printf("Partition's image maps segment %p of size 0x%zx outside of the space %p of size 0x%zx.\n",
+                user_dest, (size_t)s->memsz, space_layout->user_addr, space_layout->size);
+            printf("HINT: Probably, you need to configure more space for the partition.\n");
+            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+            return FALSE;
+        }
+
+        if (s->offset > image_size || s->csize > image_size - s->offset)
+        {
+            printf("Partition's image has segment beyond its end.\n");
+            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+            return FALSE;
+        }
+
+        struct jet_loader_segment* segment = &image->segments[i];
+
+        *segment = (struct jet_loader_segment) {
+            .kernel_dest = space_layout->kernel_addr + (user_dest - space_layout->user_addr),
+            .user_dest = user_dest,
+            .src = image_start + s->offset,
+            .filesz = s->filesz,
+            .memsz = s->memsz,
+            .csize = s->csize
+        };
+
+        if (!loader_segment_decompress(segment))
+        {
+            printf("Partition's image has corrupted segment %u.\n", (unsigned)i);
+            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+            return FALSE;
+        }
+
+        image->nsegments++;
+    }
+
+    return TRUE;
+}
+#endif /* POK_NEEDS_LZ4_IMAGES */
+
 /**
  * Load an ELF file.
  *
- *  @param file
+ * With POK_NEEDS_LZ4_IMAGES the archive contains compressed images
+ * instead of ELF files.
  */
 void jet_loader_elf_load   (uint8_t elf_id,
                                  jet_space_id space_id,
-                                 void (** entry)(void))
+                                 struct jet_loader_image* image)
 {
     size_t elf_offset, elf_size;
 
@@ -66,15 +179,30 @@ void jet_loader_elf_load   (uint8_t elf_id,
 
     elf_size = pok_elf_sizes[elf_id];
 
+    /*
+     * Image is marked as restorable only after it has been loaded
+     * without errors. Otherwise every restart loads it again, so
+     * the errors are raised again.
+     */
+    pok_bool_t restorable = TRUE;
+
+    image->restorable = FALSE;
+    image->nsegments = 0;
+
     if (elf_size > space_layout.size)
     {
          printf("Attempt to load elf %u of size %zx into space of size %zx.\n",
             elf_id, elf_size, space_layout.size);
          pok_raise_error(POK_ERROR_ID_CONFIG_ERROR, FALSE, NULL);
+         restorable = FALSE;
     }
 
     const char* elf_start = &__archive2_begin + elf_offset;
 
+#ifdef POK_NEEDS_LZ4_IMAGES
+    if(!loader_lz4_load(elf_start, elf_size, &space_layout, image))
+        restorable = FALSE;
+#else
     Elf32_Ehdr*  elf_header;
     Elf32_Phdr*  elf_phdr;
 
@@ -87,9 +215,10 @@ void jet_loader_elf_load   (uint8_t elf_id,
     {
         printf("Partition's ELF has incorrect format");
         pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+        restorable = FALSE;
     }
 
-    *entry = (void (*)(void)) elf_header->e_entry;
+    image->entry = (void (*)(void)) elf_header->e_entry;
 
     elf_phdr = (Elf32_Phdr*)(elf_start + elf_header->e_phoff);
 
@@ -107,6 +236,7 @@ void jet_loader_elf_load   (uint8_t elf_id,
            printf("Partition's ELF has section with 'filesz=%zd' which is more than 'memsz=%zd'.\n",
                filesz, memsz);
            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+           restorable = FALSE;
         }
 
 
@@ -115,6 +245,7 @@ void jet_loader_elf_load   (uint8_t elf_id,
            printf("Partition's ELF maps to virtual address %p, but space starts with %p.\n",
                user_dest, space_layout.user_addr);
            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+           restorable = FALSE;
         }
 
           // Where given section ends(in user space).
@@ -131,6 +262,7 @@ void jet_loader_elf_load   (uint8_t elf_id,
          elf_end_user, elf_end_user - space_layout.user_addr, space_layout.size);
        printf("HINT: Probably, you need to configure more space for the partition.\n");
        pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+       restorable = FALSE;
     }
 
     for (int i = 0; i < elf_header->e_phnum; ++i)
@@ -147,7 +279,80 @@ void jet_loader_elf_load   (uint8_t elf_id,
 
         memcpy (kernel_dest, elf_phdr[i].p_offset + elf_start, filesz);
         memset (kernel_dest + filesz, 0, memsz - filesz);
+
+        if(memsz == 0) continue;
+
+        if(image->nsegments == JET_LOADER_SEGMENTS_MAX)
+        {
+            // Partition still works, but every restart reloads the elf.
+            restorable = FALSE;
+            continue;
+        }
+
+        // Archive is never modified, so it holds pristine copy of the segment.
+        image->segments[image->nsegments++] = (struct jet_loader_segment) {
+            .kernel_dest = kernel_dest,
+            .user_dest = user_dest,
+            .src = elf_phdr[i].p_offset + elf_start,
+            .filesz = filesz,
+            .memsz = memsz
+        };
+   }
+#endif /* POK_NEEDS_LZ4_IMAGES */
+
+   if(restorable)
+   {
+       image->restorable = TRUE;
+       ja_space_dirty_clear(space_id);
    }
 }
 
+/* Granularity of checks for modified memory when restore the image. */
+#define RESTORE_CHUNK_SIZE 0x1000
+
+void jet_loader_elf_restore(jet_space_id space_id,
+                                 const struct jet_loader_image* image)
+{
+    assert(image->restorable);
+
+    for (int i = 0; i < image->nsegments; i++)
+    {
+        const struct jet_loader_segment* segment = &image->segments[i];
+
+#ifdef POK_NEEDS_LZ4_IMAGES
+        // Compressed block may be decompressed only as a whole.
+        if(ja_space_is_dirty(space_id, segment->user_dest, segment->memsz)
+            && !loader_segment_decompress(segment))
+            pok_fatal("Partition's image is corrupted");
+#else
+        size_t offset = 0;
+
+        while(offset < segment->memsz)
+        {
+            // Chunks are aligned in user space, as pages are.
+            size_t next = ALIGN_VAL((unsigned long)(segment->user_dest + offset + 1),
+                RESTORE_CHUNK_SIZE) - (unsigned long)segment->user_dest;
+
+            if(next > segment->memsz) next = segment->memsz;
+
+            if(ja_space_is_dirty(space_id, segment->user_dest + offset, next - offset))
+            {
+                size_t copy_end = next < segment->filesz ? next : segment->filesz;
+
+                if(offset < copy_end)
+                    memcpy(segment->kernel_dest + offset, segment->src + offset, copy_end - offset);
+                else
+                    copy_end = offset;
+
+                memset(segment->kernel_dest + copy_end, 0, next - copy_end);
+            }
+
+            offset = next;
+        }
+#endif /* POK_NEEDS_LZ4_IMAGES */
+    }
+
+    ja_space_dirty_clear(space_id);
+}
+
 #endif /* POK_NEEDS_PARTITIONS */
@@ -0,0 +1,98 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_LZ4_IMAGES
+
+#include <core/lz4.h>
+#include <libc.h>
+
+#define LZ4_MIN_MATCH 4
+
+/*
+ * Read extension of the length (bytes up to the first one which isn't 255).
+ *
+ * Returns FALSE if the block ends before the extension.
+ */
+static pok_bool_t lz4_read_length(const uint8_t** ip, const uint8_t* iend,
+    size_t* length)
+{
+    uint8_t b;
+
+    do {
+        if(*ip == iend) return FALSE;
+        b = *(*ip)++;
+        *length += b;
+    } while(b == 255);
+
+    return TRUE;
+}
+
+pok_bool_t jet_lz4_decompress(const uint8_t* src, size_t src_size,
+    uint8_t* dst, size_t dst_size)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dst_size;
+
+    while(ip < iend)
+    {
+        unsigned token = *ip++;
+        size_t length = token >> 4;
+
+        if(length == 15 && !lz4_read_length(&ip, iend, &length)) return FALSE;
+
+        if(length > (size_t)(iend - ip) || length > (size_t)(oend - op)) return FALSE;
+
+        memcpy(op, ip, length);
+        op += length;
+        ip += length;
+
+        // Last sequence contains only literals.
+        if(ip == iend) break;
+
+        if(iend - ip < 2) return FALSE;
+
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        if(offset == 0 || offset > (size_t)(op - dst)) return FALSE;
+
+        length = token & 15;
+        if(length == 15 && !lz4_read_length(&ip, iend, &length)) return FALSE;
+        length += LZ4_MIN_MATCH;
+
+        if(length > (size_t)(oend - op)) return FALSE;
+
+        const uint8_t* match = op - offset;
+
+        if(offset >= length)
+        {
+            memcpy(op, match, length);
+            op += length;
+        }
+        else
+        {
+            // Overlapped match repeats last 'offset' bytes.
+            while(length--) *op++ = *match++;
+        }
+    }
+
+    return op == oend;
+}
+
+#endif /* POK_NEEDS_LZ4_IMAGES */
@@ -0,0 +1,151 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_MEMGUARD
+
+#include <core/memguard.h>
+#include <core/partition.h>
+#include <core/sched.h>
+#include <core/time.h>
+#include <core/debug.h>
+#include <asp/memguard.h>
+#include <asp/entries.h>
+#include <asp/cpu.h>
+#include <assert.h>
+
+/* Regulation state of one CPU. */
+struct memguard_cpu
+{
+    /* Whether counter is supported. Otherwise budgets are ignored. */
+    pok_bool_t enabled;
+    /* Whether counter is started for the current partition. */
+    pok_bool_t running;
+};
+
+static struct memguard_cpu memguard_cpus[POK_CONFIG_NB_CPUS];
+
+static inline struct memguard_cpu* memguard_cpu(void)
+{
+    return &memguard_cpus[ja_cpu_id()];
+}
+
+void jet_memguard_init(void)
+{
+    struct memguard_cpu* cpu = memguard_cpu();
+
+    cpu->enabled = ja_memguard_init();
+    cpu->running = FALSE;
+
+    if(!cpu->enabled)
+        printf("WARNING: No memory access counter on CPU %d, memory bandwidth isn't regulated.\n",
+            (int)ja_cpu_id());
+}
+
+/* Start new period if the current one has ended. */
+static void memguard_refresh(struct jet_memguard* mg, pok_time_t now)
+{
+    if(now < mg->period_end) return;
+
+    assert(mg->period > 0);
+
+    if(mg->period_end == 0)
+        mg->period_end = now + mg->period;
+    else
+        mg->period_end += ((now - mg->period_end) / mg->period + 1) * mg->period;
+
+    mg->remaining = mg->budget;
+    mg->throttled = FALSE;
+}
+
+/* Stop the counter (if it runs) and account accesses made. */
+static void memguard_pause(pok_partition_t* part)
+{
+    struct memguard_cpu* cpu = memguard_cpu();
+    struct jet_memguard* mg;
+    uint32_t used;
+
+    if(!cpu->running) return;
+
+    used = ja_memguard_stop();
+    cpu->running = FALSE;
+
+    mg = &part->memguard;
+
+    if(used < mg->remaining)
+    {
+        mg->remaining -= used;
+    }
+    else
+    {
+        mg->remaining = 0;
+        mg->throttled = TRUE;
+        mg->n_throttles++;
+    }
+}
+
+/* Start counter for the partition, if it is regulated and not throttled. */
+static void memguard_resume(pok_partition_t* part, pok_time_t now)
+{
+    struct memguard_cpu* cpu = memguard_cpu();
+    struct jet_memguard* mg = &part->memguard;
+
+    if(!cpu->enabled || mg->budget == 0) return;
+
+    memguard_refresh(mg, now);
+
+    if(mg->throttled) return;
+
+    assert(mg->remaining > 0);
+
+    ja_memguard_start(mg->remaining);
+    cpu->running = TRUE;
+}
+
+void jet_memguard_switch(pok_partition_t* old, pok_partition_t* new,
+    pok_time_t now)
+{
+    if(old != NULL) memguard_pause(old);
+
+    memguard_resume(new, now);
+}
+
+void jet_memguard_update(pok_partition_t* part, pok_time_t now)
+{
+    struct jet_memguard* mg = &part->memguard;
+
+    if(mg->budget == 0 || now < mg->period_end) return;
+
+    memguard_pause(part);
+    memguard_resume(part, now);
+}
+
+void jet_memguard_overflow(void)
+{
+    pok_partition_t* part = current_partition;
+
+    if(!memguard_cpu()->running) return;
+
+    memguard_pause(part);
+    // Period may end while the overflow is signalled.
+    memguard_resume(part, jet_system_time());
+
+    // Let the scheduler switch to the idle context.
+    if(part->memguard.throttled)
+        pok_sched_on_time_changed();
+}
+
+#endif /* POK_NEEDS_MEMGUARD */
@@ -16,6 +16,9 @@
 #include <config.h>
 #include <core/partition_arinc.h>
 #include <alloc.h>
+#include <asp/arch.h>
+#include <core/time.h>
+#include <libc.h>
 
 #ifdef POK_NEEDS_MONITOR
 extern pok_partition_t partition_monitor;
@@ -27,22 +30,35 @@ extern pok_partition_t partition_gdb;
 
 void pok_partition_init(pok_partition_t* part)
 {
-   if(part->partition_event_max != 0)
+   uint16_t words = pok_partition_events_words(part);
+
+   if(words != 0)
    {
-      /*
-       * DEV: Allocate one element more than required.
-       * 
-       * This simplifies implementation of ring buffer, when
-       * extracting messages may be concurrent with adding them.
-       */ 
-      part->partition_events = ja_mem_alloc_aligned(
-         sizeof(*part->partition_events) * (part->partition_event_max + 1),
-         __alignof__(*part->partition_events));
+      part->partition_events_pending = ja_mem_alloc_aligned(
+         sizeof(*part->partition_events_pending) * words,
+         __alignof__(*part->partition_events_pending));
    }
    else
    {
-      part->partition_events = NULL;
+      part->partition_events_pending = NULL;
    }
+
+   pok_partition_events_reset(part);
+}
+
+void pok_partition_events_reset(pok_partition_t* part)
+{
+#ifdef POK_NEEDS_SMP
+   SPIN_LOCK(part->partition_event_lock);
+#endif
+
+   part->partition_event_timer = FALSE;
+   memset(part->partition_events_pending, 0,
+      sizeof(*part->partition_events_pending) * pok_partition_events_words(part));
+
+#ifdef POK_NEEDS_SMP
+   SPIN_UNLOCK(part->partition_event_lock);
+#endif
 }
 
 void for_each_partition(void (*f)(pok_partition_t* part))
@@ -63,7 +79,7 @@ void for_each_partition(void (*f)(pok_partition_t* part))
 }
 
 /* 
- * Add event to partition's queue and notify it if needed.
+ * Mark event as pending for partition and notify it.
  * 
  * Should be called with global preemption disabled.
  */
@@ -71,66 +87,121 @@ void pok_partition_add_event(pok_partition_t* part,
     enum jet_partition_event_type event_type,
     uint16_t handler_id)
 {
-   // Whether it is needed to set is_event flag for partition.
-   pok_bool_t set_event =
-      (part->partition_event_end == part->partition_event_begin);
-   /* 
-    * TODO: This is a result of configuration error, when partition
-    * doesn't expect events at all.
-    */
-   assert(part->partition_event_max != 0);
+#ifdef POK_NEEDS_SMP
+   SPIN_LOCK(part->partition_event_lock);
+#endif
 
-   struct jet_partition_event* partition_event = part->partition_events
-      + part->partition_event_end;
+   if(event_type == JET_PARTITION_EVENT_TYPE_TIMER)
+   {
+      part->partition_event_timer = TRUE;
+   }
+   else
+   {
+      /* 
+       * TODO: This is a result of configuration error, when partition
+       * doesn't expect events from this handler.
+       */
+      assert(handler_id < part->partition_event_handlers_n);
+
+      part->partition_events_pending[handler_id / 32] |=
+         (uint32_t)1 << (handler_id % 32);
+   }
 
-   partition_event->handler_id = handler_id;
-   partition_event->event_type = event_type;
+#ifdef POK_NEEDS_SMP
+   SPIN_UNLOCK(part->partition_event_lock);
+#endif
 
-   part->partition_event_end++;
-   if(part->partition_event_end > part->partition_event_max)
-      part->partition_event_end = 0;
+   barrier(); // Event should be written before it becomes visible.
 
    /*
-    * TODO: This is a result of configuration error, when partition
-    * doesn't expect so much events pending.
+    * Flag is set always: partition may take events concurrently
+    * (on other CPU or with global preemption enabled), and bits set by
+    * us may be taken before partition checks the flag once more.
     */
-   assert(part->partition_event_end != part->partition_event_begin);
-
-   if(set_event) {
-      part->is_event = TRUE;
-   }
+   part->is_event = TRUE;
 }
 
-
 /* 
- * Consume event from current partition's queue.
- * 
- * Return TRUE on success, FALSE if the queue is empty.
- * 
- * Should be called with local preemption disabled.
+ * Take given word of the bitmap, or timer bit if 'word' is NULL.
+ *
+ * Producers may run on other CPU or in the interrupt handler, so
+ * value is read and cleared with global preemption disabled.
  */
-pok_bool_t pok_partition_get_event(struct jet_partition_event* event)
+static uint32_t partition_take_events_common(uint32_t* word)
+{
+   pok_partition_t* part = current_partition;
+   uint32_t pending;
+   pok_bool_t preempt_enabled = ja_preempt_enabled();
+
+   if(preempt_enabled) ja_preempt_disable();
+#ifdef POK_NEEDS_SMP
+   SPIN_LOCK(part->partition_event_lock);
+#endif
+
+   if(word)
+   {
+      pending = *word;
+      *word = 0;
+   }
+   else
+   {
+      pending = part->partition_event_timer;
+      part->partition_event_timer = FALSE;
+   }
+
+#ifdef POK_NEEDS_SMP
+   SPIN_UNLOCK(part->partition_event_lock);
+#else
+   (void)part;
+#endif
+   if(preempt_enabled) ja_preempt_enable();
+
+   return pending;
+}
+
+uint32_t pok_partition_take_events(uint16_t word)
 {
    pok_partition_t* part = current_partition;
 
-   uint16_t partition_event_begin = part->partition_event_begin;
-   uint16_t partition_event_end = ACCESS_ONCE(part->partition_event_end);
+   assert(word < pok_partition_events_words(part));
+
+   /* Common case: don't disable preemption for nothing. */
+   if(ACCESS_ONCE(part->partition_events_pending[word]) == 0) return 0;
 
-   if(partition_event_end == partition_event_begin) return FALSE;
+   return partition_take_events_common(&part->partition_events_pending[word]);
+}
+
+pok_bool_t pok_partition_take_timer_event(void)
+{
+   pok_partition_t* part = current_partition;
 
-   *event = ACCESS_ONCE(part->partition_events[partition_event_begin]);
+   if(!ACCESS_ONCE(part->partition_event_timer)) return FALSE;
 
-   ACCESS_ONCE(part->partition_event_begin) =
-      (partition_event_begin == part->partition_event_max) ?
-         0: partition_event_begin + 1;
+   return partition_take_events_common(NULL) != 0;
+}
 
-   return TRUE;
+void pok_partition_cpu_account_get(pok_partition_t* part,
+    jet_cpu_account_t* account)
+{
+    *account = part->cpu_account;
+    account->consumed_time = pok_partition_cpu_time(part, jet_system_time());
 }
 
 void pok_partition_set_timer(pok_partition_t* part,
     pok_time_t timer_new)
 {
      part->timer = timer_new;
+
+#ifdef POK_NEEDS_TICKLESS
+     if(part == current_partition)
+     {
+         pok_bool_t preempt_enabled = ja_preempt_enabled();
+
+         if(preempt_enabled) ja_preempt_disable();
+         pok_sched_program_timer();
+         if(preempt_enabled) ja_preempt_enable();
+     }
+#endif
 }
 
 
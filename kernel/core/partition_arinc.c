@@ -89,12 +89,17 @@ static void partition_arinc_start(void)
 		part->mode = POK_PARTITION_MODE_INIT_COLD;
 	}
 
-	jet_loader_elf_load(part->base_part.space_id - 1, /* elf_id*/
-		part->base_part.space_id,
-		&part->main_entry);
+	if(part->image.restorable)
+		jet_loader_elf_restore(part->base_part.space_id, &part->image);
+	else
+		jet_loader_elf_load(part->base_part.space_id - 1, /* elf_id*/
+			part->base_part.space_id,
+			&part->image);
 
 	part->kshd = ja_space_shared_data(part->base_part.space_id);
 
+	jet_time_page_fill(&part->kshd->time_page);
+
 	if(part->heap_size > 0) {
        char __user *heap_start = ja_space_get_heap(part->base_part.space_id);
        char __user *heap_end = heap_start + part->heap_size;
@@ -120,7 +125,7 @@ static void partition_arinc_start(void)
 
 	ja_ustack_init(part->base_part.space_id);
 
-	INIT_LIST_HEAD(&part->eligible_threads);
+	jet_ready_queue_init(&part->eligible_threads);
 	delayed_event_queue_init(&part->partition_delayed_events);
 
 	for(int i = 0; i < part->nthreads; i++)
@@ -138,7 +143,7 @@ static void partition_arinc_start(void)
 
     pok_thread_t* thread_main = &part->threads[POK_PARTITION_ARINC_MAIN_THREAD_ID];
 
-	thread_main->entry = (void* __user)part->main_entry;
+	thread_main->entry = (void* __user)part->image.entry;
 	thread_main->base_priority = 0;
 	thread_main->period = POK_TIME_INFINITY;
 	thread_main->time_capacity = POK_TIME_INFINITY;
@@ -315,6 +320,10 @@ void pok_partition_arinc_init(pok_partition_arinc_t* part)
 		thread_init(&part->threads[i]);
 	}
 
+	// Every thread may wait on deadline and on delayed event.
+	delayed_event_queue_alloc(&part->partition_delayed_events,
+		part->nthreads * 2);
+
 	part->base_part.part_ops = &arinc_ops;
 	part->base_part.part_sched_ops = &arinc_sched_ops;
 }
@@ -427,6 +436,21 @@ pok_ret_t pok_partition_set_mode_current (const pok_partition_mode_t mode)
 	return res;
 }
 
+/**
+ * Get CPU usage of the current partition, including current time window.
+ */
+pok_ret_t pok_current_partition_get_cpu_account(jet_cpu_account_t* __user account)
+{
+    jet_cpu_account_t* __kuser k_account = jet_user_to_kernel_typed(account);
+    if(!k_account) return POK_ERRNO_EFAULT;
+
+    pok_preemption_disable();
+    pok_partition_cpu_account_get(current_partition, k_account);
+    __pok_preemption_enable();
+
+    return POK_ERRNO_OK;
+}
+
 /**
  * Get partition information. Used for ARINC GET_PARTITION_STATUS function.
  */
@@ -494,7 +518,8 @@ pok_ret_t pok_current_partition_dec_lock_level(int32_t * __user lock_level)
     pok_preemption_local_disable();
     if(--current_partition_arinc->lock_level == 0)
     {
-		if(current_thread->eligible_elem.prev != &current_partition_arinc->eligible_threads)
+		if(!jet_ready_queue_is_first(&current_partition_arinc->eligible_threads,
+			&current_thread->eligible_elem))
 		{
 			// We are not the first thread in eligible queue
 			pok_sched_local_invalidate();
@@ -513,9 +538,5 @@ void pok_partition_arinc_init_all(void)
 	for(int i = 0; i < pok_partitions_arinc_n; i++)
 	{
 		pok_partition_arinc_init(&pok_partitions_arinc[i]);
-
-#ifdef POK_NEEDS_INSTRUMENTATION
-		pok_instrumentation_partition_archi (i);
-#endif
 	}
 }
@@ -16,6 +16,7 @@
 // Implementation for idle partition.
 
 #include <core/partition.h>
+#include <core/sched.h>
 #include <common.h>
 #include <asp/arch.h>
 
@@ -39,18 +40,20 @@ static const struct pok_partition_operations partition_idle_operations =
     .process_partition_error = partition_idle_process_error
 };
 
-pok_partition_t partition_idle =
+pok_partition_t partition_idle_cpus[POK_CONFIG_NB_CPUS] =
 {
-    .name = "Idle",
+    [0 ... POK_CONFIG_NB_CPUS - 1] = {
+        .name = "Idle",
 
-    .partition_event_max = 0,
+        .partition_event_handlers_n = 0,
 
-    .period = 0,
-    .space_id = 0,
+        .period = 0,
+        .space_id = 0,
 
-    .part_sched_ops = &partition_sched_ops_kernel,
-    .part_ops = &partition_idle_operations,
+        .part_sched_ops = &partition_sched_ops_kernel,
+        .part_ops = &partition_idle_operations,
 
-    .multi_partition_hm_selector = &pok_hm_multi_partition_selector_default,
-    .multi_partition_hm_table = &pok_hm_multi_partition_table_default,
+        .multi_partition_hm_selector = &pok_hm_multi_partition_selector_default,
+        .multi_partition_hm_table = &pok_hm_multi_partition_table_default,
+    }
 };
@@ -0,0 +1,115 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+
+#include <core/perf.h>
+#include <core/partition.h>
+#include <core/sched.h>
+#include <core/uaccess.h>
+#include <asp/perf.h>
+#include <asp/cpu.h>
+#include <errno.h>
+
+/* Number of counters available on every CPU. */
+static unsigned perf_counters_n[POK_CONFIG_NB_CPUS];
+
+void jet_perf_init(void)
+{
+    perf_counters_n[ja_cpu_id()] = ja_perf_init();
+}
+
+void jet_perf_switch(pok_partition_t* old, pok_partition_t* new)
+{
+    unsigned n = perf_counters_n[ja_cpu_id()];
+
+    for(unsigned i = 0; i < n; i++)
+    {
+        jet_perf_event_t event_old = JET_PERF_EVENT_NONE;
+        jet_perf_event_t event_new = new->perf.events[i];
+
+        if(old != NULL)
+        {
+            event_old = old->perf.events[i];
+
+            if(event_old != JET_PERF_EVENT_NONE)
+                old->perf.values[i] += ja_perf_read(i);
+        }
+
+        // Counter which is stopped and should be stopped is not touched.
+        if(event_old != JET_PERF_EVENT_NONE || event_new != JET_PERF_EVENT_NONE)
+            ja_perf_start(i, event_new);
+    }
+}
+
+void jet_perf_reset(void)
+{
+    struct jet_perf_partition* perf = &current_partition->perf;
+    unsigned n = perf_counters_n[ja_cpu_id()];
+
+    for(unsigned i = 0; i < n; i++)
+    {
+        if(perf->events[i] != JET_PERF_EVENT_NONE)
+        {
+            perf->events[i] = JET_PERF_EVENT_NONE;
+            ja_perf_start(i, JET_PERF_EVENT_NONE);
+        }
+        perf->values[i] = 0;
+    }
+}
+
+pok_ret_t jet_perf_counter_setup(unsigned index, jet_perf_event_t event)
+{
+    struct jet_perf_partition* perf = &current_partition->perf;
+
+    if(index >= perf_counters_n[ja_cpu_id()]) return POK_ERRNO_EINVAL;
+
+    if(event != JET_PERF_EVENT_NONE && !ja_perf_event_supported(event))
+        return POK_ERRNO_UNAVAILABLE;
+
+    pok_preemption_disable();
+    perf->events[index] = event;
+    perf->values[index] = 0;
+    ja_perf_start(index, event);
+    __pok_preemption_enable();
+
+    return POK_ERRNO_OK;
+}
+
+pok_ret_t jet_perf_counters_read(jet_perf_counters_t* __user counters)
+{
+    jet_perf_counters_t* __kuser k_counters = jet_user_to_kernel_typed(counters);
+    struct jet_perf_partition* perf = &current_partition->perf;
+
+    if(!k_counters) return POK_ERRNO_EFAULT;
+
+    pok_preemption_disable();
+    for(unsigned i = 0; i < JET_PERF_COUNTERS_MAX; i++)
+    {
+        uint64_t value = perf->values[i];
+
+        if(perf->events[i] != JET_PERF_EVENT_NONE)
+            value += ja_perf_read(i);
+
+        k_counters->values[i] = value;
+    }
+    __pok_preemption_enable();
+
+    return POK_ERRNO_OK;
+}
+
+#endif /* POK_NEEDS_PERF_COUNTERS */
@@ -19,6 +19,7 @@
 #include "thread_internal.h"
 #include <core/uaccess.h>
 #include <core/sched_arinc.h>
+#include <core/trace.h>
 
 /* 
  * Find *configured* queuing port by name, which comes from user space.
@@ -66,17 +67,38 @@ static pok_port_queuing_t* get_port_queuing(pok_port_id_t id)
 
 void port_queuing_receive(pok_port_queuing_t* port, pok_thread_t* t)
 {
-    pok_message_size_t message_size;
-    const char* message = pok_channel_queuing_r_get_message(
-        port->channel, &message_size, FALSE);
+    pok_bool_t message_discarded;
 
-    assert(message);
+    if(port->channel->overflow_strategy == JET_CHANNEL_QUEUING_RECEIVER_OVERWRITE)
+    {
+        /*
+         * Until the message is consumed, the sender may overwrite it
+         * (possibly on other CPU). So copy the message with channel locked.
+         */
+        pok_port_size_t message_size;
+        pok_message_range_t n = pok_channel_queuing_r_receive_messages(
+            port->channel, port->side, t->wait_buffer.dest, 0,
+            &message_size, 1, &message_discarded);
+
+        assert(n == 1);
+        (void)n;
+
+        t->wait_len = message_size;
+    }
+    else
+    {
+        pok_message_size_t message_size;
+        const char* message = pok_channel_queuing_r_get_message(
+            port->channel, port->side, &message_size, FALSE);
 
-    memcpy(t->wait_buffer.dest, message, message_size);
-    t->wait_len = message_size;
+        assert(message);
 
-    pok_bool_t message_discarded;
-    pok_channel_queuing_r_consume_message(port->channel, &message_discarded);
+        memcpy(t->wait_buffer.dest, message, message_size);
+        t->wait_len = message_size;
+
+        pok_channel_queuing_r_consume_message(port->channel, port->side,
+            &message_discarded);
+    }
 
     t->wait_result = message_discarded? POK_ERRNO_TOOMANY : POK_ERRNO_OK;
 }
@@ -93,11 +115,49 @@ void port_queuing_send(pok_port_queuing_t* port, pok_thread_t* t)
     t->wait_result = POK_ERRNO_OK;
 }
 
+void port_queuing_fired(pok_port_queuing_t* port_queuing)
+{
+    // Message is held by zero-copy operation. Waiters will be processed on release.
+    if(port_queuing->is_zero_copy_held) return;
+
+    if(port_queuing->direction == POK_PORT_DIRECTION_IN)
+    {
+        while(!pok_thread_wq_is_empty(&port_queuing->waiters))
+        {
+            pok_thread_t* t;
+            pok_message_size_t message_size; // Just for function's call.
+
+            if(!pok_channel_queuing_r_get_message(port_queuing->channel,
+                port_queuing->side, &message_size, TRUE))
+                break; // wait again
+
+            t = pok_thread_wq_wake_up(&port_queuing->waiters);
+
+            port_queuing_receive(port_queuing, t);
+        }
+    }
+    else // if(port_queuing->direction == POK_PORT_DIRECTION_OUT)
+    {
+        while(!pok_thread_wq_is_empty(&port_queuing->waiters))
+        {
+            pok_thread_t* t;
+
+            if(!pok_channel_queuing_s_get_message(port_queuing->channel, TRUE))
+                break; // wait again
+
+            t = pok_thread_wq_wake_up(&port_queuing->waiters);
+
+            port_queuing_send(port_queuing, t);
+        }
+    }
+}
+
 void pok_port_queuing_init(pok_port_queuing_t* port_queuing)
 {
     pok_thread_wq_init(&port_queuing->waiters);
 
     port_queuing->is_created = FALSE;
+    port_queuing->is_zero_copy_held = FALSE;
 }
 
 
@@ -128,16 +188,8 @@ pok_ret_t pok_port_queuing_create(
     if(direction != port_queuing->direction)
         return POK_ERRNO_EINVAL;
 
-    if(direction == POK_PORT_DIRECTION_IN)
-    {
-        if(max_nb_message != port_queuing->channel->recv.max_nb_message)
-            return POK_ERRNO_EINVAL;
-    }
-    else // (direction == POK_PORT_DIRECTION_OUT)
-    {
-        if(max_nb_message != port_queuing->channel->send.max_nb_message)
-            return POK_ERRNO_EINVAL;
-    }
+    if(max_nb_message != port_queuing->side->max_nb_message)
+        return POK_ERRNO_EINVAL;
 
 
     if(current_partition_arinc->mode == POK_PARTITION_MODE_NORMAL)
@@ -146,17 +198,9 @@ pok_ret_t pok_port_queuing_create(
     port_queuing->is_created = TRUE;
     port_queuing->discipline = discipline;
 
-    if(direction == POK_PORT_DIRECTION_IN) {
-        pok_channel_queuing_side_init(port_queuing->channel,
-            &port_queuing->channel->recv,
-            port_queuing - current_partition_arinc->ports_queuing);
-    }
-    else {
-        /* direction == POK_PORT_DIRECTION_OUT */
-        pok_channel_queuing_side_init(port_queuing->channel,
-            &port_queuing->channel->send,
-            port_queuing - current_partition_arinc->ports_queuing);
-    }
+    pok_channel_queuing_side_init(port_queuing->channel,
+        port_queuing->side,
+        port_queuing - current_partition_arinc->ports_queuing);
 
     *k_id = port_queuing - current_partition_arinc->ports_queuing;
 
@@ -208,6 +252,9 @@ pok_ret_t pok_port_queuing_receive(
     if(port_queuing->direction != POK_PORT_DIRECTION_IN)
         return POK_ERRNO_MODE;
 
+    jet_trace(JET_TRACE_CLASS_PORT, JET_TRACE_EVENT_QUEUING_RECEIVE,
+        JET_TRACE_THREAD(current_thread), id);
+
     pok_preemption_local_disable();
 
     t = current_thread;
@@ -234,7 +281,9 @@ pok_ret_t pok_port_queuing_receive(
 
     pok_message_size_t message_size; // Only for call r_get_message().
     if(!pok_thread_wq_is_empty(&port_queuing->waiters) ||
+        port_queuing->is_zero_copy_held ||
         !pok_channel_queuing_r_get_message(port_queuing->channel,
+            port_queuing->side,
             &message_size,
             ret == POK_ERRNO_OK))
     {
@@ -308,6 +357,9 @@ pok_ret_t pok_port_queuing_send(
 
     pok_time_t kernel_timeout = *k_timeout;
 
+    jet_trace(JET_TRACE_CLASS_PORT, JET_TRACE_EVENT_QUEUING_SEND,
+        JET_TRACE_THREAD(current_thread), id);
+
     pok_preemption_local_disable();
 
     /*
@@ -331,6 +383,7 @@ pok_ret_t pok_port_queuing_send(
         ret = POK_ERRNO_OK;
 
     if(!pok_thread_wq_is_empty(&port_queuing->waiters)
+        || port_queuing->is_zero_copy_held
         || !pok_channel_queuing_s_get_message(port_queuing->channel, ret == POK_ERRNO_OK))
     {
         if(ret)
@@ -367,6 +420,124 @@ err:
 }
 
 
+pok_ret_t pok_port_queuing_receive_batch(
+    pok_port_id_t               id,
+    void* __user                data,
+    pok_port_size_t* __user     lens,
+    pok_port_size_t             n,
+    pok_port_size_t* __user     n_received)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_ret_t ret;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_IN)
+        return POK_ERRNO_MODE;
+
+    if(n == 0 || n > port_queuing->side->max_nb_message)
+        return POK_ERRNO_EINVAL;
+
+    pok_message_size_t stride = port_queuing->channel->max_message_size;
+
+    void* __kuser k_data = jet_user_to_kernel(data, stride * n);
+    if(!k_data) return POK_ERRNO_EFAULT;
+
+    pok_port_size_t* __kuser k_lens = jet_user_to_kernel(lens, sizeof(*lens) * n);
+    if(!k_lens) return POK_ERRNO_EFAULT;
+
+    pok_port_size_t* __kuser k_n_received = jet_user_to_kernel_typed(n_received);
+    if(!k_n_received) return POK_ERRNO_EFAULT;
+
+    pok_preemption_local_disable();
+
+    pok_message_range_t n_real = 0;
+    pok_bool_t message_discarded = FALSE;
+
+    // Waiters have a priority over us.
+    if(pok_thread_wq_is_empty(&port_queuing->waiters)
+        && !port_queuing->is_zero_copy_held)
+    {
+        n_real = pok_channel_queuing_r_receive_messages(port_queuing->channel,
+            port_queuing->side, k_data, stride, k_lens, n, &message_discarded);
+    }
+
+    pok_preemption_local_enable();
+
+    *k_n_received = n_real;
+
+    if(n_real == 0)
+        ret = POK_ERRNO_EMPTY;
+    else if(message_discarded)
+        ret = POK_ERRNO_TOOMANY;
+    else
+        ret = POK_ERRNO_OK;
+
+    return ret;
+}
+
+pok_ret_t pok_port_queuing_send_batch(
+    pok_port_id_t               id,
+    const void* __user          data,
+    const pok_port_size_t* __user lens,
+    pok_port_size_t             n,
+    pok_port_size_t* __user     n_sent)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_port_size_t i;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_OUT)
+        return POK_ERRNO_MODE;
+
+    if(n == 0 || n > port_queuing->side->max_nb_message)
+        return POK_ERRNO_EINVAL;
+
+    pok_message_size_t stride = port_queuing->channel->max_message_size;
+
+    const void* __kuser k_data = jet_user_to_kernel_ro(data, stride * n);
+    if(!k_data) return POK_ERRNO_EFAULT;
+
+    const pok_port_size_t* __kuser k_lens = jet_user_to_kernel_ro(lens, sizeof(*lens) * n);
+    if(!k_lens) return POK_ERRNO_EFAULT;
+
+    pok_port_size_t* __kuser k_n_sent = jet_user_to_kernel_typed(n_sent);
+    if(!k_n_sent) return POK_ERRNO_EFAULT;
+
+    /*
+     * error should be INVALID_CONFIG
+     *
+     * Lengths are in user memory and may be changed after this check,
+     * so the channel checks every length again when sends the message.
+     */
+    for(i = 0; i < n; i++)
+    {
+        if(k_lens[i] == 0 || k_lens[i] > stride)
+            return POK_ERRNO_EINVAL;
+    }
+
+    pok_preemption_local_disable();
+
+    pok_message_range_t n_real = 0;
+
+    // Waiters have a priority over us.
+    if(pok_thread_wq_is_empty(&port_queuing->waiters)
+        && !port_queuing->is_zero_copy_held)
+    {
+        n_real = pok_channel_queuing_s_send_messages(port_queuing->channel,
+            k_data, stride, k_lens, n);
+    }
+
+    pok_preemption_local_enable();
+
+    *k_n_sent = n_real;
+
+    return n_real ? POK_ERRNO_OK : POK_ERRNO_FULL;
+}
+
 pok_ret_t pok_port_queuing_status(
     pok_port_id_t               id,
     pok_port_queuing_status_t * __user status)
@@ -389,14 +560,16 @@ pok_ret_t pok_port_queuing_status(
     pok_preemption_local_disable();
 
     k_status->waiting_processes = pok_thread_wq_get_nwaits(&port_queuing->waiters);
+    k_status->nb_discarded = port_queuing->side->nb_discarded;
 
     if(port_queuing->direction == POK_PORT_DIRECTION_IN) {
-        k_status->max_nb_message = channel->recv.max_nb_message;
-        k_status->nb_message = pok_channel_queuing_r_n_messages(channel);
+        k_status->max_nb_message = port_queuing->side->max_nb_message;
+        k_status->nb_message = pok_channel_queuing_r_n_messages(channel,
+            port_queuing->side);
     }
     else {
         /* port_queuing->direction == POK_PORT_DIRECTION_OUT */
-        k_status->max_nb_message = channel->send.max_nb_message;
+        k_status->max_nb_message = port_queuing->side->max_nb_message;
         k_status->nb_message = pok_channel_queuing_s_n_messages(channel);
     }
 
@@ -438,8 +611,185 @@ pok_ret_t pok_port_queuing_clear(pok_port_id_t id)
 
     pok_preemption_local_disable();
     pok_channel_queuing_side_init(port_queuing->channel,
-            &port_queuing->channel->recv,
+            port_queuing->side,
             port_queuing - current_partition_arinc->ports_queuing);
+    // Peeked message (if any) is dropped too.
+    port_queuing->is_zero_copy_held = FALSE;
+    pok_preemption_local_enable();
+
+    return POK_ERRNO_OK;
+}
+
+pok_ret_t pok_port_queuing_peek(
+    pok_port_id_t               id,
+    const void** __user         message,
+    pok_port_size_t* __user     len)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_ret_t ret;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_IN)
+        return POK_ERRNO_MODE;
+
+    if(!port_queuing->channel->is_zero_copy)
+        return POK_ERRNO_UNAVAILABLE;
+
+    const void** __kuser k_message = jet_user_to_kernel_typed(message);
+    if(!k_message) return POK_ERRNO_EFAULT;
+
+    pok_port_size_t* __kuser k_len = jet_user_to_kernel_typed(len);
+    if(!k_len) return POK_ERRNO_EFAULT;
+
+    pok_preemption_local_disable();
+
+    if(port_queuing->is_zero_copy_held)
+    {
+        ret = POK_ERRNO_EXISTS;
+        goto out;
+    }
+
+    const char* m;
+    pok_message_size_t message_size;
+
+    // Waiters have a priority over us.
+    if(!pok_thread_wq_is_empty(&port_queuing->waiters) ||
+        !(m = pok_channel_queuing_r_get_message(port_queuing->channel,
+            port_queuing->side, &message_size, FALSE)))
+    {
+        ret = POK_ERRNO_EMPTY;
+        goto out;
+    }
+
+    port_queuing->is_zero_copy_held = TRUE;
+
+    // Message array of zero-copy channel has the same address in user space.
+    *k_message = (const void* __user)m;
+    *k_len = message_size;
+
+    ret = POK_ERRNO_OK;
+
+out:
+    pok_preemption_local_enable();
+
+    return ret;
+}
+
+pok_ret_t pok_port_queuing_consume(pok_port_id_t id)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_bool_t message_discarded;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_IN)
+        return POK_ERRNO_MODE;
+
+    pok_preemption_local_disable();
+
+    if(!port_queuing->is_zero_copy_held)
+    {
+        pok_preemption_local_enable();
+        return POK_ERRNO_EINVAL;
+    }
+
+    pok_channel_queuing_r_consume_message(port_queuing->channel,
+        port_queuing->side, &message_discarded);
+    port_queuing->is_zero_copy_held = FALSE;
+
+    // Pass next messages to the waiters, if any.
+    port_queuing_fired(port_queuing);
+
+    pok_preemption_local_enable();
+
+    return message_discarded? POK_ERRNO_TOOMANY : POK_ERRNO_OK;
+}
+
+pok_ret_t pok_port_queuing_reserve(
+    pok_port_id_t               id,
+    void** __user               message)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_ret_t ret;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_OUT)
+        return POK_ERRNO_MODE;
+
+    if(!port_queuing->channel->is_zero_copy)
+        return POK_ERRNO_UNAVAILABLE;
+
+    void** __kuser k_message = jet_user_to_kernel_typed(message);
+    if(!k_message) return POK_ERRNO_EFAULT;
+
+    pok_preemption_local_disable();
+
+    if(port_queuing->is_zero_copy_held)
+    {
+        ret = POK_ERRNO_EXISTS;
+        goto out;
+    }
+
+    char* m;
+
+    // Waiters have a priority over us.
+    if(!pok_thread_wq_is_empty(&port_queuing->waiters) ||
+        !(m = pok_channel_queuing_s_get_message(port_queuing->channel, FALSE)))
+    {
+        ret = POK_ERRNO_FULL;
+        goto out;
+    }
+
+    port_queuing->is_zero_copy_held = TRUE;
+
+    // Message array of zero-copy channel has the same address in user space.
+    *k_message = (void* __user)m;
+
+    ret = POK_ERRNO_OK;
+
+out:
+    pok_preemption_local_enable();
+
+    return ret;
+}
+
+pok_ret_t pok_port_queuing_commit(
+    pok_port_id_t               id,
+    pok_port_size_t             len)
+{
+    pok_port_queuing_t* port_queuing;
+
+    port_queuing = get_port_queuing(id);
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    if(port_queuing->direction != POK_PORT_DIRECTION_OUT)
+        return POK_ERRNO_MODE;
+
+    // error should be INVALID_CONFIG
+    if(len > port_queuing->channel->max_message_size)
+        return POK_ERRNO_EINVAL;
+
+    pok_preemption_local_disable();
+
+    if(!port_queuing->is_zero_copy_held)
+    {
+        pok_preemption_local_enable();
+        return POK_ERRNO_EINVAL;
+    }
+
+    if(len != 0)
+        pok_channel_queuing_s_produce_message(port_queuing->channel, len);
+
+    port_queuing->is_zero_copy_held = FALSE;
+
+    // Let the waiters to send their messages, if any.
+    port_queuing_fired(port_queuing);
+
     pok_preemption_local_enable();
 
     return POK_ERRNO_OK;
@@ -540,7 +890,8 @@ pok_ret_t pok_port_sampling_create(
     }
     else
     {
-        pok_channel_sampling_r_clear_message(port_sampling->channel);
+        pok_channel_sampling_r_clear_message(port_sampling->channel,
+            port_sampling->reader);
     }
 
     *k_id = port_sampling - current_partition_arinc->ports_sampling;
@@ -570,6 +921,9 @@ pok_ret_t pok_port_sampling_write(
     const void* __kuser k_data = jet_user_to_kernel_ro(data, len);
     if(!k_data) return POK_ERRNO_EFAULT;
 
+    jet_trace(JET_TRACE_CLASS_PORT, JET_TRACE_EVENT_SAMPLING_WRITE,
+        JET_TRACE_THREAD(current_thread), id);
+
     pok_preemption_local_disable();
 
     message = pok_channel_sampling_s_get_message(port_sampling->channel);
@@ -612,9 +966,13 @@ pok_ret_t pok_port_sampling_read(
     pok_bool_t* __kuser k_valid = jet_user_to_kernel_typed(valid);
     if(!k_len) return POK_ERRNO_EFAULT;
 
+    jet_trace(JET_TRACE_CLASS_PORT, JET_TRACE_EVENT_SAMPLING_READ,
+        JET_TRACE_THREAD(current_thread), id);
+
     pok_preemption_local_disable();
 
     message = pok_channel_sampling_r_get_message(port_sampling->channel,
+        port_sampling->reader,
         &message_size, &ts);
 
     if(message)
@@ -685,6 +1043,11 @@ pok_ret_t pok_port_sampling_status (
     k_status->direction = port_sampling->direction;
     k_status->refresh = port_sampling->refresh_period;
     k_status->validity = port_sampling->last_message_validity;
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    k_status->shared = port_sampling->shared;
+#else
+    k_status->shared = NULL;
+#endif
 
     pok_preemption_local_enable();
 
@@ -707,10 +1070,32 @@ pok_ret_t pok_port_sampling_check(pok_port_id_t id)
 
 
     pok_preemption_local_disable();
-    ret = pok_channel_sampling_r_check_new_message(port_sampling->channel)
+    ret = pok_channel_sampling_r_check_new_message(port_sampling->channel,
+            port_sampling->reader)
         ? POK_ERRNO_OK
         : POK_ERRNO_EMPTY;
     pok_preemption_local_enable();
 
     return ret;
 }
+
+#ifdef POK_NEEDS_SAMPLING_SHARED
+void pok_port_sampling_share_all(void)
+{
+    for(int i = 0; i < pok_partitions_arinc_n; i++)
+    {
+        pok_partition_arinc_t* part = &pok_partitions_arinc[i];
+
+        for(int j = 0; j < part->nports_sampling; j++)
+        {
+            pok_port_sampling_t* port_sampling = &part->ports_sampling[j];
+            pok_channel_sampling_t* channel = port_sampling->channel;
+
+            if(port_sampling->direction != POK_PORT_DIRECTION_IN) continue;
+
+            port_sampling->shared = ja_space_map_ro(part->base_part.space_id,
+                channel->shared, channel->shared_size);
+        }
+    }
+}
+#endif /* POK_NEEDS_SAMPLING_SHARED */
@@ -20,6 +20,7 @@
 
 #include <core/time.h>
 #include <core/sched.h>
+#include <asp/entries.h>
 #include <core/thread.h>
 
 #include <core/partition.h>
@@ -27,21 +28,77 @@
 #include <dependencies.h>
 
 #include <core/debug.h>
-#include <core/instrumentation.h>
+#include <core/trace.h>
 #include <core/error.h>
 
 #include <assert.h>
 
 #include <cswitch.h>
 #include <core/space.h>
+#include <asp/cpu.h>
 
-static pok_time_t first_frame_starts; // Time when first major frame is started.
+#ifdef POK_NEEDS_MEMGUARD
+#include <core/memguard.h>
+#endif
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+#include <core/perf.h>
+#endif
+
+/*
+ * Time when first major frame is started.
+ *
+ * Major frames of all CPUs are started at the same time.
+ */
+static pok_time_t first_frame_starts;
+
+/* Scheduler state of one CPU. */
+struct sched_cpu
+{
+    /* Schedule of the CPU. Empty if the CPU is not used. */
+    const pok_sched_slot_t* slots;
+    uint8_t slots_n;
+
+    pok_time_t next_deadline;
+    pok_time_t next_major_frame;
+    uint8_t current_slot; /* Which slot are we executing at this time ?*/
+
+    pok_bool_t need_recheck;
 
-static pok_time_t            pok_sched_next_deadline;
-static pok_time_t            pok_sched_next_major_frame;
-static uint8_t               pok_sched_current_slot = 0; /* Which slot are we executing at this time ?*/
+    /*
+     * Pointer to the store area for last executed (user) thread.
+     *
+     * If no thread has been executed yet, or the last one dies, this is NULL.
+     *
+     * With lazy FP switching this is the thread whose values are currently
+     * in FP registers.
+     */
+    struct jet_fp_store* fp_store_last;
+
+#ifdef POK_NEEDS_MONITOR
+    /*
+     * Whether current partition is held (see partition_is_held()).
+     *
+     * This flag affects on the place, where currently used context should
+     * be stored on context switch.
+     * From the other side, the flag can be changed *outside* of scheduler.
+     */
+    pok_bool_t current_partition_is_paused;
+
+    struct jet_context* idle_sp;
+    uint32_t idle_stack;
+#endif
+};
+
+static struct sched_cpu sched_cpus[POK_CONFIG_NB_CPUS];
+
+/* Scheduler state of the current CPU. */
+static inline struct sched_cpu* sched_cpu(void)
+{
+    return &sched_cpus[ja_cpu_id()];
+}
 
-pok_partition_t* current_partition = NULL;
+pok_partition_t* current_partition_cpus[POK_CONFIG_NB_CPUS];
 
 #if POK_NEEDS_GDB
 struct jet_interrupt_context* global_thread_stack = NULL;
@@ -49,32 +106,57 @@ volatile pok_bool_t pok_in_user_space = 0;
 #endif
 
 #ifdef POK_NEEDS_MONITOR
-/*
- * Whether current partition has `.is_paused` flag set.
- *
- * This flag affects on the place, where currently used context should
- * be stored on context switch.
- * From the other side, the flag can be changed *outside* of scheduler.
- */
-pok_bool_t current_partition_is_paused;
-
-struct jet_context* idle_sp;
-uint32_t idle_stack;
-
 static void idle_function(void)
 {
     pok_preemption_enable();
 
     ja_inf_loop();
 }
-#endif
 
 /*
- * Pointer to the store area for last executed (user) thread.
- *
- * If no thread has been executed yet, or the last one dies, this is NULL.
+ * Whether idle context should be executed in the slots of the partition
+ * instead of its own one: partition is paused by the monitor or
+ * throttled because of its memory bandwidth.
  */
-struct jet_fp_store* fp_store_last = NULL;
+static inline pok_bool_t partition_is_held(pok_partition_t* part)
+{
+#ifdef POK_NEEDS_MEMGUARD
+    if(part->memguard.throttled) return TRUE;
+#endif
+    return part->is_paused;
+}
+#endif
+
+void jet_fp_on_switch(void)
+{
+    if(sched_cpu()->fp_store_last != current_partition->fp_store_current)
+        ja_fp_disable();
+}
+
+pok_bool_t jet_fp_unavailable(void)
+{
+    struct sched_cpu* cpu = sched_cpu();
+    struct jet_fp_store* fp_store = current_partition->fp_store_current;
+
+    assert(!ja_preempt_enabled());
+
+    if(!fp_store) return FALSE; // Kernel partition or idle thread.
+
+    ja_fp_enable();
+
+    if(cpu->fp_store_last != fp_store)
+    {
+        if(cpu->fp_store_last)
+        {
+            ja_fp_save(cpu->fp_store_last);
+        }
+
+        cpu->fp_store_last = fp_store;
+        ja_fp_restore(fp_store);
+    }
+
+    return TRUE;
+}
 
 // Reset partition state, so scheduler may restart.
 static void pok_partition_reset(pok_partition_t* part)
@@ -87,18 +169,92 @@ static void pok_partition_reset(pok_partition_t* part)
         part->partition_generation = 1;
     }
 
-    part->partition_event_begin = part->partition_event_end = 0;
+    pok_partition_events_reset(part);
+}
+
+/* Reset partitions scheduled on the given CPU. */
+static void sched_reset_partitions(struct sched_cpu* cpu)
+{
+#ifdef POK_NEEDS_SMP
+    /*
+     * Partitions of other CPUs continue to run.
+     *
+     * Partition with several slots is reset several times, it is harmless.
+     */
+    for(int i = 0; i < cpu->slots_n; i++)
+        pok_partition_reset(cpu->slots[i].partition);
+#else
+    (void)cpu;
+    for_each_partition(&pok_partition_reset);
+#endif
+}
+
+/* Start of the current major frame. */
+static inline pok_time_t sched_current_frame_start(struct sched_cpu* cpu)
+{
+    return cpu->next_major_frame - pok_config_scheduling_major_frame;
+}
+
+/*
+ * Account CPU time of the partitions on switch between them.
+ *
+ * Should be called after the new time slot is selected.
+ */
+static void sched_account_switch(struct sched_cpu* cpu,
+    pok_partition_t* old_part, pok_partition_t* new_part, pok_time_t now)
+{
+    pok_time_t window_start = cpu->next_deadline
+        - cpu->slots[cpu->current_slot].duration;
+    jet_cpu_account_t* new_account = &new_part->cpu_account;
+
+    old_part->cpu_account.consumed_time += now - old_part->cpu_account_start;
+    old_part->cpu_account.n_preemptions++;
+
+    new_part->cpu_account_start = now;
+    new_account->n_activations++;
+    if(now - window_start > new_account->max_response_time)
+        new_account->max_response_time = now - window_start;
 }
 
+#ifdef POK_NEEDS_TICKLESS
+/*
+ * Program one-shot timer for the nearest event which scheduler should
+ * react on, when given partition is executed: end of the current
+ * time slot or expiration of the partition's timer.
+ */
+static void sched_program_timer(pok_partition_t* part)
+{
+    pok_time_t timepoint = sched_cpu()->next_deadline;
+    pok_time_t part_timer = part->timer;
+
+    if(part_timer != 0 && part_timer < timepoint)
+        timepoint = part_timer;
+
+#ifdef POK_NEEDS_MEMGUARD
+    // Throttled partition is resumed at the end of its period.
+    if(part->memguard.throttled && part->memguard.period_end < timepoint)
+        timepoint = part->memguard.period_end;
+#endif
+
+    ja_timer_set_oneshot(timepoint);
+}
 
-static pok_bool_t sched_need_recheck;
+void pok_sched_program_timer(void)
+{
+    sched_program_timer(current_partition);
+}
+#endif /* POK_NEEDS_TICKLESS */
 
 static void start_partition(void)
 {
     pok_partition_t* part = current_partition;
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+    jet_perf_reset();
+#endif
     // Initialize state for started partition.
     part->is_event = FALSE;
-    part->partition_event_begin = part->partition_event_end = 0;
+    pok_partition_events_reset(part);
 
     part->preempt_local_disabled = 1;
 
@@ -117,14 +273,15 @@ static void intra_partition_switch(void)
     struct jet_context** old_sp = &current_partition->sp;
 
 #ifdef POK_NEEDS_MONITOR
+    struct sched_cpu* cpu = sched_cpu();
     struct jet_context** new_sp = old_sp;
-    if(current_partition_is_paused) old_sp = &idle_sp;
-    if(current_partition->is_paused) new_sp = &idle_sp;
+    if(cpu->current_partition_is_paused) old_sp = &cpu->idle_sp;
+    if(partition_is_held(current_partition)) new_sp = &cpu->idle_sp;
 
     if(old_sp != new_sp)
     {
         /* Need to switch context */
-        current_partition_is_paused = current_partition->is_paused;
+        cpu->current_partition_is_paused = partition_is_held(current_partition);
 
         if(*old_sp == NULL)
         {
@@ -167,23 +324,30 @@ static void intra_partition_switch(void)
 /* Switch to the new partition. */
 static void inter_partition_switch(pok_partition_t* part)
 {
+#ifdef POK_NEEDS_MONITOR
+    struct sched_cpu* cpu = sched_cpu();
+#endif
     struct jet_context** old_sp = &current_partition->sp;
     struct jet_context** new_sp = &part->sp;
 #if POK_NEEDS_GDB
     current_partition->entry_sp = global_thread_stack;
+#endif
+#ifdef POK_NEEDS_PERF_COUNTERS
+    jet_perf_switch(current_partition, part);
 #endif
     current_partition = part;
+    jet_fp_on_switch();
 
     if(part->space_id != 0)
         pok_space_switch(part->space_id);
     else
         pok_space_switch(0); // TODO: This should disable all user space tables
 #ifdef POK_NEEDS_MONITOR
-    if(current_partition_is_paused) old_sp = &idle_sp;
-    if(part->is_paused)
+    if(cpu->current_partition_is_paused) old_sp = &cpu->idle_sp;
+    if(partition_is_held(part))
     {
-        assert(idle_sp); // Idle sp shouldn't be 0.
-        new_sp = &idle_sp;
+        assert(cpu->idle_sp); // Idle sp shouldn't be 0.
+        new_sp = &cpu->idle_sp;
     }
 
     if(old_sp == new_sp)
@@ -192,7 +356,7 @@ static void inter_partition_switch(pok_partition_t* part)
         return;
     }
 
-    current_partition_is_paused = part->is_paused;
+    cpu->current_partition_is_paused = partition_is_held(part);
 #endif /* POK_NEEDS_MONITOR */
     // old_sp != new_sp
 
@@ -218,54 +382,143 @@ static void inter_partition_switch(pok_partition_t* part)
 }
 
 
-void pok_sched_restart (void)
+/*
+ * Start schedule of the current CPU from the major frame, which begins
+ * at 'frame_start'.
+ *
+ * If the frame is not started yet, idle partition is executed until that.
+ */
+static void sched_start_frame(pok_time_t frame_start)
 {
+    struct sched_cpu* cpu = sched_cpu();
+    pok_partition_t* part;
     struct jet_context** new_sp;
+    pok_time_t now;
 
-    first_frame_starts = jet_system_time();
 #ifdef POK_NEEDS_MONITOR
-    idle_sp = jet_context_init(idle_stack, &idle_function);
+    cpu->idle_sp = jet_context_init(cpu->idle_stack, &idle_function);
 #endif /*POK_NEEDS_MONITOR */
 
-    for_each_partition(&pok_partition_reset);
+    sched_reset_partitions(cpu);
 
-    sched_need_recheck = 0; // Acquire semantic
+    cpu->need_recheck = 0; // Acquire semantic
     barrier();
 
-    // Navigate to the first slot
-    pok_sched_current_slot = 0;
-    pok_sched_next_major_frame = first_frame_starts + pok_config_scheduling_major_frame;
-    pok_sched_next_deadline = pok_module_sched[0].duration + first_frame_starts;
+    now = jet_system_time();
+
+    if(frame_start <= now)
+    {
+        // Navigate to the first slot
+        cpu->current_slot = 0;
+        cpu->next_major_frame = frame_start + pok_config_scheduling_major_frame;
+        cpu->next_deadline = cpu->slots[0].duration + frame_start;
+
+        part = cpu->slots[0].partition;
+    }
+    else
+    {
+        // As if the last slot of the previous frame is executed.
+        cpu->current_slot = cpu->slots_n - 1;
+        cpu->next_major_frame = frame_start;
+        cpu->next_deadline = frame_start;
+
+        part = &partition_idle_cpus[ja_cpu_id()];
+        part->sp = NULL;
+    }
+
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_switch(current_partition, part, now);
+#endif
+#ifdef POK_NEEDS_PERF_COUNTERS
+    jet_perf_switch(current_partition, part);
+#endif
 
-    current_partition = pok_module_sched[0].partition;
+    current_partition = part;
+    jet_fp_on_switch();
 
-    new_sp = &current_partition->sp;
+    part->cpu_account_start = now;
+    part->cpu_account.n_activations++;
+
+    new_sp = &part->sp;
 #ifdef POK_NEEDS_MONITOR
-    if(current_partition->is_paused) new_sp = &idle_sp;
-    current_partition_is_paused = current_partition->is_paused;
+    if(partition_is_held(part)) new_sp = &cpu->idle_sp;
+    cpu->current_partition_is_paused = partition_is_held(part);
 #endif /*POK_NEEDS_MONITOR */
     if(*new_sp == 0)
     {
-        *new_sp = jet_context_init(current_partition->initial_sp,
+        *new_sp = jet_context_init(part->initial_sp,
             &start_partition);
     }
 
-    if(current_partition->space_id != 0xff)
-        pok_space_switch(current_partition->space_id);
+    if(part->space_id != 0xff)
+        pok_space_switch(part->space_id);
     else
         pok_space_switch(0xff); // TODO: This should disable all user space tables
 
     kernel_state = POK_SYSTEM_STATE_OS_PART;
 
+#ifdef POK_NEEDS_TICKLESS
+    sched_program_timer(part);
+#endif
+
     jet_context_jump(*new_sp);
 }
 
+void pok_sched_restart (void)
+{
+#ifdef POK_NEEDS_SMP
+    /*
+     * Other CPUs continue their schedules. For keep major frames
+     * synchronized, restart at the beginning of the next one.
+     */
+    pok_time_t n_frames = (jet_system_time() - first_frame_starts)
+        / pok_config_scheduling_major_frame + 1;
+
+    sched_start_frame(first_frame_starts
+        + n_frames * pok_config_scheduling_major_frame);
+#else
+    first_frame_starts = jet_system_time();
+
+    sched_start_frame(first_frame_starts);
+#endif
+}
+
+#ifdef POK_NEEDS_SMP
+/* Set by the boot CPU when first_frame_starts is assigned. */
+static pok_bool_t sched_started;
+#endif
+
 void pok_sched_start (void)
 {
-#ifdef POK_NEEDS_MONITOR
-    idle_stack = pok_stack_alloc(KERNEL_STACK_SIZE_DEFAULT);
-#endif /*POK_NEEDS_MONITOR */
+    if(sched_cpu()->slots_n == 0)
+    {
+        // CPU is not used by the schedule.
+        ja_inf_loop();
+    }
+
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_init();
+#endif
+#ifdef POK_NEEDS_PERF_COUNTERS
+    jet_perf_init();
+#endif
+
+#ifdef POK_NEEDS_SMP
+    if(ja_cpu_id() == 0)
+    {
+        first_frame_starts = jet_system_time();
+        flag_set(sched_started);
+    }
+    else
+    {
+        while(!ACCESS_ONCE(sched_started));
+        barrier();
+    }
+
+    sched_start_frame(first_frame_starts);
+#else
     pok_sched_restart();
+#endif
 }
 
 /* Static variables used to trace with qemu */
@@ -285,21 +538,22 @@ static int nb_major_time_frame = 0;
  */
 static void pok_sched(void)
 {
+    struct sched_cpu* cpu = sched_cpu();
     pok_partition_t* part = current_partition;
     pok_partition_t* new_partition;
     pok_time_t now;
 
-    if(!flag_test_and_reset(sched_need_recheck)) return;
+    if(!flag_test_and_reset(cpu->need_recheck)) return;
 
     now = jet_system_time();
 
-    if(pok_sched_next_deadline > now) goto same_partition;
+    if(cpu->next_deadline > now) goto same_partition;
 
-    pok_sched_current_slot = (pok_sched_current_slot + 1);
-    if(pok_sched_current_slot == pok_module_sched_n)
+    cpu->current_slot = (cpu->current_slot + 1);
+    if(cpu->current_slot == cpu->slots_n)
     {
-        pok_sched_next_major_frame += pok_config_scheduling_major_frame;
-        pok_sched_current_slot = 0;
+        cpu->next_major_frame += pok_config_scheduling_major_frame;
+        cpu->current_slot = 0;
 
         /********Added code for qemu trace ************/
 #if QEMU_TRACING
@@ -317,12 +571,31 @@ static void pok_sched(void)
 #endif /* QEMU_TRACING */
         /*********************************************/
     }
-    pok_sched_next_deadline += pok_module_sched[pok_sched_current_slot].duration;
+    /*
+     * Slot end is computed from the frame start and precalculated offset,
+     * so rounding errors (if any) in durations are not accumulated.
+     */
+    cpu->next_deadline = sched_current_frame_start(cpu)
+        + cpu->slots[cpu->current_slot].offset
+        + cpu->slots[cpu->current_slot].duration;
 
-    new_partition = pok_module_sched[pok_sched_current_slot].partition;
+    new_partition = cpu->slots[cpu->current_slot].partition;
 
     if(new_partition == part) goto same_partition;
 
+    sched_account_switch(cpu, part, new_partition, now);
+
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_switch(part, new_partition, now);
+#endif
+
+    jet_trace(JET_TRACE_CLASS_SWITCH, JET_TRACE_EVENT_PARTITION_SWITCH,
+        JET_TRACE_THREAD_NONE, new_partition->partition_id);
+
+#ifdef POK_NEEDS_TICKLESS
+    sched_program_timer(new_partition);
+#endif
+
     inter_partition_switch(new_partition);
 
     /*
@@ -339,6 +612,12 @@ static void pok_sched(void)
     return;
 
 same_partition:
+#ifdef POK_NEEDS_MEMGUARD
+    jet_memguard_update(part, now);
+#endif
+#ifdef POK_NEEDS_TICKLESS
+    sched_program_timer(part);
+#endif
     intra_partition_switch();
 }
 
@@ -388,38 +667,22 @@ void __pok_preemption_enable(void)
 
 
 /*
- * Forward implementation, which iterates over all slots.
+ * Use offset precalculated by the configurator for the current slot.
  *
- * May be optimized in the future.
+ * Note that we ignore current activation of _this_ slot: e.g. if we're
+ * currently in periodic processing window, and it's the only one in
+ * schedule, next one will be major frame time units later.
  */
 pok_time_t get_next_periodic_processing_start(void)
 {
-    int i;
-
-    pok_time_t offset = pok_sched_next_deadline;
+    struct sched_cpu* cpu = sched_cpu();
+    const pok_sched_slot_t *slot = &cpu->slots[cpu->current_slot];
 
-    // check all time slots
-    // note that we ignore current activation of _this_ slot
-    // e.g. if we're currently in periodic processing window,
-    // and it's the only one in schedule, we say that next one
-    // will be major frame time units later
-    int time_slot_index = pok_sched_current_slot;
-
-    for (i = 0; i < pok_module_sched_n; i++) {
-
-        time_slot_index++;
-        if(time_slot_index == pok_module_sched_n) time_slot_index = 0;
-
-        const pok_sched_slot_t *slot = &pok_module_sched[time_slot_index];
-
-        if (slot->periodic_processing_start && slot->partition == current_partition) {
-            return offset;
-        }
+    // Partition is executed only within its own slot.
+    assert(slot->partition == current_partition);
+    assert(slot->next_pps_offset > slot->offset && "Couldn't find next periodic processing window (configurator shouldn't have allowed that)");
 
-        offset += slot->duration;
-    }
-
-    assert(FALSE && "Couldn't find next periodic processing window (configurator shouldn't have allowed that)");
+    return sched_current_frame_start(cpu) + slot->next_pps_offset;
 }
 
 void pok_sched_on_time_changed(void)
@@ -427,7 +690,7 @@ void pok_sched_on_time_changed(void)
     assert(!ja_preempt_enabled());
 
     pok_partition_t* part = current_partition;
-    sched_need_recheck = TRUE;
+    sched_cpu()->need_recheck = TRUE;
 
 #if POK_NEEDS_GDB
     pok_bool_t in_user_space = pok_in_user_space;
@@ -440,7 +703,9 @@ void pok_sched_on_time_changed(void)
 #endif /* POK_NEEDS_GDB */
     pok_sched();
 
-    if(current_partition_is_paused) goto out;
+#ifdef POK_NEEDS_MONITOR
+    if(sched_cpu()->current_partition_is_paused) goto out;
+#endif
 
     pok_bool_t preempt_local_disabled_old = current_partition->preempt_local_disabled;
 
@@ -450,6 +715,10 @@ void pok_sched_on_time_changed(void)
     {
         pok_partition_add_event(part, JET_PARTITION_EVENT_TYPE_TIMER, 0);
         part->timer = 0;
+#ifdef POK_NEEDS_TICKLESS
+        // Expired timer shouldn't trigger interrupt again.
+        sched_program_timer(part);
+#endif
     }
 
     if(preempt_local_disabled_old || !part->is_event) goto out;
@@ -505,34 +774,29 @@ void pok_partition_return_user(void)
 
     assert(part->fp_store_current);
 
-    if(fp_store_last != part->fp_store_current)
-    {
-        if(fp_store_last)
-        {
-            ja_fp_save(fp_store_last);
-        }
-
-        fp_store_last = part->fp_store_current;
-        ja_fp_restore(fp_store_last);
-    }
+    // FP registers are switched lazily, see jet_fp_unavailable().
 }
 
 void pok_partition_jump_user(void (* __user entry)(void),
     jet_ustack_t stack_user,
     jet_stack_t stack_kernel)
 {
+    struct sched_cpu* cpu = sched_cpu();
     pok_partition_t* part = current_partition;
 
     pok_partition_return_user_common();
 
     assert(part->fp_store_current);
 
-    if(fp_store_last && fp_store_last != part->fp_store_current)
+    // Registers are accessed below.
+    ja_fp_enable();
+
+    if(cpu->fp_store_last && cpu->fp_store_last != part->fp_store_current)
     {
-        ja_fp_save(fp_store_last);
+        ja_fp_save(cpu->fp_store_last);
     }
 
-    fp_store_last = part->fp_store_current;
+    cpu->fp_store_last = part->fp_store_current;
     ja_fp_init();
 
     jet_user_space_jump(
@@ -555,7 +819,7 @@ void pok_partition_restart(void)
     if(part->partition_generation == 0) part->partition_generation = 1;
 
     part->sp = 0;
-    sched_need_recheck = TRUE;
+    sched_cpu()->need_recheck = TRUE;
 
     pok_preemption_enable();
 
@@ -565,6 +829,25 @@ void pok_partition_restart(void)
 
 void pok_sched_init(void)
 {
-    pok_partition_init(&partition_idle);
-    partition_idle.initial_sp = pok_stack_alloc(4096);
+    if(pok_module_sched_cpus_n > POK_CONFIG_NB_CPUS)
+        pok_fatal("Schedule uses more CPUs than the kernel is built for");
+
+    for(int i = 0; i < POK_CONFIG_NB_CPUS; i++)
+    {
+        struct sched_cpu* cpu = &sched_cpus[i];
+        pok_partition_t* idle = &partition_idle_cpus[i];
+
+        if(i < pok_module_sched_cpus_n)
+        {
+            cpu->slots = &pok_module_sched[pok_module_sched_cpus[i].first];
+            cpu->slots_n = pok_module_sched_cpus[i].n;
+        }
+
+        pok_partition_init(idle);
+        idle->initial_sp = pok_stack_alloc(4096);
+
+#ifdef POK_NEEDS_MONITOR
+        cpu->idle_stack = pok_stack_alloc(KERNEL_STACK_SIZE_DEFAULT);
+#endif /*POK_NEEDS_MONITOR */
+    }
 }
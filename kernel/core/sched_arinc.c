@@ -23,6 +23,7 @@
 #include <asp/arch.h>
 #include <core/syscall.h>
 #include <core/uaccess.h>
+#include <core/trace.h>
 
 static void thread_start_func(void)
 {
@@ -55,47 +56,13 @@ void sched_arinc_start(void)
 
 	// Direct jump into main thread.
     part->base_part.fp_store_current = thread_main->fp_store;
+    jet_fp_on_switch();
 
 	jet_context_restart_and_save(thread_main->initial_sp,
         &thread_start_func, &thread_main->sp);
 }
 
 
-/* Notification is received for given queuing port. */
-static void port_queuing_fired(pok_port_queuing_t* port_queuing)
-{
-    if(port_queuing->direction == POK_PORT_DIRECTION_IN)
-    {
-        while(!pok_thread_wq_is_empty(&port_queuing->waiters))
-        {
-            pok_thread_t* t;
-            pok_message_size_t message_size; // Just for function's call.
-
-            if(!pok_channel_queuing_r_get_message(port_queuing->channel,
-                &message_size, TRUE))
-                break; // wait again
-
-            t = pok_thread_wq_wake_up(&port_queuing->waiters);
-
-            port_queuing_receive(port_queuing, t);
-        }
-    }
-    else // if(port_queuing->direction == POK_PORT_DIRECTION_OUT)
-    {
-        while(!pok_thread_wq_is_empty(&port_queuing->waiters))
-        {
-            pok_thread_t* t;
-
-            if(!pok_channel_queuing_s_get_message(port_queuing->channel, TRUE))
-                break; // wait again
-
-            t = pok_thread_wq_wake_up(&port_queuing->waiters);
-
-            port_queuing_send(port_queuing, t);
-        }
-    }
-}
-
 /*
  * Function which is executed in kernel-only partition's context when
  * no threads can be executed at this moment.
@@ -175,6 +142,46 @@ static pok_thread_t* select_thread(pok_thread_t* selected_thread)
     return new_thread;
 }
 
+/* Return CPU time consumed by the current partition. */
+static pok_time_t partition_cpu_time_current(void)
+{
+    pok_time_t cpu_time;
+    pok_bool_t preempt_enabled = ja_preempt_enabled();
+
+    // Global scheduler may update partition's accounting.
+    if(preempt_enabled) ja_preempt_disable();
+    cpu_time = pok_partition_cpu_time(current_partition, jet_system_time());
+    if(preempt_enabled) ja_preempt_enable();
+
+    return cpu_time;
+}
+
+/*
+ * Account CPU time of the threads on switch between them.
+ *
+ * Time is measured in CPU time of the partition, so the time when
+ * other partitions are executed is not counted.
+ */
+static void thread_account_switch(pok_thread_t* old_thread,
+    pok_thread_t* new_thread)
+{
+    pok_time_t cpu_time = partition_cpu_time_current();
+
+    if(old_thread)
+    {
+        old_thread->cpu_account.consumed_time +=
+            cpu_time - old_thread->cpu_account_start;
+        if(old_thread->state == POK_STATE_RUNNABLE && !old_thread->suspended)
+            old_thread->cpu_account.n_preemptions++;
+    }
+
+    if(new_thread)
+    {
+        new_thread->cpu_account_start = cpu_time;
+        new_thread->cpu_account.n_activations++;
+    }
+}
+
 // Called with local preemption disabled.
 static void sched_arinc(void)
 {
@@ -183,20 +190,22 @@ static void sched_arinc(void)
 again:
     if(flag_test_and_reset(part->base_part.is_event))
     {
-        struct jet_partition_event event;
+        uint16_t words = pok_partition_events_words(&part->base_part);
+
+        if(pok_partition_take_timer_event())
+            delayed_event_queue_check(&part->partition_delayed_events, jet_system_time());
 
-        while(pok_partition_get_event(&event))
+        // Every port with pending events is processed once.
+        for(uint16_t word = 0; word < words; word++)
         {
-            switch(event.event_type) {
-                case JET_PARTITION_EVENT_TYPE_TIMER:
-                    delayed_event_queue_check(&part->partition_delayed_events, jet_system_time());
-                    break;
-                case JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE:
-                case JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE:
-                    port_queuing_fired(&part->ports_queuing[event.handler_id]);
-                    break;
-                default:
-                    unreachable();
+            uint32_t pending = pok_partition_take_events(word);
+
+            while(pending)
+            {
+                int bit = __builtin_ctz(pending);
+                pending &= pending - 1;
+
+                port_queuing_fired(&part->ports_queuing[word * 32 + bit]);
             }
         }
     }
@@ -271,9 +280,9 @@ again:
     {
         new_thread = part->thread_locked;
     }
-    else if(!list_empty(&part->eligible_threads))
+    else if(!jet_ready_queue_is_empty(&part->eligible_threads))
     {
-        new_thread = list_first_entry(&part->eligible_threads,
+        new_thread = list_entry(jet_ready_queue_first(&part->eligible_threads),
             pok_thread_t, eligible_elem);
     }
     else
@@ -306,6 +315,11 @@ again:
     }
 
     // Switch between different threads
+    thread_account_switch(old_thread, new_thread);
+
+    jet_trace(JET_TRACE_CLASS_SWITCH, JET_TRACE_EVENT_THREAD_SWITCH,
+        JET_TRACE_THREAD(new_thread), JET_TRACE_THREAD(old_thread));
+
     part->thread_current = new_thread;
     // Update kernel shared data
     if(new_thread)
@@ -353,7 +367,8 @@ again:
         part->base_part.entry_sp_user = NULL;
     }
 #endif /* POK_NEEDS_GDB */
-    part->base_part.fp_store_current = new_thread->fp_store;
+    part->base_part.fp_store_current = new_thread ? new_thread->fp_store : NULL;
+    jet_fp_on_switch();
 
     if(old_sp)
     {
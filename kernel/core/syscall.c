@@ -35,6 +35,9 @@
 
 #include <cons.h>
 #include <core/port.h>
+#include <core/trace.h>
+#include <asp/cpu.h>
+#include <assert.h>
 
 /* Call given function without protection(with enabled interrupts). */
 static pok_ret_t unprotected_syscall(
@@ -48,7 +51,113 @@ static pok_ret_t unprotected_syscall(
    return ret;
 }
 
-#define SYSCALL_ENTRY(id) case id: return unprotected_syscall(pok_syscall_wrapper_ ## id, args); break;
+/* Dense indices of syscalls from the map. */
+enum {
+#define POK_SYSCALL_TABLE_ENTRY(id, nargs) JET_SYSCALL_INDEX_ ## id,
+#include <uapi/syscall_map_arinc.h>
+#undef POK_SYSCALL_TABLE_ENTRY
+   JET_SYSCALLS_N
+};
+
+const struct jet_syscall jet_syscalls[JET_SYSCALLS_N] = {
+#define POK_SYSCALL_TABLE_ENTRY(syscall_id, n) \
+   [JET_SYSCALL_INDEX_ ## syscall_id] = { \
+      .func = pok_syscall_wrapper_ ## syscall_id, \
+      .name = #syscall_id + sizeof("POK_SYSCALL_") - 1, \
+      .id = syscall_id, \
+      .nargs = n, \
+   },
+#include <uapi/syscall_map_arinc.h>
+#undef POK_SYSCALL_TABLE_ENTRY
+};
+
+const uint16_t jet_syscalls_n = JET_SYSCALLS_N;
+
+/*
+ * Map from syscall id to (index + 1) in jet_syscalls.
+ *
+ * 0 means that syscall is not declared in the map.
+ */
+static const uint8_t syscall_index[] = {
+#define POK_SYSCALL_TABLE_ENTRY(id, nargs) [id] = JET_SYSCALL_INDEX_ ## id + 1,
+#include <uapi/syscall_map_arinc.h>
+#undef POK_SYSCALL_TABLE_ENTRY
+};
+
+// Index is stored as uint8_t.
+typedef char syscall_index_check[(JET_SYSCALLS_N < 255) ? 1 : -1];
+
+/* Return syscall from the map with given id, or NULL. */
+static inline const struct jet_syscall* syscall_find(pok_syscall_id_t syscall_id)
+{
+   uint8_t index;
+
+   if((unsigned)syscall_id >= sizeof(syscall_index) / sizeof(syscall_index[0]))
+      return NULL;
+
+   index = syscall_index[syscall_id];
+
+   return index ? &jet_syscalls[index - 1] : NULL;
+}
+
+#ifdef POK_NEEDS_SYSCALL_STATS
+
+static struct jet_syscall_stats syscall_stats[POK_CONFIG_NB_CPUS][JET_SYSCALLS_N];
+
+/*
+ * Account call of the syscall.
+ *
+ * Called with preemption disabled, so statistic of the current CPU
+ * may be modified without locks.
+ */
+static void syscall_stats_account(const struct jet_syscall* syscall,
+   pok_time_t latency)
+{
+   struct jet_syscall_stats* stats =
+      &syscall_stats[ja_cpu_id()][syscall - jet_syscalls];
+   int bucket;
+
+   if(latency > 0xffffffff)
+      bucket = JET_SYSCALL_STATS_BUCKETS - 1;
+   else if(latency == 0)
+      bucket = 0;
+   else
+      bucket = 31 - __builtin_clz((uint32_t)latency);
+
+   if(bucket >= JET_SYSCALL_STATS_BUCKETS)
+      bucket = JET_SYSCALL_STATS_BUCKETS - 1;
+
+   stats->n_calls++;
+   stats->latency_hist[bucket]++;
+   if(latency > stats->max_latency)
+      stats->max_latency = latency;
+}
+
+void jet_syscall_stats_get(uint16_t index, struct jet_syscall_stats* stats)
+{
+   assert(index < JET_SYSCALLS_N);
+
+   memset(stats, 0, sizeof(*stats));
+
+   for(int cpu = 0; cpu < POK_CONFIG_NB_CPUS; cpu++)
+   {
+      const struct jet_syscall_stats* cpu_stats = &syscall_stats[cpu][index];
+
+      stats->n_calls += cpu_stats->n_calls;
+      if(cpu_stats->max_latency > stats->max_latency)
+         stats->max_latency = cpu_stats->max_latency;
+
+      for(int i = 0; i < JET_SYSCALL_STATS_BUCKETS; i++)
+         stats->latency_hist[i] += cpu_stats->latency_hist[i];
+   }
+}
+
+void jet_syscall_stats_reset(void)
+{
+   memset(syscall_stats, 0, sizeof(syscall_stats));
+}
+
+#endif /* POK_NEEDS_SYSCALL_STATS */
 
 /**
  * \file kernel/core/syscalls.c
@@ -56,6 +165,7 @@ static pok_ret_t unprotected_syscall(
  * \author Julien Delange
  */
 
+/* Syscalls, not declared in the map. Executed with preemption disabled. */
 static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t       syscall_id,
                             const pok_syscall_args_t*    args,
                             const pok_syscall_info_t*    infos)
@@ -76,76 +186,6 @@ static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t
       case POK_SYSCALL_TIME:
          return jet_time((time_t*)args->arg1);
 
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_CREATE)
-
-#ifdef POK_NEEDS_THREAD_SLEEP
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SLEEP)
-#endif
-
-#ifdef POK_NEEDS_THREAD_SLEEP_UNTIL
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SLEEP_UNTIL)
-#endif
-
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_PERIOD)
-
-#if defined (POK_NEEDS_THREAD_SUSPEND) || defined (POK_NEEDS_ERROR_HANDLING)
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SUSPEND)
-#endif
-
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_DELAYED_START)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_SET_PRIORITY)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_RESUME)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_SUSPEND_TARGET)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_YIELD)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_REPLENISH)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STOP)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STOPSELF)
-
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_FIND)
-
-   SYSCALL_ENTRY(POK_SYSCALL_RESCHED)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_ENTER_HELPER)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WAIT)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_NOTIFY)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WQ_NOTIFY)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WQ_SIZE)
-
-#ifdef POK_NEEDS_PARTITIONS
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_SET_MODE)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_GET_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_INC_LOCK_LEVEL)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL)
-#endif
-
-#ifdef POK_NEEDS_ERROR_HANDLING
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_HANDLER_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_RAISE_APPLICATION_ERROR)
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_GET)
-#endif
-
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_RAISE_OS_ERROR)
-
-   /* Middleware syscalls */
-#ifdef POK_NEEDS_PORTS_SAMPLING
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_WRITE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_READ)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_ID)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK)
-#endif /* POK_NEEDS_PORTS_SAMPLING */
-
-
-#ifdef POK_NEEDS_PORTS_QUEUEING
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_ID)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR)
-#endif /* POK_NEEDS_PORTS_QUEUEING */
-
 #ifdef POK_NEEDS_IO
       case POK_SYSCALL_INB:
          if ((args->arg1 < pok_partitions[infos->partition].io_min) ||
@@ -185,8 +225,6 @@ static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t
          return pok_bsp_get_info((void* __user)args->arg1);
          break;
 
-      SYSCALL_ENTRY(POK_SYSCALL_MEMORY_BLOCK_GET_STATUS)
-
       default:
        /*
         * Unrecognized system call ID.
@@ -206,12 +244,33 @@ pok_ret_t pok_core_syscall (const pok_syscall_id_t       syscall_id,
                             const pok_syscall_info_t*    infos)
 {
     pok_ret_t ret;
+    const struct jet_syscall* syscall;
 #ifdef POK_NEEDS_GDB
     current_partition->entry_sp_user = global_thread_stack;
     pok_in_user_space = FALSE;
 #endif
 
-    ret = pok_core_syscall_internal(syscall_id, args, infos);
+    jet_trace(JET_TRACE_CLASS_SYSCALL, JET_TRACE_EVENT_SYSCALL_ENTER,
+        JET_TRACE_THREAD(current_thread), syscall_id);
+
+    syscall = syscall_find(syscall_id);
+    if(syscall)
+    {
+#ifdef POK_NEEDS_SYSCALL_STATS
+        pok_time_t start = jet_system_time();
+#endif
+        ret = unprotected_syscall(syscall->func, args);
+#ifdef POK_NEEDS_SYSCALL_STATS
+        syscall_stats_account(syscall, jet_system_time() - start);
+#endif
+    }
+    else
+    {
+        ret = pok_core_syscall_internal(syscall_id, args, infos);
+    }
+
+    jet_trace(JET_TRACE_CLASS_SYSCALL, JET_TRACE_EVENT_SYSCALL_EXIT,
+        JET_TRACE_THREAD(current_thread), ret);
 
 #if POK_NEEDS_GDB
     pok_in_user_space = TRUE;
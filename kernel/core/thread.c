@@ -25,8 +25,6 @@
 #include <core/time.h>
 #include <libc.h>
 
-#include <core/instrumentation.h>
-
 #include "thread_internal.h"
 #include <core/uaccess.h>
 
@@ -379,6 +377,35 @@ pok_ret_t pok_thread_get_status (pok_thread_id_t id,
 	return POK_ERRNO_OK;
 }
 
+void pok_thread_cpu_account_get(pok_partition_arinc_t* part,
+    pok_thread_t* t, jet_cpu_account_t* account)
+{
+    *account = t->cpu_account;
+
+    if(t == part->thread_current)
+    {
+        pok_time_t cpu_time = pok_partition_cpu_time(&part->base_part,
+            jet_system_time());
+        account->consumed_time += cpu_time - t->cpu_account_start;
+    }
+}
+
+pok_ret_t pok_thread_get_cpu_account(pok_thread_id_t id,
+    jet_cpu_account_t* __user account)
+{
+    pok_thread_t *t = get_thread_by_id(id);
+    if(!t) return POK_ERRNO_PARAM;
+
+    jet_cpu_account_t* __kuser k_account = jet_user_to_kernel_typed(account);
+    if(!k_account) return POK_ERRNO_EFAULT;
+
+    pok_preemption_disable();
+    pok_thread_cpu_account_get(current_partition_arinc, t, k_account);
+    __pok_preemption_enable();
+
+    return POK_ERRNO_OK;
+}
+
 pok_ret_t pok_thread_set_priority(pok_thread_id_t id, uint32_t priority)
 {
     pok_partition_arinc_t* part = current_partition_arinc;
@@ -668,6 +695,11 @@ pok_ret_t pok_sched_end_period(void)
 
     pok_preemption_local_disable();
 
+    // Response time of the current activation.
+    pok_time_t response_time = jet_system_time() - t->next_activation;
+    if(response_time > t->cpu_account.max_response_time)
+        t->cpu_account.max_response_time = response_time;
+
     t->next_activation += t->period;
 	thread_wait_timed(t, t->next_activation);
 	thread_set_deadline(t, t->next_activation + t->time_capacity);
@@ -33,6 +33,8 @@ pok_bool_t thread_create(pok_thread_t* t)
     tshd_t->msection_count = 0;
     tshd_t->msection_entering = NULL;
 
+    memset(&t->cpu_account, 0, sizeof(t->cpu_account));
+
     /*
      * Do not modify stack here: it will be filled when thread will run.
      */
@@ -80,27 +82,16 @@ static pok_bool_t thread_is_eligible(pok_thread_t* t)
  */
 static void thread_set_eligible(pok_thread_t* t)
 {
-    pok_thread_t* other_thread;
     pok_partition_arinc_t* part = current_partition_arinc;
 
     assert(part->mode == POK_PARTITION_MODE_NORMAL);
     assert(!thread_is_eligible(t));
 
-    list_for_each_entry(other_thread,
-        &part->eligible_threads,
-        eligible_elem)
-    {
-        if(other_thread->priority < t->priority)
-        {
-            list_add_tail(&t->eligible_elem, &other_thread->eligible_elem);
-            goto out;
-        }
+    t->eligible_priority = t->priority;
+    jet_ready_queue_add(&part->eligible_threads, &t->eligible_elem,
+        t->eligible_priority);
 
-    }
-    list_add_tail(&t->eligible_elem, &part->eligible_threads);
-
-out:
-    if(t->eligible_elem.prev == &part->eligible_threads)
+    if(jet_ready_queue_is_first(&part->eligible_threads, &t->eligible_elem))
     {
         // Thread is inserted into the first position.
         pok_sched_local_invalidate();
@@ -112,13 +103,13 @@ void thread_yield(pok_thread_t *t)
     pok_partition_arinc_t* part = current_partition_arinc;
     if(thread_is_eligible(t))
     {
-        // TODO: Improve performance
-        if(t->eligible_elem.prev == &part->eligible_threads)
+        if(jet_ready_queue_is_first(&part->eligible_threads, &t->eligible_elem))
         {
             // Thread is removed from the first position.
             pok_sched_local_invalidate();
         }
-        list_del_init(&t->eligible_elem);
+        jet_ready_queue_del(&part->eligible_threads, &t->eligible_elem,
+            t->eligible_priority);
         thread_set_eligible(t);
     }
 }
@@ -131,14 +122,15 @@ void thread_yield(pok_thread_t *t)
 static void thread_set_uneligible(pok_thread_t* t)
 {
     pok_partition_arinc_t* part = current_partition_arinc;
-    if(!list_empty(&t->eligible_elem))
+    if(thread_is_eligible(t))
     {
-        if(t->eligible_elem.prev == &part->eligible_threads)
+        if(jet_ready_queue_is_first(&part->eligible_threads, &t->eligible_elem))
         {
             // Thread is removed from the first position.
             pok_sched_local_invalidate();
         }
-	list_del_init(&t->eligible_elem);
+        jet_ready_queue_del(&part->eligible_threads, &t->eligible_elem,
+            t->eligible_priority);
     }
 }
 
@@ -21,14 +21,55 @@
 #include <core/time.h>
 #include <core/uaccess.h>
 #include <core/sched.h>
+#include <core/trace.h>
 
 #include <asp/entries.h> /* jet_on_tick() declaration. */
+#include <assert.h>
+#include <compiler.h>
+#include <uapi/kernel_shared_data.h>
 
 void jet_on_tick(void)
 {
+    jet_trace(JET_TRACE_CLASS_TIMER, JET_TRACE_EVENT_TIMER,
+        JET_TRACE_THREAD_NONE, 0);
+
     pok_sched_on_time_changed();
 }
 
+void jet_time_scale_init(struct jet_time_scale* scale,
+    uint64_t from_freq, uint32_t to_freq)
+{
+    uint32_t shift = 32;
+    uint64_t mult;
+
+    assert(from_freq != 0);
+
+    // Use the largest shift for which multiplier fits into 32 bits.
+    while(1)
+    {
+        // Round up, so converted value is never less than exact one.
+        mult = (((uint64_t)to_freq << shift) + from_freq - 1) / from_freq;
+        if(mult <= UINT32_MAX || shift == 0) break;
+        shift--;
+    }
+
+    assert(mult <= UINT32_MAX);
+
+    scale->mult = (uint32_t)mult;
+    scale->shift = shift;
+}
+
+void jet_time_page_fill(struct jet_time_page* page)
+{
+    page->seq |= 1;
+    barrier();
+
+    page->valid = ja_system_time_params(&page->counter_base, &page->scale);
+
+    barrier();
+    page->seq++;
+}
+
 #ifdef POK_NEEDS_GETTICK
 /**
  * Get the current ticks value, store it in
@@ -0,0 +1,77 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifdef POK_NEEDS_TRACE
+
+#include <core/trace.h>
+#include <core/partition.h>
+#include <asp/arch.h>
+#include <asp/cpu.h>
+#include <asp/time.h>
+
+#if (POK_TRACE_RING_SIZE & (POK_TRACE_RING_SIZE - 1)) != 0
+#error POK_TRACE_RING_SIZE should be power of 2
+#endif
+
+struct jet_trace_ring jet_trace_rings[POK_CONFIG_NB_CPUS];
+
+void jet_trace_init(void)
+{
+    int i;
+
+    for(i = 0; i < POK_CONFIG_NB_CPUS; i++)
+    {
+        struct jet_trace_ring* ring = &jet_trace_rings[i];
+
+        ring->magic = JET_TRACE_MAGIC;
+        ring->version = JET_TRACE_VERSION;
+        ring->cpu = i;
+        ring->n_events = POK_TRACE_RING_SIZE;
+        ring->head = 0;
+        // Return value is not interesting: dump is read by the debugger.
+        (void)ja_system_time_params(&ring->counter_base, &ring->scale);
+    }
+}
+
+void jet_trace_emit(uint8_t event_id, uint8_t thread, uint32_t arg)
+{
+    struct jet_trace_ring* ring;
+    struct jet_trace_event* event;
+    pok_bool_t enabled = ja_preempt_enabled();
+
+    /*
+     * Ring is written only by its own CPU, so disabling interrupts
+     * is sufficient for reserve a slot.
+     */
+    if(enabled) ja_preempt_disable();
+
+    ring = &jet_trace_rings[ja_cpu_id()];
+
+    event = &ring->events[ring->head & (POK_TRACE_RING_SIZE - 1)];
+    ring->head++;
+
+    event->counter = ja_time_counter();
+    event->event_id = event_id;
+    event->partition = current_partition ? current_partition->partition_id : 0xff;
+    event->thread = thread;
+    event->reserved = 0;
+    event->arg = arg;
+
+    if(enabled) ja_preempt_enable();
+}
+
+#endif /* POK_NEEDS_TRACE */
@@ -0,0 +1,57 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/* Processors of the module. */
+
+#ifndef __JET_ASP_CPU_H__
+#define __JET_ASP_CPU_H__
+
+#include <config.h>
+#include <types.h>
+
+#ifdef POK_NEEDS_SMP
+
+/*
+ * Arch header should define:
+ *
+ * unsigned int ja_cpu_id(void) - index of the current CPU.
+ *   0 is the boot CPU, others are 1 .. POK_CONFIG_NB_CPUS-1.
+ *   Fast, may be used on every access to per-CPU data.
+ */
+#include <arch/cpu.h>
+
+/*
+ * Start secondary CPUs.
+ *
+ * Every secondary CPU initializes its own arch-specific state and calls
+ * jet_boot_secondary().
+ *
+ * Returns when all POK_CONFIG_NB_CPUS processors are started.
+ *
+ * Should be called by the boot CPU when the kernel is initialized,
+ * but before the scheduler is started.
+ */
+void ja_cpu_start_secondary(void);
+
+#else /* POK_NEEDS_SMP */
+
+static inline unsigned int ja_cpu_id(void)
+{
+    return 0;
+}
+
+#endif /* POK_NEEDS_SMP */
+
+#endif /* __JET_ASP_CPU_H__ */
@@ -24,6 +24,8 @@
 #ifndef __JET_ASP_ENTRIES_H__
 #define __JET_ASP_ENTRIES_H__
 
+#include <types.h>
+
 /**
  * Starts the kernel.
  *
@@ -32,6 +34,14 @@
  */
 void jet_boot(void);
 
+/*
+ * Starts the kernel on the secondary CPU (POK_NEEDS_SMP).
+ *
+ * Should be called by every secondary CPU, started by
+ * ja_cpu_start_secondary(), when its arch-specific state is initialized.
+ */
+void jet_boot_secondary(void);
+
 /* 
  * Initialize main and debug consoles with their default values (provided by arch).
  * 
@@ -44,5 +54,25 @@ void jet_console_init_all(void);
 /* Should be called on timer tick with interrupts disabled. */
 void jet_on_tick(void);
 
+/*
+ * Should be called on floating point operation forbidden by
+ * ja_fp_disable(), with interrupts disabled.
+ *
+ * Switch FP registers to the current thread and allow operations.
+ *
+ * Return FALSE if current context doesn't own FP registers at all
+ * (kernel partition). Then the trap should be processed as error.
+ */
+pok_bool_t jet_fp_unavailable(void);
+
+/*
+ * Should be called on overflow of the counter, started with
+ * ja_memguard_start(), with interrupts disabled (POK_NEEDS_MEMGUARD).
+ *
+ * Throttle the current partition if its budget is exhausted.
+ * Spurious calls (e.g., for already stopped counter) are ignored.
+ */
+void jet_memguard_overflow(void);
+
 
 #endif /* __JET_ASP_ENTRIES_H__ */
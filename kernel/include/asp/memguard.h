@@ -0,0 +1,60 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Counter of memory accesses for regulation of memory bandwidth
+ * (POK_NEEDS_MEMGUARD, see core/memguard.h).
+ *
+ * Every CPU has its own counter. Events counted are arch-specific:
+ * last level cache misses where the processor can count them.
+ *
+ * When counter started with ja_memguard_start() overflows,
+ * jet_memguard_overflow() should be called (see asp/entries.h).
+ */
+
+#ifndef __JET_ASP_MEMGUARD_H__
+#define __JET_ASP_MEMGUARD_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_MEMGUARD
+
+#include <types.h>
+
+/*
+ * Initialize counter on the current CPU.
+ *
+ * Return FALSE if the processor has no suitable counter.
+ */
+pok_bool_t ja_memguard_init(void);
+
+/*
+ * Start counting from 0.
+ *
+ * Overflow should be signalled after 'limit' events. 'limit' is never 0.
+ */
+void ja_memguard_start(uint32_t limit);
+
+/*
+ * Stop counting.
+ *
+ * Return number of events since ja_memguard_start(). Any overflow
+ * signal which is pending for the counter may be lost.
+ */
+uint32_t ja_memguard_stop(void);
+
+#endif /* POK_NEEDS_MEMGUARD */
+
+#endif /* __JET_ASP_MEMGUARD_H__ */
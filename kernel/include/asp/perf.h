@@ -0,0 +1,56 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Performance counters of the current CPU, used for virtual counters
+ * of partitions (POK_NEEDS_PERF_COUNTERS, see core/perf.h).
+ *
+ * Counters are numbered from 0. Hardware counter, used by
+ * ja_memguard_start() (POK_NEEDS_MEMGUARD), is not included.
+ */
+
+#ifndef __JET_ASP_PERF_H__
+#define __JET_ASP_PERF_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+
+#include <types.h>
+#include <uapi/perf_types.h>
+
+/*
+ * Initialize counters on the current CPU and stop all of them.
+ *
+ * Return number of counters available, no more than JET_PERF_COUNTERS_MAX.
+ */
+unsigned ja_perf_init(void);
+
+/* Whether given event (not JET_PERF_EVENT_NONE) can be counted. */
+pok_bool_t ja_perf_event_supported(jet_perf_event_t event);
+
+/*
+ * Start counting given event with the counter from 0.
+ *
+ * JET_PERF_EVENT_NONE stops the counter.
+ */
+void ja_perf_start(unsigned index, jet_perf_event_t event);
+
+/* Return number of events since the counter has been started. */
+uint64_t ja_perf_read(unsigned index);
+
+#endif /* POK_NEEDS_PERF_COUNTERS */
+
+#endif /* __JET_ASP_PERF_H__ */
@@ -57,6 +57,32 @@ struct jet_space_layout
 void ja_space_layout_get(jet_space_id space_id,
     struct jet_space_layout* space_layout);
 
+/*
+ * Return whether memory of the space in given range may have been
+ * modified since the last call to ja_space_dirty_clear().
+ *
+ * Arch without tracking of modifications always returns TRUE.
+ */
+pok_bool_t ja_space_is_dirty(jet_space_id space_id,
+    const char __user* user_addr, size_t size);
+
+/* Start tracking of modifications of the space memory from now. */
+void ja_space_dirty_clear(jet_space_id space_id);
+
+/*
+ * Map kernel memory into the space for read only.
+ *
+ * 'addr' and 'size' should be aligned on 4K. Mappings are placed in
+ * the window of the space outside of the partition memory.
+ *
+ * Returns address of the mapping in the space, or NULL if arch
+ * (or its configuration) doesn't support such mappings.
+ *
+ * May be called only during OS init.
+ */
+const void __user* ja_space_map_ro(jet_space_id space_id,
+    const void* addr, size_t size);
+
 /* Return pointer to the heap for given space. */
 void* ja_space_get_heap(jet_space_id space_id);
 
@@ -125,5 +151,17 @@ void ja_fp_restore(struct jet_fp_store* fp_store);
 /* Initialize floating point registers with zero. */
 void ja_fp_init(void);
 
+/*
+ * FP registers are switched only when a thread actually uses them:
+ * floating point operations are forbidden when registers belong to
+ * other thread, and the first operation traps into jet_fp_unavailable().
+ */
+
+/* Allow floating point operations in user space. */
+void ja_fp_enable(void);
+
+/* Forbid floating point operations in user space until ja_fp_enable(). */
+void ja_fp_disable(void);
+
 
 #endif /* __JET_ASP_SPACE_H__ */
@@ -22,8 +22,37 @@
 /* Return current system time. */
 pok_time_t ja_system_time(void);
 
+/*
+ * Return current value of the hardware counter, from which system time
+ * is derived (see ja_system_time_params()).
+ */
+uint64_t ja_time_counter(void);
+
 /* Return current calendar time (seconds since Epoch). */
 time_t ja_calendar_time(void);
 
+/*
+ * Return parameters for compute system time in user space
+ * (see 'struct jet_time_page').
+ *
+ * Return FALSE if hardware counter cannot be read in user space.
+ */
+pok_bool_t ja_system_time_params(uint64_t* counter_base,
+    struct jet_time_scale* scale);
+
+#ifdef POK_NEEDS_TICKLESS
+/*
+ * Request timer interrupt (which calls jet_on_tick()) at given system time.
+ *
+ * New request replaces the previous one. If time is already passed,
+ * interrupt should fire as soon as possible. Interrupt may fire earlier
+ * than requested (e.g. when hardware counter cannot hold the whole
+ * interval), but never later.
+ *
+ * Called with preemption disabled.
+ */
+void ja_timer_set_oneshot(pok_time_t timepoint);
+#endif /* POK_NEEDS_TICKLESS */
+
 
 #endif /* __JET_ASP_TIME_H__ */
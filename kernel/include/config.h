@@ -42,5 +42,134 @@
 #define POK_NEEDS_SEMAPHORES 1
 #define POK_NEEDS_EVENTS 1
 
+// Use binary heap instead of sorted list for delayed events queue.
+//
+// Makes re-arming of timeouts and deadlines O(log n) instead of O(n)
+// in number of threads. May be set in CFLAGS of the project.
+//#define POK_NEEDS_DELAYED_EVENT_HEAP 1
+
+// Program timer in one-shot mode for the next scheduling event instead
+// of periodic interrupts with POK_TIMER_FREQUENCY.
+//
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_TICKLESS 1
+
+// Record kernel events into the per-CPU binary trace ring (see core/trace.h).
+//
+// Classes of recorded events are selected with POK_TRACE_CLASSES
+// (all by default), size of the ring with POK_TRACE_RING_SIZE.
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_TRACE 1
+
+// Run on POK_CONFIG_NB_CPUS processors, every one with its own schedule
+// (see 'Core' attribute of the schedule slots in XML configuration).
+// Major frames of all processors are synchronized.
+//
+// Supported only on x86-qemu, and only without GDB and tickless mode.
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_SMP 1
+
+// Map partition memory with 4K pages in TLB0 instead of 16M entries
+// in TLB1. Pages are described by per-partition page tables, so
+// partitions are packed in physical memory without gaps.
+//
+// Supported only on PowerPC e500. May be set in CFLAGS of the project.
+//#define POK_NEEDS_TLB0_PAGING 1
+
+// Isolate x86 partitions with PAE paging instead of GDT segments.
+// Every partition is mapped at 2G (see kernel/arch/x86/paging.h) and
+// should be linked with partition_paging.lds.
+//
+// Supported only on x86. May be set in CFLAGS of the project.
+//#define POK_NEEDS_X86_PAGING 1
+
+// Build memory of partitions with 'CacheColors' attribute from pages of
+// these colors only (see core/cache_color.h), so partitions with
+// disjoint colors don't interfere in the shared cache. Number of colors
+// is POK_CONFIG_CACHE_COLORS: cache size / (associativity * 4K).
+//
+// Requires POK_NEEDS_X86_PAGING or POK_NEEDS_TLB0_PAGING.
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_CACHE_COLORING 1
+
+// Limit memory bandwidth of partitions with 'MemoryBandwidth' element:
+// partition which exceeds its budget of last level cache misses in the
+// regulation period is throttled until the period ends
+// (see core/memguard.h). Misses are counted by the performance monitor
+// of the processor.
+//
+// Requires POK_NEEDS_MONITOR. May be set in CFLAGS of the project.
+//#define POK_NEEDS_MEMGUARD 1
+
+// Provide partitions with virtual performance counters (cycles,
+// instructions, cache and TLB misses), which are saved and restored on
+// switch between partitions (see core/perf.h).
+//
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_PERF_COUNTERS 1
+
+// Map sampling channels read-only into destination partitions, so
+// READ_SAMPLING_MESSAGE is executed in user space without syscall
+// (see 'struct jet_sampling_shared'). Other arches and configurations
+// fall back to syscall.
+//
+// Supported only with POK_NEEDS_X86_PAGING or POK_NEEDS_TLB0_PAGING.
+// May be set in CFLAGS of the project.
+//#define POK_NEEDS_SAMPLING_SHARED 1
+
+// Partitions are stored in the kernel archive as LZ4-compressed images
+// (see misc/lz4_image.py) instead of ELF files, and are decompressed
+// directly into their spaces when loaded.
+//
+// May be set in CFLAGS of the project ('lz4' option of the build).
+//#define POK_NEEDS_LZ4_IMAGES 1
+
+// Count calls of syscalls from the syscall map and collect histograms
+// of latency of their handlers (see 'struct jet_syscall_stats'). Statistic is
+// printed by 'syscalls' command of the monitor.
+//
+// Requires POK_NEEDS_MONITOR. May be set in CFLAGS of the project
+// ('syscall_stats' option of the build).
+//#define POK_NEEDS_SYSCALL_STATS 1
+
+#if defined(POK_NEEDS_SAMPLING_SHARED) \
+    && !defined(POK_NEEDS_X86_PAGING) && !defined(POK_NEEDS_TLB0_PAGING)
+#error POK_NEEDS_SAMPLING_SHARED requires paging
+#endif
+
+#if defined(POK_NEEDS_MEMGUARD) && !defined(POK_NEEDS_MONITOR)
+#error POK_NEEDS_MEMGUARD requires POK_NEEDS_MONITOR
+#endif
+
+#if defined(POK_NEEDS_SYSCALL_STATS) && !defined(POK_NEEDS_MONITOR)
+#error POK_NEEDS_SYSCALL_STATS requires POK_NEEDS_MONITOR
+#endif
+
+#ifdef POK_NEEDS_CACHE_COLORING
+#ifndef POK_CONFIG_CACHE_COLORS
+#define POK_CONFIG_CACHE_COLORS 8
+#endif
+
+#if !defined(POK_NEEDS_X86_PAGING) && !defined(POK_NEEDS_TLB0_PAGING)
+#error POK_NEEDS_CACHE_COLORING requires paging
+#endif
+#endif /* POK_NEEDS_CACHE_COLORING */
+
+#ifdef POK_NEEDS_SMP
+#ifndef POK_CONFIG_NB_CPUS
+#define POK_CONFIG_NB_CPUS 2
+#endif
+
+#ifdef POK_NEEDS_GDB
+#error POK_NEEDS_SMP requires POK_DISABLE_GDB
+#endif
+
+#ifdef POK_NEEDS_TICKLESS
+#error POK_NEEDS_SMP is incompatible with POK_NEEDS_TICKLESS
+#endif
+#else /* POK_NEEDS_SMP */
+#define POK_CONFIG_NB_CPUS 1
+#endif /* POK_NEEDS_SMP */
+
 // TODO: Is this needed?
 #define POK_TEST_SUPPORT_PRINT_WHEN_ALL_THREADS_STOPPED 1
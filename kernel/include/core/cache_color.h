@@ -0,0 +1,68 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Allocator of physical pages with given cache colors.
+ *
+ * Color of the page is the number of its cache set group:
+ *
+ *     color = (phys / JET_CACHE_COLOR_PAGE_SIZE) % POK_CONFIG_CACHE_COLORS
+ *
+ * Partitions with disjoint sets of colors never evict lines of each
+ * other from the (physically indexed) shared cache.
+ *
+ * Pages of every color are taken from the pool in increasing order,
+ * pages are never freed. Arch code uses the allocator on space
+ * initialization for building page tables.
+ */
+
+#ifndef __JET_CORE_CACHE_COLOR_H__
+#define __JET_CORE_CACHE_COLOR_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_CACHE_COLORING
+
+#include <types.h>
+
+#define JET_CACHE_COLOR_PAGE_SIZE 0x1000UL
+
+/* Mask with all colors. */
+#define JET_CACHE_COLORS_ALL \
+    ((uint32_t)(((uint64_t)1 << POK_CONFIG_CACHE_COLORS) - 1))
+
+/*
+ * Initialize the pool, which occupies [phys_start; phys_end) range of
+ * the physical memory.
+ *
+ * Memory below the pool (e.g., used by spaces with contiguous
+ * memory) is never returned by the allocator.
+ */
+void jet_cache_color_init(uintptr_t phys_start, uintptr_t phys_end);
+
+/*
+ * Allocate next page with one of the given colors.
+ *
+ * Colors are used in round-robin order, '*color_next' stores the
+ * state of it for the caller (should be initialized to 0). So
+ * consecutive pages of the space are spread over all its colors.
+ *
+ * Fails fatally if the pool has no more pages of the color.
+ */
+uintptr_t jet_cache_color_page_alloc(uint32_t colors, unsigned* color_next);
+
+#endif /* POK_NEEDS_CACHE_COLORING */
+
+#endif /* __JET_CORE_CACHE_COLOR_H__ */
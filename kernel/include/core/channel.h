@@ -20,9 +20,15 @@
 #ifndef __POK_KERNEL_CHANNEL_H__
 #define __POK_KERNEL_CHANNEL_H__
 
+#include <config.h>
 #include <types.h>
 
 #include <core/partition.h>
+#include <uapi/port_types.h>
+
+#ifdef POK_NEEDS_SMP
+#include <arch/spinlock.h>
+#endif
 
 /*********************** Queuing channel ******************************/
 
@@ -50,6 +56,19 @@ struct pok_channel_queuing_side
 
     /* Identificator for use in notification event. Set on port creation. */
     uint16_t handler_id;
+
+    /* 
+     * Flag is set when message is discarded (receiver only).
+     * Flag is cleared after receiver is notified about that.
+     */
+    pok_bool_t message_discarded;
+
+    /* 
+     * Number of messages discarded because of overflow since the side
+     * has been initialized: messages missed by the receiver, or
+     * messages of the sender which have not been delivered.
+     */
+    uint32_t nb_discarded;
 };
 
 /* What to do when receiving buffer is full and new message is sent. */
@@ -69,7 +88,17 @@ enum jet_channel_queuing_overflow_strategy
      * With that strategy no reason to have sender buffer to accomodate
      * more than single message.
      */
-    JET_CHANNEL_QUEUING_RECEIVER_DISCARD
+    JET_CHANNEL_QUEUING_RECEIVER_DISCARD,
+    /* 
+     * Discard the oldest message in the full receiver buffer, so the
+     * new message fits into it (ring).
+     * 
+     * Receiver will be notified about that discarding.
+     * 
+     * Sender is never blocked. The strategy is incompatible with
+     * zero-copy channel, as the discarded message may be peeked.
+     */
+    JET_CHANNEL_QUEUING_RECEIVER_OVERWRITE
 };
 
 /* 
@@ -81,6 +110,11 @@ enum jet_channel_queuing_overflow_strategy
  * Mesages in that channel are transmitted *instantly* unless receiver
  * is not ready or its buffer is full. In that case messages are
  * accumulated on sender side until it is possible to transmit them.
+ * 
+ * Channel may have several receivers (multicast). Every message is
+ * stored once, and each receiver consumes it with its own cursor.
+ * Message is transmitted only when all ready receivers have space for
+ * it, so the slowest receiver blocks the sender.
  */
 typedef struct {
     /* Maximum size of single message. Set in deployment.c*/
@@ -88,12 +122,26 @@ typedef struct {
     /* Distance between messages in the array. */
     pok_message_size_t message_stride;
 
-    /* Sides of the channel. */
-    struct pok_channel_queuing_side send, recv;
+    /* Sender side of the channel. */
+    struct pok_channel_queuing_side send;
+
+    /* Array of receiver sides. Set in deployment.c. */
+    struct pok_channel_queuing_side* recvs;
+    /* Number of receivers. Set in deployment.c. */
+    uint8_t nb_recvs;
 
-    pok_message_range_t max_nb_message; // Total buffer capasity.
+    /* 
+     * Total buffer capasity: sender buffer plus the largest
+     * receiver buffer.
+     */
+    pok_message_range_t max_nb_message;
 
-    char* messages; // Array of messages
+    /*
+     * Array of messages.
+     *
+     * Allocated on initialization unless channel is zero-copy.
+     */
+    char* messages;
     pok_message_size_t* message_sizes; // Array of messages sizes.
 
     /* Border between receiver and sender buffers.
@@ -105,12 +153,24 @@ typedef struct {
 
     /* Overflow strategy for given channel. Set in deployment.c. */
     enum jet_channel_queuing_overflow_strategy overflow_strategy;
-    /* 
-     * Flag is set when message is discarded.
-     * Flag is cleared after receiver is notified about that.
+
+    /*
+     * Whether array of messages is placed into the memory block, which
+     * is mapped writable into the sender's space and readable into
+     * the receivers' ones.
+     *
+     * For such channel 'messages' is set in deployment.c, and pointers
+     * to the messages are valid in both spaces. So ports may access
+     * messages in-place, without copying.
+     *
+     * Set in deployment.c.
      */
-    pok_bool_t message_discarded;
+    pok_bool_t is_zero_copy;
 
+#ifdef POK_NEEDS_SMP
+    /* Serializes operations of the sides executed on different CPUs. */
+    pok_spinlock_t lock;
+#endif
 } pok_channel_queuing_t;
 
 /* 
@@ -120,7 +180,8 @@ typedef struct {
  * 
  *   - max_message_size
  *   - send.max_nb_messages
- *   - recv.max_nb_messages
+ *   - recvs and nb_recvs, with max_nb_messages for every receiver
+ *   - messages (only for zero-copy channel)
  */
 void pok_channel_queuing_init(pok_channel_queuing_t* channel);
 
@@ -134,14 +195,18 @@ void pok_channel_queuing_side_init(pok_channel_queuing_t* channel,
     uint16_t handler_id);
 
 
-/**** Operations for receiver. Should be serialized wrt themselves ****/
-/* (Re)initialize receiver connection to the channel. */
-void pok_channel_queuing_r_init(pok_channel_queuing_t* channel);
+/*
+ * Operations for receiver. Should be serialized wrt themselves.
+ * 
+ * 'recv' is the side of the receiver in the channel's 'recvs' array.
+ */
 
 /*
  * Return number of messages on the receiver side.
  */
-pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* channel);
+pok_message_range_t pok_channel_queuing_r_n_messages(
+    pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv);
 
 /* 
  * Return pointer to the first message at receiver side.
@@ -153,17 +218,38 @@ pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* chan
  */
 const char* pok_channel_queuing_r_get_message(
     pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
     pok_message_size_t* size,
     pok_bool_t subscribe);
 
 /* 
  * Consume the first message at receiver side.
  * 
- * Set 'message_discarded' parameter to one in the channel field,
+ * Set 'message_discarded' parameter to one in the receiver's field,
  * and reset the field.
  */
 void pok_channel_queuing_r_consume_message(
     pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
+    pok_bool_t* message_discarded);
+
+/*
+ * Receive up to 'n' messages at receiver side in one pass.
+ *
+ * Message 'i' is copied into 'buffer + i * stride', its size is
+ * stored into sizes[i]. Received messages are consumed.
+ *
+ * Set 'message_discarded' like pok_channel_queuing_r_consume_message().
+ *
+ * Return number of messages received.
+ */
+pok_message_range_t pok_channel_queuing_r_receive_messages(
+    pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv,
+    char* buffer,
+    pok_message_size_t stride,
+    pok_port_size_t* sizes,
+    pok_message_range_t n,
     pok_bool_t* message_discarded);
 
 /***** Operations for sender. Should be serialized wrt themselves *****/
@@ -184,12 +270,31 @@ char* pok_channel_queuing_s_get_message(
  * 
  * If possible, the message is sent immediately.
  * Otherwise it will be automatically sent when there will be sufficient
- * space in the receiver buffer.
+ * space in the buffers of all ready receivers.
  */
 void pok_channel_queuing_s_produce_message(
     pok_channel_queuing_t* channel,
     pok_message_size_t size);
 
+/*
+ * Send up to 'n' messages at sender side in one pass.
+ *
+ * Message 'i' is taken from 'buffer + i * stride', its size is
+ * sizes[i].
+ *
+ * Sizes may be located in user memory, so every size is read once,
+ * under the channel lock. Sending stops at the first size which is not
+ * in range 1..max_message_size, or when sender buffer becomes full.
+ *
+ * Return number of messages sent.
+ */
+pok_message_range_t pok_channel_queuing_s_send_messages(
+    pok_channel_queuing_t* channel,
+    const char* buffer,
+    pok_message_size_t stride,
+    const pok_port_size_t* sizes,
+    pok_message_range_t n);
+
 /*
  * Return number of messages on the sender side.
  * 
@@ -200,14 +305,31 @@ pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* chan
 
 /*********************** Sampling channel *****************************/
 
+/* Position of the message slot, which means there is no message. */
+#define POK_CHANNEL_SAMPLING_POS_EMPTY 0xff
+
+/* Receiver of the sampling channel. */
+struct pok_channel_sampling_reader
+{
+    /* Slot of the message (possibly) currently processed. */
+    uint8_t read_pos;
+    /* Slot of the newest message received. */
+    uint8_t read_pos_next;
+};
+
 /* 
  * Sampling channel.
  * 
- * Receiver has one message slot for (possibly) currently processed
- * message, and one message slot for newest message received.
+ * Every receiver has one message slot for (possibly) currently processed
+ * message, and one message slot for newest message received. Receivers
+ * share slots with the same message, so the newest message is stored
+ * once for all of them.
  * 
  * Sender has one message slot for currently formed message.
  * 
+ * So 'nb_readers + 2' slots are sufficient for never overwrite message
+ * which is used by some receiver.
+ * 
  * Mesages in that channel are transmitted *instantly*.
  * 
  * Actually, ARINC distinguish message which is *sent* or *received*:
@@ -218,18 +340,42 @@ typedef struct {
     pok_message_size_t max_message_size;
     /* Distance between messages in the array. */
     pok_message_size_t message_stride;
-    /* Array of 3 messages. */
+
+    /* Array of receivers. Set in deployment.c. */
+    struct pok_channel_sampling_reader* readers;
+    /* Number of receivers. Set in deployment.c. */
+    uint8_t nb_readers;
+
+    /* Number of message slots. */
+    uint8_t nb_slots;
+    /* Array of 'nb_slots' messages. */
     char* messages;
     /* Array of message sizes.*/
-    pok_message_size_t message_sizes[3];
+    pok_message_size_t* message_sizes;
 
-    // Positions in range 0..2
-    uint8_t read_pos;
-    uint8_t read_pos_next;
+    /* Slot for the message which is formed by the sender. */
     uint8_t write_pos;
 
     /* The simplest implementation: timestamp per message. */
-    pok_time_t timestamps[3];
+    pok_time_t* timestamps;
+
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    /*
+     * Page-aligned memory with messages, mapped into the destination
+     * partitions. Updated when message is sent or cleared by the sender.
+     */
+    struct jet_sampling_shared* shared;
+    /* Size of the memory at 'shared'. */
+    size_t shared_size;
+#endif
+
+#ifdef POK_NEEDS_SMP
+    /*
+     * Serializes changing of the positions by the sides executed
+     * on different CPUs. Messages themselves are accessed without lock.
+     */
+    pok_spinlock_t lock;
+#endif
 } pok_channel_sampling_t;
 
 /* 
@@ -238,11 +384,16 @@ typedef struct {
  * Fields should be set before calling this function:
  * 
  *   - max_message_size
+ *   - readers and nb_readers
  */
 void pok_channel_sampling_init(pok_channel_sampling_t* channel);
 
 
-/**** Operations for receiver. Should be serialized wrt themselves ****/
+/*
+ * Operations for receiver. Should be serialized wrt themselves.
+ * 
+ * 'reader' is the receiver in the channel's 'readers' array.
+ */
 
 /*
  * Get pointer to the message for read it.
@@ -256,20 +407,23 @@ void pok_channel_sampling_init(pok_channel_sampling_t* channel);
  */
 const char* pok_channel_sampling_r_get_message(
     pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader,
     pok_message_size_t* size,
     pok_time_t* timestamp);
 
 /*
  * Clear message received.
  */
-void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel);
+void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader);
 
 /*
  * Return POK_ERRNO_OK if new message has been arrive since we check(read).
  * 
  * Return POK_ERRNO_EMPTY otherwise.
  */
-pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel);
+pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_reader* reader);
 
 /***** Operations for sender. Should be serialized wrt themselves *****/
 
@@ -288,6 +442,11 @@ void pok_channel_sampling_send_message(
 
 /*
  * Clear message sent.
+ * 
+ * Receivers will see the message they have read before.
+ *
+ * With POK_NEEDS_SAMPLING_SHARED readers in user space see only the
+ * newest message, so it is kept for all receivers.
  */
 void pok_channel_sampling_s_clear_message(pok_channel_sampling_t* channel);
 
@@ -18,6 +18,16 @@
 
 /*
  * Delayed events - events which should fire at specific time point
+ *
+ * Two implementations of the queue are available:
+ *
+ *  - sorted list (default): O(1) for check, O(n) for add.
+ *  - binary heap (POK_NEEDS_DELAYED_EVENT_HEAP): O(log n) for both add
+ *    and remove. Storage for the heap should be allocated with
+ *    delayed_event_queue_alloc() at partition initialization.
+ *
+ * Both implementations fire events with the same timepoint in the
+ * order they have been added.
  */
 
 #include <list.h>
@@ -27,9 +37,16 @@ typedef void (*process_event_t)(uint16_t handler_id);
 
 /** Event which should occure at a specific time point. */
 struct delayed_event {
+#ifdef POK_NEEDS_DELAYED_EVENT_HEAP
+	// Index in the heap plus 1. 0 if event is not in the event queue.
+	uint16_t heap_index;
+	// Order of addition, for events with the same timepoint.
+	uint32_t seq;
+#else
 	struct delayed_event* next_event;
 	// NULL if event is not in the event queue.
 	struct delayed_event** pprev_event;
+#endif
 	pok_time_t timepoint;
 	uint16_t handler_id;
 	process_event_t process_event;
@@ -38,17 +55,39 @@ struct delayed_event {
 // Whether we wait something.
 static inline pok_bool_t delayed_event_is_active(struct delayed_event* event)
 {
+#ifdef POK_NEEDS_DELAYED_EVENT_HEAP
+	return event->heap_index != 0;
+#else
 	return event->pprev_event != NULL;
+#endif
 }
 
 /*
  * Queue of delayed events.
  */
 struct delayed_event_queue {
+#ifdef POK_NEEDS_DELAYED_EVENT_HEAP
+	// Min-heap of events, ordered by (timepoint, seq).
+	struct delayed_event** heap;
+	uint16_t n_events;
+	uint16_t max_events;
+	uint32_t next_seq;
+#else
 	// Events are ordered by timeout.
 	struct delayed_event* first_event;
+#endif
 };
 
+/**
+ * Allocate storage for the queue, which may contain up to
+ * @max_events events.
+ *
+ * Should be called once, before the first delayed_event_queue_init().
+ * Does nothing for list-based queue.
+ */
+void delayed_event_queue_alloc(struct delayed_event_queue* q,
+	uint16_t max_events);
+
 /** Initialize delayed events queue. */
 void delayed_event_queue_init(struct delayed_event_queue* q);
 
@@ -18,20 +18,63 @@
 #ifndef __JET_LOADER_H__
 #define __JET_LOADER_H__
 
+#include <config.h>
+
 #include <types.h>
 #include <errno.h>
 #include <core/space.h>
 
+/* Maximum number of loadable segments which may be restored. */
+#define JET_LOADER_SEGMENTS_MAX 8
+
+/* Loadable segment of the elf, as it has been placed into the space. */
+struct jet_loader_segment
+{
+    char* kernel_dest;
+    char __user* user_dest;
+    /* Pristine content of the segment, compressed with POK_NEEDS_LZ4_IMAGES. */
+    const char* src;
+    size_t filesz;
+    size_t memsz;
+#ifdef POK_NEEDS_LZ4_IMAGES
+    /* Size of the compressed content at 'src'. */
+    size_t csize;
+#endif
+};
+
+/* Image of the elf, loaded into the space. */
+struct jet_loader_image
+{
+    void (*entry)(void);
+
+    /*
+     * Whether segments are recorded and the elf has been loaded without
+     * errors, so image may be restored.
+     */
+    pok_bool_t restorable;
+
+    int nsegments;
+    struct jet_loader_segment segments[JET_LOADER_SEGMENTS_MAX];
+};
+
 /**
  * Load elf into given space.
  * 
- * Entry point is returned via 'entry' parameter.
- * 
- * If 'heap_size' is not 0, allocates heap of given size and setup heap
- * in kernel_shared_data.
+ * Entry point and segments are recorded into 'image'.
  */
 void jet_loader_elf_load   (uint8_t elf_id,
                                  jet_space_id space_id,
-                                 void (** entry)(void));
-#endif /* __JET_LOADER_H__ */
+                                 struct jet_loader_image* image);
 
+/*
+ * Restore image, previously loaded into given space, to its initial state.
+ *
+ * Unlike to jet_loader_elf_load(), elf isn't parsed again, and only
+ * memory which has been modified since the previous load is copied
+ * (see ja_space_is_dirty()). Compressed segment is restored as a whole.
+ *
+ * 'image->restorable' should be TRUE.
+ */
+void jet_loader_elf_restore(jet_space_id space_id,
+                                 const struct jet_loader_image* image);
+#endif /* __JET_LOADER_H__ */
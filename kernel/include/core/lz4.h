@@ -0,0 +1,44 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Decompression of LZ4 blocks (POK_NEEDS_LZ4_IMAGES).
+ *
+ * Only the block format is supported: frames, checksums and
+ * dictionaries are handled by the image format of the loader.
+ */
+
+#ifndef __JET_CORE_LZ4_H__
+#define __JET_CORE_LZ4_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_LZ4_IMAGES
+
+#include <types.h>
+
+/*
+ * Decompress LZ4 block 'src' of 'src_size' bytes into 'dst'.
+ *
+ * Returns TRUE if block is correct and its decompressed size is exactly
+ * 'dst_size'. Nothing is written outside of 'dst_size' bytes at 'dst'
+ * even for incorrect block.
+ */
+pok_bool_t jet_lz4_decompress(const uint8_t* src, size_t src_size,
+    uint8_t* dst, size_t dst_size);
+
+#endif /* POK_NEEDS_LZ4_IMAGES */
+
+#endif /* __JET_CORE_LZ4_H__ */
@@ -0,0 +1,83 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Regulation of memory bandwidth of partitions (POK_NEEDS_MEMGUARD).
+ *
+ * Partition with non-zero budget may cause no more than 'budget'
+ * memory accesses (last level cache misses, as counted by the arch,
+ * see asp/memguard.h) per regulation period. When the budget is
+ * exhausted, partition is throttled: the scheduler executes idle
+ * context in its time slots until the next period begins.
+ *
+ * Regulation periods of the partition are aligned on the time when it
+ * is first executed. Budget isn't accumulated between periods.
+ */
+
+#ifndef __JET_CORE_MEMGUARD_H__
+#define __JET_CORE_MEMGUARD_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_MEMGUARD
+
+#include <types.h>
+
+struct _pok_partition;
+
+struct jet_memguard
+{
+    /* Number of accesses per period. 0 means no regulation. Set in deployment.c. */
+    uint32_t budget;
+    /* Regulation period. Set in deployment.c. */
+    pok_time_t period;
+
+    /* Accesses left in the current period. */
+    uint32_t remaining;
+    /* End of the current period. 0 if partition is not executed yet. */
+    pok_time_t period_end;
+    /* Whether the budget is exhausted in the current period. */
+    pok_bool_t throttled;
+
+    /* Number of periods in which partition has been throttled. */
+    uint32_t n_throttles;
+};
+
+/*
+ * Initialize counter on the current CPU.
+ *
+ * Should be called by every CPU before it starts its schedule.
+ */
+void jet_memguard_init(void);
+
+/*
+ * Account accesses of the 'old' partition (may be NULL)
+ * and start counting for the 'new' one.
+ *
+ * Called by the scheduler before switch between partitions.
+ */
+void jet_memguard_switch(struct _pok_partition* old,
+    struct _pok_partition* new, pok_time_t now);
+
+/*
+ * Replenish budget of the current partition if its period has ended.
+ *
+ * Called by the scheduler when it is rechecked for the same partition.
+ */
+void jet_memguard_update(struct _pok_partition* part, pok_time_t now);
+
+#endif /* POK_NEEDS_MEMGUARD */
+
+#endif /* __JET_CORE_MEMGUARD_H__ */
@@ -33,6 +33,19 @@
 #include <asp/cswitch.h>
 
 #include <asp/space.h>
+#include <asp/cpu.h>
+
+#ifdef POK_NEEDS_SMP
+#include <arch/spinlock.h>
+#endif
+
+#ifdef POK_NEEDS_MEMGUARD
+#include <core/memguard.h>
+#endif
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+#include <core/perf.h>
+#endif
 
 struct _pok_partition;
 
@@ -143,13 +156,6 @@ enum jet_partition_event_type
     JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE,
 };
 
-/* Outer event for partition. */
-struct jet_partition_event
-{
-    uint16_t handler_id;
-    enum jet_partition_event_type event_type;
-};
-
 /*!
  * \struct pok_partition_t
  * \brief This structure contains all needed information for partition management
@@ -164,18 +170,23 @@ typedef struct _pok_partition
     const struct pok_partition_operations* part_ops;
 
     /*
-     * Circular buffer with partition events.
+     * Bitmap of pending events, bit per handler.
+     *
+     * Repeated events for the same handler are coalesced into single
+     * bit, so bitmap cannot overflow whatever the rate of events is.
      *
      * Allocated on initialization.
      */
-    struct jet_partition_event* partition_events;
-
-    /* Maximum number of incoming events. Set in deployment.c. */
-    uint16_t partition_event_max;
-    /* Index of the first event for receive. */
-    uint16_t partition_event_begin;
-    /* Index after the last event for receive. */
-    uint16_t partition_event_end;
+    uint32_t* partition_events_pending;
+
+    /* Number of handlers for incoming events. Set in deployment.c. */
+    uint16_t partition_event_handlers_n;
+    /* Whether timer event is pending. */
+    pok_bool_t partition_event_timer;
+#ifdef POK_NEEDS_SMP
+    /* Serializes adding events from different CPUs. */
+    pok_spinlock_t partition_event_lock;
+#endif
 
     /*
      * If this field is positive, partition will receive event
@@ -184,19 +195,18 @@ typedef struct _pok_partition
      *
      * When timer event is fired, the field is reset to 0.
      *
-     * DEV: There are 2 slots for timer events. So it is allowable to
-     * set this field without preliminary reseting it and checking for
-     * events.
+     * It is allowable to set this field without preliminary reseting
+     * it and checking for events: timer events are coalesced.
      */
     volatile pok_time_t timer;
 
     /*
      * Whether event has been fired.
      *
-     * This field is set when event is added to empty queue.
+     * This field is set every time event is added.
      *
-     * The field should be reset to 0 by partition before last event is
-     * consumed.
+     * The field should be reset to 0 by partition before pending events
+     * are taken.
      */
     pok_bool_t is_event;
 
@@ -307,17 +317,73 @@ typedef struct _pok_partition
    * Set in deployment.c
    */
   const pok_error_module_action_table_t* multi_partition_hm_table;
+
+  /*
+   * CPU usage of the partition. Accumulated since the boot.
+   *
+   * Updated by the global scheduler on switch between partitions.
+   */
+  jet_cpu_account_t cpu_account;
+  /* Time when partition has been switched to. */
+  pok_time_t cpu_account_start;
+
+#ifdef POK_NEEDS_MEMGUARD
+  /* Regulation of memory bandwidth. Budget and period are set in deployment.c. */
+  struct jet_memguard memguard;
+#endif
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+  /* Virtual performance counters. */
+  struct jet_perf_partition perf;
+#endif
 } pok_partition_t;
 
+/*
+ * Partition executed on every CPU.
+ *
+ * Use 'current_partition' instead.
+ */
+extern pok_partition_t* current_partition_cpus[POK_CONFIG_NB_CPUS];
+
 /**
- * Pointer to the current partition.
+ * Pointer to the current partition (on the current CPU).
  *
  * DEV: Readonly for all except scheduler-related stuff.
  */
-extern pok_partition_t* current_partition;
+#define current_partition (current_partition_cpus[ja_cpu_id()])
+
+/*
+ * Return CPU time, consumed by the partition up to the moment 'now'.
+ *
+ * 'now' should be the current time.
+ *
+ * Should be called with global preemption disabled.
+ */
+static inline pok_time_t pok_partition_cpu_time(pok_partition_t* part,
+    pok_time_t now)
+{
+    pok_time_t cpu_time = part->cpu_account.consumed_time;
+
+    if(part == current_partition)
+        cpu_time += now - part->cpu_account_start;
+
+    return cpu_time;
+}
 
 /*
- * Add event to partition's queue and notify it if needed.
+ * Get CPU usage of the partition, including current time window.
+ *
+ * Should be called with global preemption disabled.
+ */
+void pok_partition_cpu_account_get(pok_partition_t* part,
+    jet_cpu_account_t* account);
+
+/*
+ * Mark event as pending for partition and notify it.
+ *
+ * Events of port types with the same handler_id are coalesced: handler
+ * should check state of the port when processes the event. Handler of
+ * timer event is always 0.
  *
  * Should be called with global preemption disabled.
  *
@@ -328,20 +394,41 @@ void pok_partition_add_event(pok_partition_t* part,
     enum jet_partition_event_type event_type,
     uint16_t handler_id);
 
+/* Number of words in the bitmap of pending events for given partition. */
+static inline uint16_t pok_partition_events_words(pok_partition_t* part)
+{
+    return (part->partition_event_handlers_n + 31) / 32;
+}
+
 /*
- * Consume event from current partition's queue.
+ * Drop all pending events of given partition.
  *
- * Return TRUE on success, FALSE if the queue is empty.
+ * Used on partition's (re)start.
+ */
+void pok_partition_events_reset(pok_partition_t* part);
+
+/*
+ * Take pending events of current partition from given word of the bitmap.
+ *
+ * Returns bitmap of handlers with pending events, bit 'i' corresponds
+ * to handler '32 * word + i'. Taken events are cleared.
  *
  * Should be called with local preemption disabled.
  */
-pok_bool_t pok_partition_get_event(struct jet_partition_event* event);
+uint32_t pok_partition_take_events(uint16_t word);
+
+/*
+ * Take pending timer event of current partition.
+ *
+ * Returns TRUE if timer event has been pending.
+ *
+ * Should be called with local preemption disabled.
+ */
+pok_bool_t pok_partition_take_timer_event(void);
 
 /*
  * Set timer for given partition.
  * Setting to 0 means reseting.
- *
- * Event queue should be drained before setting timer once more.
  */
 void pok_partition_set_timer(pok_partition_t* part,
     pok_time_t timer_new);
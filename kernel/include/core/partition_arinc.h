@@ -19,6 +19,8 @@
 #include <core/partition.h>
 #include <core/error_arinc.h>
 #include <core/port.h>
+#include <core/ready_queue.h>
+#include <core/loader.h>
 
 #include <uapi/partition_arinc_types.h>
 
@@ -133,7 +135,8 @@ typedef struct _pok_patition_arinc
     uint32_t                nthreads_unrecoverable;
 
 
-    void                    (*main_entry)(void);
+    /* Image of the partition, restored on every restart after the first one. */
+    struct jet_loader_image image;
     uint32_t                main_user_stack_size;
 
 
@@ -145,7 +148,7 @@ typedef struct _pok_patition_arinc
      * 
      * Used only in NORMAL mode.
      */
-    struct list_head       eligible_threads; 
+    struct jet_ready_queue eligible_threads;
 
     /**
      * Queue of all timed events.
@@ -237,6 +240,15 @@ pok_ret_t pok_current_partition_inc_lock_level(int32_t *lock_level);
 
 pok_ret_t pok_current_partition_dec_lock_level(int32_t *lock_level);
 
+/*
+ * Get CPU usage of the thread in given partition, including currently
+ * running activation.
+ *
+ * Should be called with global preemption disabled.
+ */
+void pok_thread_cpu_account_get(pok_partition_arinc_t* part,
+    pok_thread_t* t, jet_cpu_account_t* account);
+
 
 /*
  * Raise error about inconsistent state of OS.
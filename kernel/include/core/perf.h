@@ -0,0 +1,69 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Performance counters of partitions (POK_NEEDS_PERF_COUNTERS).
+ *
+ * Every partition has its own set of JET_PERF_COUNTERS_MAX virtual
+ * counters. Hardware counters are programmed for the events of the
+ * current partition, and their values are accumulated into the
+ * partition's counters on switch to other partition. So counters
+ * include only work done in the windows of the partition, both in
+ * user and in kernel mode.
+ *
+ * Counters are disabled when partition is (re)started.
+ */
+
+#ifndef __JET_CORE_PERF_H__
+#define __JET_CORE_PERF_H__
+
+#include <config.h>
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+
+#include <types.h>
+#include <uapi/perf_types.h>
+
+struct _pok_partition;
+
+struct jet_perf_partition
+{
+    /* Events counted. */
+    jet_perf_event_t events[JET_PERF_COUNTERS_MAX];
+    /* Values accumulated before the current activation of the partition. */
+    uint64_t values[JET_PERF_COUNTERS_MAX];
+};
+
+/*
+ * Initialize counters on the current CPU.
+ *
+ * Should be called by every CPU before it starts its schedule.
+ */
+void jet_perf_init(void);
+
+/*
+ * Accumulate counters of the 'old' partition (may be NULL)
+ * and program hardware for the 'new' one.
+ *
+ * Called by the scheduler on switch between partitions.
+ */
+void jet_perf_switch(struct _pok_partition* old, struct _pok_partition* new);
+
+/* Disable all counters of the current partition. */
+void jet_perf_reset(void);
+
+#endif /* POK_NEEDS_PERF_COUNTERS */
+
+#endif /* __JET_CORE_PERF_H__ */
@@ -48,6 +48,14 @@ typedef struct
      */
     pok_channel_queuing_t       *channel;
 
+    /*
+     * Side of the channel used by the port: 'send' for OUT port,
+     * one of 'recvs' for IN port.
+     * 
+     * Set in the deployment.c.
+     */
+    struct pok_channel_queuing_side *side;
+
     /*
      * Direction (IN or OUT).
      * 
@@ -64,6 +72,14 @@ typedef struct
 
     /* Whether port has been created (with CREATE_QUEUING_PORT)*/
     pok_bool_t                  is_created;
+
+    /*
+     * Whether first message in the channel is currently held by
+     * zero-copy operation: peeked for IN port, reserved for OUT port.
+     *
+     * While it is set, all other operations on the port wait.
+     */
+    pok_bool_t                  is_zero_copy_held;
 } pok_port_queuing_t;
 
 // Initialize queuing port.
@@ -99,6 +115,31 @@ pok_ret_t pok_port_queuing_send(
     const pok_time_t* __user    timeout);
 
 
+/*
+ * Batched operations on queuing port.
+ *
+ * Messages in the user buffer are placed with stride equal to the
+ * maximum message size of the port; their lengths are in 'lens' array.
+ *
+ * Operations never wait: as many messages as possible (but no more
+ * than 'n') are transmitted in one pass, and their number is returned.
+ * If no message can be transmitted, POK_ERRNO_EMPTY (POK_ERRNO_FULL)
+ * is returned.
+ */
+pok_ret_t pok_port_queuing_receive_batch(
+    pok_port_id_t               id,
+    void* __user                data,
+    pok_port_size_t* __user     lens,
+    pok_port_size_t             n,
+    pok_port_size_t* __user     n_received);
+
+pok_ret_t pok_port_queuing_send_batch(
+    pok_port_id_t               id,
+    const void* __user          data,
+    const pok_port_size_t* __user lens,
+    pok_port_size_t             n,
+    pok_port_size_t* __user     n_sent);
+
 pok_ret_t pok_port_queuing_status(
     pok_port_id_t               id,
     pok_port_queuing_status_t* __user status);
@@ -109,6 +150,47 @@ pok_ret_t pok_port_queuing_id(
 
 pok_ret_t pok_port_queuing_clear(pok_port_id_t id);
 
+/*
+ * Zero-copy operations on queuing port.
+ *
+ * Available only for ports which channel is zero-copy. Otherwise
+ * POK_ERRNO_UNAVAILABLE is returned.
+ *
+ * Operations never wait: if message (space for message) is not
+ * available immediately, POK_ERRNO_EMPTY (POK_ERRNO_FULL) is returned.
+ */
+
+/*
+ * Return pointer to the first message in the IN port and its size.
+ *
+ * Message is kept in the port until pok_port_queuing_consume() call.
+ */
+pok_ret_t pok_port_queuing_peek(
+    pok_port_id_t               id,
+    const void** __user         message,
+    pok_port_size_t* __user     len);
+
+/* Consume message, previously returned by pok_port_queuing_peek(). */
+pok_ret_t pok_port_queuing_consume(pok_port_id_t id);
+
+/*
+ * Return pointer to the place for the next message in the OUT port.
+ *
+ * Message is sent with pok_port_queuing_commit() call.
+ */
+pok_ret_t pok_port_queuing_reserve(
+    pok_port_id_t               id,
+    void** __user               message);
+
+/*
+ * Send message, previously reserved by pok_port_queuing_reserve().
+ *
+ * If 'len' is 0, reservation is cancelled and nothing is sent.
+ */
+pok_ret_t pok_port_queuing_commit(
+    pok_port_id_t               id,
+    pok_port_size_t             len);
+
 /* 
  * Receive message from the port into specified process.
  * 
@@ -141,6 +223,14 @@ void port_queuing_receive(pok_port_queuing_t* port, pok_thread_t* t);
  */
 void port_queuing_send(pok_port_queuing_t* port, pok_thread_t* t);
 
+/*
+ * Process waiters on the port after notification is received for it
+ * or zero-copy message is released.
+ *
+ * Should be called with local preemption disabled.
+ */
+void port_queuing_fired(pok_port_queuing_t* port);
+
 
 /* 
  * Sampling port.
@@ -164,6 +254,13 @@ typedef struct
      */
     pok_channel_sampling_t       *channel;
 
+    /*
+     * Receiver in the channel for IN port, NULL for OUT port.
+     * 
+     * Should be set initially.
+     */
+    struct pok_channel_sampling_reader *reader;
+
     /*
      * Direction (IN or OUT).
      * 
@@ -179,6 +276,15 @@ typedef struct
     
     /* Validity of last message read from the port. */
     pok_bool_t                  last_message_validity;
+
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    /*
+     * Channel, as it is mapped into the partition for IN port.
+     *
+     * NULL if the channel cannot be read without syscall.
+     */
+    const struct jet_sampling_shared* __user shared;
+#endif
 } pok_port_sampling_t;
 
 // Initialize sampling port
@@ -217,4 +323,13 @@ pok_ret_t pok_port_sampling_status (
 
 pok_ret_t pok_port_sampling_check(pok_port_id_t id);
 
+#ifdef POK_NEEDS_SAMPLING_SHARED
+/*
+ * Map channels of all IN sampling ports into their partitions.
+ *
+ * Should be called after channels are initialized.
+ */
+void pok_port_sampling_share_all(void);
+#endif
+
 #endif /* __POK_KERNEL_PORT_H__ */
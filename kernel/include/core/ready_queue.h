@@ -0,0 +1,130 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Priority/FIFO queue with constant time operations.
+ *
+ * Every priority has its own FIFO list of elements. Non-empty lists
+ * are marked in two-level bitmap, so the highest priority with
+ * elements is found with two "count leading zeroes" instructions.
+ */
+
+#ifndef __JET_READY_QUEUE_H__
+#define __JET_READY_QUEUE_H__
+
+#include <types.h>
+#include <list.h>
+#include <assert.h>
+#include <system_limits.h>
+
+/* Number of priorities supported. Priority 0 is valid too. */
+#define JET_READY_QUEUE_N_PRIO (MAX_PRIORITY_VALUE + 1)
+
+/* Number of words in the (lower level) bitmap. */
+#define JET_READY_QUEUE_N_WORDS ((JET_READY_QUEUE_N_PRIO + 31) / 32)
+
+struct jet_ready_queue
+{
+    /* Bit 'w' is set when bitmap[w] is non-zero. */
+    uint32_t bitmap_summary;
+    /* Bit 'p % 32' in bitmap[p / 32] is set when lists[p] is non-empty. */
+    uint32_t bitmap[JET_READY_QUEUE_N_WORDS];
+    /* FIFO list of elements for every priority. */
+    struct list_head lists[JET_READY_QUEUE_N_PRIO];
+};
+
+/* Helper: index of the most significant bit set. Value should be non-zero. */
+static inline unsigned int jet_ready_queue_msb(uint32_t value)
+{
+    return 31 - __builtin_clz(value);
+}
+
+static inline void jet_ready_queue_init(struct jet_ready_queue* queue)
+{
+    unsigned int i;
+
+    queue->bitmap_summary = 0;
+
+    for(i = 0; i < JET_READY_QUEUE_N_WORDS; i++)
+        queue->bitmap[i] = 0;
+
+    for(i = 0; i < JET_READY_QUEUE_N_PRIO; i++)
+        INIT_LIST_HEAD(&queue->lists[i]);
+}
+
+static inline pok_bool_t jet_ready_queue_is_empty(struct jet_ready_queue* queue)
+{
+    return queue->bitmap_summary == 0;
+}
+
+/* Add element after all other elements with given priority. */
+static inline void jet_ready_queue_add(struct jet_ready_queue* queue,
+    struct list_head* elem, uint8_t priority)
+{
+    assert(priority < JET_READY_QUEUE_N_PRIO);
+
+    list_add_tail(elem, &queue->lists[priority]);
+
+    queue->bitmap[priority / 32] |= 1U << (priority % 32);
+    queue->bitmap_summary |= 1U << (priority / 32);
+}
+
+/*
+ * Remove element from the queue.
+ *
+ * 'priority' should be the one used when element has been added.
+ */
+static inline void jet_ready_queue_del(struct jet_ready_queue* queue,
+    struct list_head* elem, uint8_t priority)
+{
+    assert(priority < JET_READY_QUEUE_N_PRIO);
+
+    list_del_init(elem);
+
+    if(list_empty(&queue->lists[priority]))
+    {
+        queue->bitmap[priority / 32] &= ~(1U << (priority % 32));
+        if(queue->bitmap[priority / 32] == 0)
+            queue->bitmap_summary &= ~(1U << (priority / 32));
+    }
+}
+
+/*
+ * Return the first element with the highest priority.
+ *
+ * Queue shouldn't be empty.
+ */
+static inline struct list_head* jet_ready_queue_first(struct jet_ready_queue* queue)
+{
+    unsigned int word;
+    unsigned int priority;
+
+    assert(!jet_ready_queue_is_empty(queue));
+
+    word = jet_ready_queue_msb(queue->bitmap_summary);
+    priority = word * 32 + jet_ready_queue_msb(queue->bitmap[word]);
+
+    return queue->lists[priority].next;
+}
+
+/* Return true if element is the one returned by jet_ready_queue_first(). */
+static inline pok_bool_t jet_ready_queue_is_first(struct jet_ready_queue* queue,
+    struct list_head* elem)
+{
+    return !jet_ready_queue_is_empty(queue)
+        && jet_ready_queue_first(queue) == elem;
+}
+
+#endif /* __JET_READY_QUEUE_H__ */
@@ -32,8 +32,14 @@
  * 
  * This partition is used in deployment.c instead of special partition
  * (like GDB or monitor) which support is not enabled in the config.
+ *
+ * Every CPU has its own idle partition, which is executed while
+ * the CPU waits for the start of the major frame. 'partition_idle' is
+ * the one of the boot CPU.
  */
-extern pok_partition_t partition_idle;
+extern pok_partition_t partition_idle_cpus[POK_CONFIG_NB_CPUS];
+
+#define partition_idle (partition_idle_cpus[0])
 
 
 #ifdef POK_NEEDS_MONITOR
@@ -61,12 +67,21 @@ extern pok_partition_t partition_gdb;
 typedef struct
 {
     uint64_t duration; // Set in deployment.c
-    uint64_t offset; // Set in deployment.c
+    uint64_t offset; // Start of the slot within major frame. Set in deployment.c
 
     pok_partition_t* partition; // Set in deployment.c
 
     pok_bool_t periodic_processing_start; // Set in deployment.c
 
+    /*
+     * Start of the next periodic processing window of the slot's partition
+     * (after this slot), relative to the start of the major frame
+     * containing this slot. May exceed major frame.
+     *
+     * Set in deployment.c.
+     */
+    uint64_t next_pps_offset;
+
     uint32_t id; // Set in deployment.c
 } pok_sched_slot_t;
 
@@ -84,6 +99,32 @@ extern const pok_sched_slot_t pok_module_sched[];
  */
 extern const uint8_t pok_module_sched_n;
 
+/*
+ * Schedule of one CPU: slots pok_module_sched[first .. first + n).
+ *
+ * Offsets of the slots are counted from the start of the major frame,
+ * which is common for all CPUs.
+ */
+typedef struct
+{
+    uint8_t first;
+    uint8_t n;
+} pok_sched_cpu_slots_t;
+
+/*
+ * Schedule of every CPU, in order of CPU indices.
+ *
+ * Set in deployment.c.
+ */
+extern const pok_sched_cpu_slots_t pok_module_sched_cpus[];
+
+/*
+ * Number of CPUs used by the schedule. Should not exceed POK_CONFIG_NB_CPUS.
+ *
+ * Set in deployment.c.
+ */
+extern const uint8_t pok_module_sched_cpus_n;
+
 /*
  * Major time frame.
  * 
@@ -189,6 +230,26 @@ void pok_sched_restart(void);
  */
 void pok_sched_on_time_changed(void);
 
+#ifdef POK_NEEDS_TICKLESS
+/**
+ * Reprogram one-shot timer according to the current time slot
+ * and the timer of the current partition.
+ *
+ * Should be called with preemption disabled after partition's timer
+ * is changed.
+ */
+void pok_sched_program_timer(void);
+#endif /* POK_NEEDS_TICKLESS */
+
+/*
+ * Forbid floating point operations if FP registers contain values
+ * of other thread than the current one.
+ *
+ * Should be called after current partition or its current thread
+ * is changed.
+ */
+void jet_fp_on_switch(void);
+
 /**
  * Return next release point for periodic process in current partition.
  * 
@@ -47,6 +47,59 @@ typedef struct
 // Should come after definitions of types 'pok_syscall_args_t' and 'pok_syscall_info_t'
 #include <uapi/syscall_map_arinc.h>
 
+/*
+ * Syscall declared in the syscall map (uapi/syscall_map_arinc.h.in).
+ *
+ * Such syscalls are dispatched via table and executed with preemption
+ * enabled.
+ */
+struct jet_syscall
+{
+   pok_ret_t (*func)(const pok_syscall_args_t* args);
+   /* Name without "POK_SYSCALL_" prefix. */
+   const char* name;
+   pok_syscall_id_t id;
+   /* Number of arguments, used by the syscall. */
+   uint8_t nargs;
+};
+
+/* Syscalls from the map, in order of their declaration. */
+extern const struct jet_syscall jet_syscalls[];
+extern const uint16_t jet_syscalls_n;
+
+#ifdef POK_NEEDS_SYSCALL_STATS
+
+/*
+ * Number of buckets in the latency histogram.
+ *
+ * Bucket 'i' counts calls with latency in [2^i, 2^(i+1)) nanoseconds,
+ * the last bucket counts all longer calls.
+ */
+#define JET_SYSCALL_STATS_BUCKETS 32
+
+/* Statistic for the syscall from the map. */
+struct jet_syscall_stats
+{
+   uint32_t n_calls;
+   /* Maximum latency, in nanoseconds. */
+   pok_time_t max_latency;
+   uint32_t latency_hist[JET_SYSCALL_STATS_BUCKETS];
+};
+
+/*
+ * Get statistic for jet_syscalls[index], summed over all CPUs.
+ *
+ * Latency is the time spent in the handler of the syscall. Kernel entry
+ * and exit, as well as lookup of the handler, are not included.
+ * Time when thread waits inside the handler is included.
+ */
+void jet_syscall_stats_get(uint16_t index, struct jet_syscall_stats* stats);
+
+/* Reset statistic for all syscalls. */
+void jet_syscall_stats_reset(void);
+
+#endif /* POK_NEEDS_SYSCALL_STATS */
+
 
 /**
  *  Function that performs the syscall. It is called by the 
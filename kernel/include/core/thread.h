@@ -226,6 +226,15 @@ typedef struct _pok_thread
      */
     uint64_t            next_activation;
 
+    /*
+     * CPU usage of the thread. Reset when thread is created.
+     *
+     * Updated by the local scheduler on switch between threads.
+     */
+    jet_cpu_account_t   cpu_account;
+    /* CPU time of the partition when thread has been switched to. */
+    pok_time_t          cpu_account_start;
+
     /*
      * Process state.
      */
@@ -368,6 +377,12 @@ typedef struct _pok_thread
      */
     struct list_head       eligible_elem;
 
+    /*
+     * Priority of the thread at the moment when it has been added to
+     * the `eligible_threads` in partition.
+     */
+    uint8_t                eligible_priority;
+
 #ifdef POK_NEEDS_ERROR_HANDLING
     struct list_head       error_elem;       /** Linkage for partition's `.error_list`. */
     pok_thread_error_bits_t error_bits;
@@ -39,6 +39,20 @@
 
 pok_ret_t pok_clock_gettime (clockid_t clk_id, pok_time_t* __user val);
 
+/*
+ * Calculate scale for convert counter with frequency 'from_freq'
+ * into the units with frequency 'to_freq'.
+ *
+ * Scale is chosen with maximum precision. Multiplier is rounded up,
+ * so converted value is never less than the exact one rounded down.
+ */
+void jet_time_scale_init(struct jet_time_scale* scale,
+    uint64_t from_freq, uint32_t to_freq);
+
+struct jet_time_page;
+/* Fill time page for the user space. */
+void jet_time_page_fill(struct jet_time_page* page);
+
 pok_ret_t jet_time(time_t* __user val);
 
 #endif  /* __POK_TIME_H__ */
@@ -0,0 +1,141 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Binary trace of kernel events.
+ *
+ * Every CPU has its own ring of fixed-size records. Recording an event
+ * stores raw hardware counter and few integers into the next slot of
+ * the ring, without any formatting and locking. When the ring is full,
+ * the oldest records are overwritten.
+ *
+ * The rings are extracted from the memory dump (e.g., with gdb
+ * 'dump binary value trace.bin jet_trace_rings') and decoded on the host
+ * with misc/jet_trace_decode.py.
+ *
+ * Layout of the structures below is the format of the dump: change
+ * JET_TRACE_VERSION and the decoder when modify them.
+ */
+
+#ifndef __JET_CORE_TRACE_H__
+#define __JET_CORE_TRACE_H__
+
+#include <config.h>
+#include <types.h>
+#include <uapi/time.h>
+
+/* Classes of events. Every class may be enabled in POK_TRACE_CLASSES. */
+#define JET_TRACE_CLASS_SWITCH  0x01 // Partition and thread switches.
+#define JET_TRACE_CLASS_SYSCALL 0x02 // Syscall enter and exit.
+#define JET_TRACE_CLASS_PORT    0x04 // Send/receive via ports.
+#define JET_TRACE_CLASS_ERROR   0x08 // Health Monitor errors.
+#define JET_TRACE_CLASS_TIMER   0x10 // Timer interrupts.
+
+#define JET_TRACE_CLASS_ALL     0x1f
+
+#ifndef POK_TRACE_CLASSES
+#define POK_TRACE_CLASSES JET_TRACE_CLASS_ALL
+#endif
+
+/* Number of records in the ring of every CPU. Should be power of 2. */
+#ifndef POK_TRACE_RING_SIZE
+#define POK_TRACE_RING_SIZE 1024
+#endif
+
+/* Events. Meaning of 'arg' is described for every event. */
+enum jet_trace_event_id
+{
+    JET_TRACE_EVENT_PARTITION_SWITCH = 1, // Id of the new partition.
+    JET_TRACE_EVENT_THREAD_SWITCH = 2, // Thread field is the new thread, 'arg' is the old one.
+    JET_TRACE_EVENT_SYSCALL_ENTER = 3, // Syscall id.
+    JET_TRACE_EVENT_SYSCALL_EXIT = 4, // Return value.
+    JET_TRACE_EVENT_QUEUING_SEND = 5, // Port id.
+    JET_TRACE_EVENT_QUEUING_RECEIVE = 6, // Port id.
+    JET_TRACE_EVENT_SAMPLING_WRITE = 7, // Port id.
+    JET_TRACE_EVENT_SAMPLING_READ = 8, // Port id.
+    JET_TRACE_EVENT_ERROR = 9, // Error id (pok_error_id_t).
+    JET_TRACE_EVENT_TIMER = 10, // Unused.
+};
+
+/* Value of 'thread' field when thread is unknown or there is no thread. */
+#define JET_TRACE_THREAD_NONE 0xff
+
+struct jet_trace_event
+{
+    uint64_t counter; // Value of the hardware counter (timebase, TSC).
+    uint8_t event_id; // enum jet_trace_event_id
+    uint8_t partition; // Id of the current partition.
+    uint8_t thread; // Index of the thread in the partition.
+    uint8_t reserved;
+    uint32_t arg;
+};
+
+#define JET_TRACE_MAGIC 0x4a545243 // "JTRC"
+#define JET_TRACE_VERSION 1
+
+struct jet_trace_ring
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t cpu;
+    uint32_t n_events; // Always POK_TRACE_RING_SIZE.
+    /*
+     * Number of events ever recorded. Event with number 'i' is stored
+     * at index 'i % n_events'.
+     */
+    volatile uint32_t head;
+    /* Counter value and its scale for convert into system time. */
+    uint64_t counter_base;
+    struct jet_time_scale scale;
+
+    struct jet_trace_event events[POK_TRACE_RING_SIZE];
+};
+
+#ifdef POK_NEEDS_TRACE
+
+/* Initialize the rings. Should be called after the time is initialized. */
+void jet_trace_init(void);
+
+/* Record event into the ring of the current CPU. */
+void jet_trace_emit(uint8_t event_id, uint8_t thread, uint32_t arg);
+
+/*
+ * Record event if its class is enabled.
+ *
+ * With disabled class (or without POK_NEEDS_TRACE) nothing is compiled,
+ * and arguments are not evaluated.
+ */
+#define jet_trace(class, event_id, thread, arg) do { \
+    if((POK_TRACE_CLASSES) & (class)) \
+        jet_trace_emit((event_id), (thread), (uint32_t)(arg)); \
+} while(0)
+
+/*
+ * Thread field for the thread of the current ARINC partition (may be NULL).
+ *
+ * Requires <core/partition_arinc.h>.
+ */
+#define JET_TRACE_THREAD(t) \
+    ((t) ? (uint8_t)((t) - current_partition_arinc->threads) : JET_TRACE_THREAD_NONE)
+
+#else /* POK_NEEDS_TRACE */
+
+static inline void jet_trace_init(void) {}
+
+#define jet_trace(class, event_id, thread, arg) do {} while(0)
+
+#endif /* POK_NEEDS_TRACE */
+
+#endif /* __JET_CORE_TRACE_H__ */
@@ -19,6 +19,7 @@
 #include <types.h>
 #include <uapi/partition_arinc_types.h>
 #include <uapi/msection.h>
+#include <uapi/time.h>
 
 /* Data about the thread, shared between kernel and user spaces. */
 struct jet_thread_shared_data
@@ -98,6 +99,35 @@ struct jet_thread_shared_data
 /* Thread is killed. When last msection is leaved, jet_sched() should be called. */
 #define THREAD_KERNEL_FLAG_KILLED 1
 
+/*
+ * Parameters for compute system time in user space without syscall:
+ *
+ *     time = jet_time_scale_apply(&scale, counter - counter_base)
+ *
+ * where 'counter' is the value of the hardware counter (timebase, TSC),
+ * which is readable in user space.
+ */
+struct jet_time_page
+{
+    /*
+     * Generation counter.
+     *
+     * Odd while the kernel updates the page. User should reread
+     * the page if counter is odd or is changed during the read.
+     */
+    volatile uint32_t seq;
+
+    /* 
+     * Whether time can be computed in user space.
+     * 
+     * If not, syscall should be used.
+     */
+    pok_bool_t valid;
+
+    uint64_t counter_base;
+    struct jet_time_scale scale;
+};
+
 /* Instance of this struct will be shared between kernel and user spaces. */
 struct jet_kernel_shared_data
 {
@@ -165,6 +195,15 @@ struct jet_kernel_shared_data
      */
     char* heap_end;
 
+    /* 
+     * Parameters of system time.
+     * 
+     * Set by the kernel when partition is started.
+     * 
+     * Read by the user for compute time without syscall.
+     */
+    struct jet_time_page time_page;
+
     /* Open-bounds array of thread shared data. */
     struct jet_thread_shared_data tshd[];
 };
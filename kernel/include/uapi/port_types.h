@@ -32,6 +32,8 @@ typedef struct
    pok_port_size_t      max_message_size;
    pok_port_direction_t direction;
    uint8_t              waiting_processes;
+   /* Number of messages discarded because of overflow (see overflow strategy of the channel). */
+   uint32_t             nb_discarded;
 } pok_port_queuing_status_t;
 
 /* 
@@ -46,6 +48,36 @@ typedef struct
     pok_queuing_discipline_t discipline;
 } pok_port_queuing_create_arg_t;
 
+/*
+ * Sampling channel, mapped read-only into the space of the destination
+ * partition (POK_NEEDS_SAMPLING_SHARED).
+ *
+ * The header is followed by 'nb_slots' message slots, 'message_stride'
+ * bytes each.
+ * The latest message is stored in the slot 'pos' and has 'size' bytes
+ * (0 means there is no message).
+ *
+ * Slot 'pos' isn't overwritten until 'seq' is changed, so the message
+ * may be copied directly from the slot. User should repeat the read if
+ * 'seq' is odd or is changed during the read (including copying of
+ * the message).
+ */
+struct jet_sampling_shared
+{
+    volatile uint32_t seq;
+
+    uint32_t pos;
+    uint32_t size;
+    pok_time_t timestamp;
+
+    /* Constant fields. */
+    uint32_t max_message_size;
+    uint32_t message_stride;
+    uint32_t nb_slots;
+
+    char messages[] __attribute__((aligned(8)));
+};
+
 /* Status for sampling port, for return into user space. */
 typedef struct
 {
@@ -53,6 +85,12 @@ typedef struct
    pok_port_direction_t direction;
    uint64_t             refresh;
    pok_bool_t           validity;
+   /*
+    * Channel of the destination port, which may be read without syscall.
+    *
+    * NULL if not available.
+    */
+   const struct jet_sampling_shared* shared;
 }pok_port_sampling_status_t;
 
 #endif /* __JET_UAPI_PORT_TYPES_H__ */
@@ -27,7 +27,9 @@
 #include <uapi/error_arinc_types.h>
 #include <uapi/memblock_types.h>
 #include <uapi/msection.h>
+#include <uapi/perf_types.h>
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_create(const char* __user name,
     void* __user entry,
     const pok_thread_attr_t* __user attr,
@@ -40,39 +42,59 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_CREATE(const pok_
         (const pok_thread_attr_t* __user)args->arg3,
         (pok_thread_id_t* __user)args->arg4);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_CREATE, 4)
+#endif
 
 #ifdef POK_NEEDS_THREAD_SLEEP
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_sleep(const pok_time_t* __user time);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SLEEP(const pok_syscall_args_t* args)
 {
     return pok_thread_sleep(
         (const pok_time_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SLEEP, 1)
+#endif
 #endif
 
 #ifdef POK_NEEDS_THREAD_SLEEP_UNTIL
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_sleep_until(const pok_time_t* __user time);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SLEEP_UNTIL(const pok_syscall_args_t* args)
 {
     return pok_thread_sleep_until(
         (const pok_time_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SLEEP_UNTIL, 1)
+#endif
 #endif
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_sched_end_period(void);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_PERIOD(const pok_syscall_args_t* args)
 {
     return pok_sched_end_period();
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_PERIOD, 0)
+#endif
 
 #if defined (POK_NEEDS_THREAD_SUSPEND) || defined (POK_NEEDS_ERROR_HANDLING)
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_suspend(const pok_time_t* __user time);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SUSPEND(const pok_syscall_args_t* args)
 {
     return pok_thread_suspend(
         (const pok_time_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SUSPEND, 1)
+#endif
 #endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_get_status(pok_thread_id_t thread_id,
     char* __user name,
     void** __user entry,
@@ -85,7 +107,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_STATUS(const pok_
         (void** __user)args->arg3,
         (pok_thread_status_t* __user)args->arg4);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STATUS, 4)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_delayed_start(pok_thread_id_t thread_id,
     const pok_time_t* __user time);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_DELAYED_START(const pok_syscall_args_t* args)
@@ -94,7 +120,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_DELAYED_START(con
         (pok_thread_id_t)args->arg1,
         (const pok_time_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_DELAYED_START, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_set_priority(pok_thread_id_t thread_id,
     uint32_t priority);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SET_PRIORITY(const pok_syscall_args_t* args)
@@ -103,47 +133,75 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SET_PRIORITY(cons
         (pok_thread_id_t)args->arg1,
         (uint32_t)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SET_PRIORITY, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_resume(pok_thread_id_t thread_id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_RESUME(const pok_syscall_args_t* args)
 {
     return pok_thread_resume(
         (pok_thread_id_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_RESUME, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_suspend_target(pok_thread_id_t thread_id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_SUSPEND_TARGET(const pok_syscall_args_t* args)
 {
     return pok_thread_suspend_target(
         (pok_thread_id_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SUSPEND_TARGET, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_yield(void);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_YIELD(const pok_syscall_args_t* args)
 {
     return pok_thread_yield();
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_YIELD, 0)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_sched_replenish(const pok_time_t* __user budget);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_REPLENISH(const pok_syscall_args_t* args)
 {
     return pok_sched_replenish(
         (const pok_time_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_REPLENISH, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_stop_target(pok_thread_id_t thread_id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_STOP(const pok_syscall_args_t* args)
 {
     return pok_thread_stop_target(
         (pok_thread_id_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STOP, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_stop(void);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_STOPSELF(const pok_syscall_args_t* args)
 {
     return pok_thread_stop();
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STOPSELF, 0)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_thread_find(const char* __user name,
     pok_thread_id_t* __user id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_FIND(const pok_syscall_args_t* args)
@@ -152,21 +210,46 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_FIND(const pok_sy
         (const char* __user)args->arg1,
         (pok_thread_id_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_FIND, 2)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_thread_get_cpu_account(pok_thread_id_t id,
+    jet_cpu_account_t* __user account);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_THREAD_GET_CPU_ACCOUNT(const pok_syscall_args_t* args)
+{
+    return pok_thread_get_cpu_account(
+        (pok_thread_id_t)args->arg1,
+        (jet_cpu_account_t* __user)args->arg2);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_GET_CPU_ACCOUNT, 2)
+#endif
 
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_resched(void);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_RESCHED(const pok_syscall_args_t* args)
 {
     return jet_resched();
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_RESCHED, 0)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_msection_enter_helper(struct msection* __user section);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_ENTER_HELPER(const pok_syscall_args_t* args)
 {
     return jet_msection_enter_helper(
         (struct msection* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_ENTER_HELPER, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_msection_wait(struct msection* __user section,
     const pok_time_t* __user timeout);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_WAIT(const pok_syscall_args_t* args)
@@ -175,7 +258,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_WAIT(const pok_
         (struct msection* __user)args->arg1,
         (const pok_time_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WAIT, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_msection_notify(struct msection* __user section,
     pok_thread_id_t thread_id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_NOTIFY(const pok_syscall_args_t* args)
@@ -184,7 +271,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_NOTIFY(const po
         (struct msection* __user)args->arg1,
         (pok_thread_id_t)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_NOTIFY, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_msection_wq_notify(struct msection* __user section,
     struct msection_wq* __user wq,
     pok_bool_t is_all);
@@ -195,7 +286,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_WQ_NOTIFY(const
         (struct msection_wq* __user)args->arg2,
         (pok_bool_t)args->arg3);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WQ_NOTIFY, 3)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t jet_msection_wq_size(struct msection* __user section,
     struct msection_wq* __user wq,
     size_t* __user size);
@@ -206,40 +301,71 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_WQ_SIZE(const p
         (struct msection_wq* __user)args->arg2,
         (size_t* __user)args->arg3);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WQ_SIZE, 3)
+#endif
 
 
 #ifdef POK_NEEDS_PARTITIONS
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_partition_set_mode_current(pok_partition_mode_t mode);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PARTITION_SET_MODE(const pok_syscall_args_t* args)
 {
     return pok_partition_set_mode_current(
         (pok_partition_mode_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_SET_MODE, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_current_partition_get_status(pok_partition_status_t* __user status);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PARTITION_GET_STATUS(const pok_syscall_args_t* args)
 {
     return pok_current_partition_get_status(
         (pok_partition_status_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_GET_STATUS, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_current_partition_inc_lock_level(int32_t* __user lock_level);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PARTITION_INC_LOCK_LEVEL(const pok_syscall_args_t* args)
 {
     return pok_current_partition_inc_lock_level(
         (int32_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_INC_LOCK_LEVEL, 1)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_current_partition_dec_lock_level(int32_t* __user lock_level);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL(const pok_syscall_args_t* args)
 {
     return pok_current_partition_dec_lock_level(
         (int32_t* __user)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL, 1)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_current_partition_get_cpu_account(jet_cpu_account_t* __user account);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PARTITION_GET_CPU_ACCOUNT(const pok_syscall_args_t* args)
+{
+    return pok_current_partition_get_cpu_account(
+        (jet_cpu_account_t* __user)args->arg1);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_GET_CPU_ACCOUNT, 1)
+#endif
 #endif
 
 
 #ifdef POK_NEEDS_ERROR_HANDLING
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_error_thread_create(uint32_t stack_size,
     void* __user entry);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_HANDLER_CREATE(const pok_syscall_args_t* args)
@@ -248,7 +374,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_HANDLER_CREATE(con
         (uint32_t)args->arg1,
         (void* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_HANDLER_CREATE, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_error_raise_application_error(const char* __user msg,
     size_t msg_size);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_RAISE_APPLICATION_ERROR(const pok_syscall_args_t* args)
@@ -257,7 +387,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_RAISE_APPLICATION_
         (const char* __user)args->arg1,
         (size_t)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_RAISE_APPLICATION_ERROR, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_error_get(pok_error_status_t* __user status,
     void* __user msg);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_GET(const pok_syscall_args_t* args)
@@ -266,8 +400,12 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_GET(const pok_sysc
         (pok_error_status_t* __user)args->arg1,
         (void* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_GET, 2)
+#endif
 #endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_error_raise_os_error(const char* __user msg,
     size_t msg_size);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_RAISE_OS_ERROR(const pok_syscall_args_t* args)
@@ -276,10 +414,14 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_ERROR_RAISE_OS_ERROR(con
         (const char* __user)args->arg1,
         (size_t)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_RAISE_OS_ERROR, 2)
+#endif
 
 
    /* Middleware syscalls */
 #ifdef POK_NEEDS_PORTS_SAMPLING
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_create(const char* __user name,
     pok_port_size_t size,
     pok_port_direction_t direction,
@@ -294,7 +436,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_CREA
         (const pok_time_t* __user)args->arg4,
         (pok_port_id_t* __user)args->arg5);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CREATE, 5)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_write(pok_port_id_t id,
     const void* __user data,
     pok_port_size_t len);
@@ -305,7 +451,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_WRIT
         (const void* __user)args->arg2,
         (pok_port_size_t)args->arg3);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_WRITE, 3)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_read(pok_port_id_t id,
     void* __user data,
     pok_port_size_t* __user len,
@@ -318,7 +468,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_READ
         (pok_port_size_t* __user)args->arg3,
         (pok_bool_t* __user)args->arg4);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_READ, 4)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_id(const char* __user name,
     pok_port_id_t* __user id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_ID(const pok_syscall_args_t* args)
@@ -327,7 +481,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_ID(c
         (const char* __user)args->arg1,
         (pok_port_id_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_ID, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_status(pok_port_id_t id,
     pok_port_sampling_status_t* __user status);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_STATUS(const pok_syscall_args_t* args)
@@ -336,16 +494,24 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_STAT
         (pok_port_id_t)args->arg1,
         (pok_port_sampling_status_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATUS, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_sampling_check(pok_port_id_t id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK(const pok_syscall_args_t* args)
 {
     return pok_port_sampling_check(
         (pok_port_id_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK, 1)
+#endif
 #endif /* POK_NEEDS_PORTS_SAMPLING */
 
 #ifdef POK_NEEDS_PORTS_QUEUEING
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_create_packed(const char* __user name,
     const pok_port_queuing_create_arg_t* __user arg,
     pok_port_id_t* __user id);
@@ -356,7 +522,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_CREA
         (const pok_port_queuing_create_arg_t* __user)args->arg2,
         (pok_port_id_t* __user)args->arg3);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CREATE, 3)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_send(pok_port_id_t id,
     const void* __user data,
     pok_port_size_t len,
@@ -369,7 +539,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND
         (pok_port_size_t)args->arg3,
         (const pok_time_t* __user)args->arg4);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND, 4)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_receive(pok_port_id_t id,
     const pok_time_t* __user timeout,
     void* __user data,
@@ -382,7 +556,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_RECE
         (void* __user)args->arg3,
         (pok_port_size_t* __user)args->arg4);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE, 4)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_id(const char* __user name,
     pok_port_id_t* __user id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_ID(const pok_syscall_args_t* args)
@@ -391,7 +569,11 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_ID(c
         (const char* __user)args->arg1,
         (pok_port_id_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_ID, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_status(pok_port_id_t id,
     pok_port_queuing_status_t* __user status);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS(const pok_syscall_args_t* args)
@@ -400,17 +582,115 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_STAT
         (pok_port_id_t)args->arg1,
         (pok_port_queuing_status_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS, 2)
+#endif
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_port_queuing_clear(pok_port_id_t id);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR(const pok_syscall_args_t* args)
 {
     return pok_port_queuing_clear(
         (pok_port_id_t)args->arg1);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR, 1)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_peek(pok_port_id_t id,
+    const void** __user message,
+    pok_port_size_t* __user len);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_PEEK(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_peek(
+        (pok_port_id_t)args->arg1,
+        (const void** __user)args->arg2,
+        (pok_port_size_t* __user)args->arg3);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_PEEK, 3)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_consume(pok_port_id_t id);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_CONSUME(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_consume(
+        (pok_port_id_t)args->arg1);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CONSUME, 1)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_reserve(pok_port_id_t id,
+    void** __user message);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_RESERVE(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_reserve(
+        (pok_port_id_t)args->arg1,
+        (void** __user)args->arg2);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RESERVE, 2)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_commit(pok_port_id_t id,
+    pok_port_size_t len);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_COMMIT(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_commit(
+        (pok_port_id_t)args->arg1,
+        (pok_port_size_t)args->arg2);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_COMMIT, 2)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_send_batch(pok_port_id_t id,
+    const void* __user data,
+    const pok_port_size_t* __user lens,
+    pok_port_size_t n,
+    pok_port_size_t* __user n_sent);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND_BATCH(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_send_batch(
+        (pok_port_id_t)args->arg1,
+        (const void* __user)args->arg2,
+        (const pok_port_size_t* __user)args->arg3,
+        (pok_port_size_t)args->arg4,
+        (pok_port_size_t* __user)args->arg5);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND_BATCH, 5)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t pok_port_queuing_receive_batch(pok_port_id_t id,
+    void* __user data,
+    pok_port_size_t* __user lens,
+    pok_port_size_t n,
+    pok_port_size_t* __user n_received);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE_BATCH(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_receive_batch(
+        (pok_port_id_t)args->arg1,
+        (void* __user)args->arg2,
+        (pok_port_size_t* __user)args->arg3,
+        (pok_port_size_t)args->arg4,
+        (pok_port_size_t* __user)args->arg5);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE_BATCH, 5)
+#endif
 
 #endif /* POK_NEEDS_PORTS_QUEUEING */
 
 
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t pok_memory_block_get_status(const char* __user name,
     jet_memory_block_status_t* __user status);
 static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MEMORY_BLOCK_GET_STATUS(const pok_syscall_args_t* args)
@@ -419,3 +699,32 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MEMORY_BLOCK_GET_STATUS(
         (const char* __user)args->arg1,
         (jet_memory_block_status_t* __user)args->arg2);
 }
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_MEMORY_BLOCK_GET_STATUS, 2)
+#endif
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t jet_perf_counter_setup(unsigned index,
+    jet_perf_event_t event);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PERF_COUNTER_SETUP(const pok_syscall_args_t* args)
+{
+    return jet_perf_counter_setup(
+        (unsigned)args->arg1,
+        (jet_perf_event_t)args->arg2);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PERF_COUNTER_SETUP, 2)
+#endif
+
+#ifndef POK_SYSCALL_TABLE_ENTRY
+pok_ret_t jet_perf_counters_read(jet_perf_counters_t* __user counters);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_PERF_COUNTERS_READ(const pok_syscall_args_t* args)
+{
+    return jet_perf_counters_read(
+        (jet_perf_counters_t* __user)args->arg1);
+}
+#else
+POK_SYSCALL_TABLE_ENTRY(POK_SYSCALL_PERF_COUNTERS_READ, 1)
+#endif
+#endif /* POK_NEEDS_PERF_COUNTERS */
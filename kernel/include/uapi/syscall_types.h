@@ -48,6 +48,7 @@ typedef enum
      POK_SYSCALL_THREAD_YIELD                        =  66,
      POK_SYSCALL_THREAD_REPLENISH                    =  67,
      POK_SYSCALL_THREAD_FIND                         =  68,
+     POK_SYSCALL_THREAD_GET_CPU_ACCOUNT              =  69,
 
      POK_SYSCALL_RESCHED                             =  80,
      POK_SYSCALL_MSECTION_ENTER_HELPER               =  81,
@@ -71,6 +72,12 @@ typedef enum
      POK_SYSCALL_MIDDLEWARE_QUEUEING_ID              = 113,
      POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS          = 114,
      POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR           = 115,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_PEEK            = 116,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_CONSUME         = 117,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_RESERVE         = 118,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_COMMIT          = 119,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND_BATCH      = 120,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE_BATCH   = 121,
 #endif
 
 #ifdef POK_NEEDS_ERROR_HANDLING
@@ -87,6 +94,7 @@ typedef enum
      POK_SYSCALL_PARTITION_GET_STATUS                = 405,
      POK_SYSCALL_PARTITION_INC_LOCK_LEVEL            = 411,
      POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL            = 412,
+     POK_SYSCALL_PARTITION_GET_CPU_ACCOUNT           = 413,
 #endif
 #ifdef POK_NEEDS_IO
      POK_SYSCALL_INB                                 = 501,
@@ -100,6 +108,11 @@ typedef enum
      POK_SYSCALL_GET_BSP_INFO                        = 703,
 
      POK_SYSCALL_MEMORY_BLOCK_GET_STATUS             = 704,
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+     POK_SYSCALL_PERF_COUNTER_SETUP                  = 801,
+     POK_SYSCALL_PERF_COUNTERS_READ                  = 802,
+#endif
 } pok_syscall_id_t;
 
 #endif /* __LIBJET_SYSCALL_TYPES_H__ */
@@ -16,6 +16,8 @@
 #ifndef __JET_UAPI_TIME_H__
 #define __JET_UAPI_TIME_H__
 
+#include <uapi/types.h>
+
 typedef long time_t;
 
 // POSIX
@@ -29,5 +31,32 @@ struct timespec {
     long tv_nsec;
 };
 
+/*
+ * Linear conversion of clock counter value into other units:
+ *
+ *     value = (counter * mult) >> shift
+ *
+ * Used for convert hardware counter (timebase, TSC) into nanoseconds
+ * without division.
+ */
+struct jet_time_scale {
+    uint32_t mult;
+    uint32_t shift; // Not greater than 32.
+};
+
+static inline uint64_t jet_time_scale_apply(const struct jet_time_scale* scale,
+    uint64_t counter)
+{
+    uint32_t high = (uint32_t)(counter >> 32);
+    uint32_t low = (uint32_t)counter;
+    uint64_t value = ((uint64_t)low * scale->mult) >> scale->shift;
+
+    // Exact, because shift is not greater than 32.
+    if(high != 0)
+        value += ((uint64_t)high * scale->mult) << (32 - scale->shift);
+
+    return value;
+}
+
 
 #endif /* __JET_UAPI_TIME_H__ */
@@ -19,6 +19,7 @@
 #include <libc.h>
 #include <asp/arch.h>
 #include <core/partition_arinc.h>
+#include <core/syscall.h>
 #include <cons.h>
 
 
@@ -98,6 +99,10 @@ int cpu_reset(int argc, char **argv); //cpu reset
 
 int info_partition(int argc,char ** argv);
 
+#ifdef POK_NEEDS_SYSCALL_STATS
+int print_syscalls(int argc, char **argv); // statistic of syscalls
+#endif
+
 struct Command {
     const char *name;
     const char *argc;
@@ -108,12 +113,15 @@ struct Command {
 static struct Command commands[] = {
     { "help", "" , "Display all list of commands", mon_help },
     { "help_about" , "/command/" , "Display descriptions of this command", help_about},
-    {"ps", "" ,"Display list of partition",print_partition},
+    {"ps", "" ,"Display list of partitions and their CPU usage",print_partition},
     {"info_partition", "/N/" ,"Display information about partition N",info_partition},
     {"pause", "/N/" ,"Pause partition N",pause_N},
     {"resume", "/N/" ,"Continue partition N",resume_N},
     {"restart", "/N/" ,"Restart partition N",restart_N},
     {"reset", "" ,"reset cpu", cpu_reset},
+#ifdef POK_NEEDS_SYSCALL_STATS
+    {"syscalls", "/reset/" ,"Display calls and latency histograms of syscalls, or reset them",print_syscalls},
+#endif
     {"exit", "" ,"Exit from console",exit_from_monitor},
 };
 
@@ -157,6 +165,17 @@ help_about(int argc,char **argv)
     return 0;
 }
 
+/* Print one line with CPU usage. Times are printed in microseconds. */
+static void print_cpu_account(const char* prefix, const jet_cpu_account_t* account)
+{
+    printf("%sconsumed %lluus, activations %lu, preemptions %lu, max response %lluus\n",
+        prefix,
+        (unsigned long long)(account->consumed_time / 1000),
+        (unsigned long)account->n_activations,
+        (unsigned long)account->n_preemptions,
+        (unsigned long long)(account->max_response_time / 1000));
+}
+
 int 
 print_partition(int argc, char **argv){
 
@@ -172,8 +191,27 @@ print_partition(int argc, char **argv){
    
     for (int i = 0 ; i < pok_partitions_arinc_n ; i++){
         pok_partition_arinc_t* part = &pok_partitions_arinc[i];
+        jet_cpu_account_t account;
+
         printf("Partition %d: %s", i, part->base_part.name);
         printf("\n");    
+
+        pok_preemption_disable();
+        pok_partition_cpu_account_get(&part->base_part, &account);
+        __pok_preemption_enable();
+        print_cpu_account("  ", &account);
+
+        for (int j = 0; j < part->nthreads_used; j++) {
+            pok_thread_t* t = &part->threads[j];
+
+            pok_preemption_disable();
+            pok_thread_cpu_account_get(part, t, &account);
+            __pok_preemption_enable();
+
+            printf("  Thread %d: %s\n", j,
+                j == POK_PARTITION_ARINC_MAIN_THREAD_ID ? "main" : t->name);
+            print_cpu_account("    ", &account);
+        }
     }
 
     (void) argc;
@@ -205,6 +243,14 @@ int info_partition(int argc,char **argv){
     printf("\n\n");
     printf("Info about partition #%d\n",number);
     printf("is_paused = %d\n", partition_pause_get(number));
+#ifdef POK_NEEDS_MEMGUARD
+    if(part->base_part.memguard.budget != 0)
+    {
+        printf("memguard_budget = %lu\n", (unsigned long)part->base_part.memguard.budget);
+        printf("memguard_throttled = %d\n", (int)part->base_part.memguard.throttled);
+        printf("memguard_n_throttles = %lu\n", (unsigned long)part->base_part.memguard.n_throttles);
+    }
+#endif
     printf("base_addr = 0x%lx\n", (unsigned long)space_layout.kernel_addr);
     printf("base_vaddr = 0x%lx\n", (unsigned long)space_layout.user_addr);
     printf("size = 0x%zx\n", space_layout.size);
@@ -320,6 +366,53 @@ int cpu_reset(int argc, char **argv)
     return 0;
 }
 
+#ifdef POK_NEEDS_SYSCALL_STATS
+/*
+ * Print statistic for syscalls which have been called.
+ *
+ * Every line of histogram contains lower bound of latency (in ns)
+ * and number of calls with latency between it and the next bound.
+ */
+int print_syscalls(int argc, char **argv)
+{
+    if (argc > 2){
+        printf("Too many arguments for syscalls!\n");
+        return 0;
+    }
+    if (argc == 2){
+        if (strcmp(argv[1], "reset") != 0){
+            printf("Unknown parameter - %s!\n", argv[1]);
+            return 0;
+        }
+        jet_syscall_stats_reset();
+        printf("Syscalls statistic is reset\n");
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < jet_syscalls_n; i++) {
+        const struct jet_syscall* syscall = &jet_syscalls[i];
+        struct jet_syscall_stats stats;
+
+        jet_syscall_stats_get(i, &stats);
+        if (stats.n_calls == 0) continue;
+
+        printf("%s (%u args): calls %lu, max latency %lluns\n",
+            syscall->name, (unsigned)syscall->nargs,
+            (unsigned long)stats.n_calls,
+            (unsigned long long)stats.max_latency);
+
+        for (int j = 0; j < JET_SYSCALL_STATS_BUCKETS; j++) {
+            if (stats.latency_hist[j] == 0) continue;
+
+            printf("  >= %luns: %lu\n", j ? 1UL << j : 0UL,
+                (unsigned long)stats.latency_hist[j]);
+        }
+    }
+
+    return 0;
+}
+#endif /* POK_NEEDS_SYSCALL_STATS */
+
 
 
 /*
@@ -15,7 +15,7 @@
 
 #include <config.h>
 
-#if defined (POK_NEEDS_DEBUG) || defined (POK_NEEDS_INSTRUMENTATION) || defined (POK_NEEDS_COVERAGE_INFOS)
+#if defined (POK_NEEDS_DEBUG) || defined (POK_NEEDS_COVERAGE_INFOS)
 
 #include <types.h>
 #include <libc.h>
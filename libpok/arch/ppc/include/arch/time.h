@@ -0,0 +1,36 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_PPC_TIME_H__
+#define __LIBJET_PPC_TIME_H__
+
+#include <types.h>
+
+/* Read timebase. */
+static inline uint64_t lja_time_counter(void)
+{
+    uint32_t upper, lower, upper1;
+
+    // Repeat if upper part is changed while lower one is read.
+    do {
+        asm volatile ("mftbu %0" : "=r" (upper));
+        asm volatile ("mftb %0" : "=r" (lower));
+        asm volatile ("mftbu %0" : "=r" (upper1));
+    } while (upper != upper1);
+
+    return ((uint64_t)upper << 32) | lower;
+}
+
+#endif /* __LIBJET_PPC_TIME_H__ */
@@ -212,4 +212,182 @@ void CLEAR_QUEUING_PORT (
     }
 }
 
+void SEND_QUEUING_MESSAGES (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*in */ MESSAGE_ADDR_TYPE         MESSAGES_ADDR,      /* by reference */
+      /*in */ const MESSAGE_SIZE_TYPE   *LENGTHS,
+      /*in */ MESSAGE_RANGE_TYPE        NB_MESSAGE,
+      /*out*/ MESSAGE_RANGE_TYPE        *NB_PROCESSED,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+    pok_ret_t core_ret;
+    pok_port_size_t n_sent = 0;
+
+    *NB_PROCESSED = 0;
+
+    if (QUEUING_PORT_ID <= 0 || NB_MESSAGE <= 0) {
+        *RETURN_CODE = INVALID_PARAM;
+        return;
+    }
+
+    // MESSAGE_SIZE_TYPE and pok_port_size_t have the same size.
+    core_ret = pok_port_queuing_send_batch(QUEUING_PORT_ID - 1, MESSAGES_ADDR,
+        (const pok_port_size_t*)LENGTHS, NB_MESSAGE, &n_sent);
+
+    *NB_PROCESSED = n_sent;
+
+    switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_FULL, NOT_AVAILABLE);
+        MAP_ERROR(POK_ERRNO_EINVAL, INVALID_PARAM);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
+void RECEIVE_QUEUING_MESSAGES (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         MESSAGES_ADDR,
+      /*out*/ MESSAGE_SIZE_TYPE         *LENGTHS,
+      /*in */ MESSAGE_RANGE_TYPE        NB_MESSAGE,
+      /*out*/ MESSAGE_RANGE_TYPE        *NB_PROCESSED,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+    pok_ret_t core_ret;
+    pok_port_size_t n_received = 0;
+
+    *NB_PROCESSED = 0;
+
+    if (QUEUING_PORT_ID <= 0 || NB_MESSAGE <= 0) {
+        *RETURN_CODE = INVALID_PARAM;
+        return;
+    }
+
+    // MESSAGE_SIZE_TYPE and pok_port_size_t have the same size.
+    core_ret = pok_port_queuing_receive_batch(QUEUING_PORT_ID - 1, MESSAGES_ADDR,
+        (pok_port_size_t*)LENGTHS, NB_MESSAGE, &n_received);
+
+    *NB_PROCESSED = n_received;
+
+    switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_EMPTY, NOT_AVAILABLE);
+        MAP_ERROR(POK_ERRNO_TOOMANY, INVALID_CONFIG);
+        MAP_ERROR(POK_ERRNO_EINVAL, INVALID_PARAM);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
+void PEEK_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         *MESSAGE_ADDR,
+      /*out*/ MESSAGE_SIZE_TYPE         *LENGTH,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+   pok_ret_t core_ret;
+   const void* message;
+   pok_port_size_t len;
+
+   if (QUEUING_PORT_ID <= 0) {
+       *RETURN_CODE = INVALID_PARAM;
+       return;
+   }
+
+   core_ret = pok_port_queuing_peek(QUEUING_PORT_ID - 1, &message, &len);
+
+   if (core_ret == POK_ERRNO_OK) {
+       *MESSAGE_ADDR = (MESSAGE_ADDR_TYPE)message;
+       *LENGTH = len;
+   } else {
+       *LENGTH = 0;
+   }
+
+   switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_EMPTY, NOT_AVAILABLE);
+        MAP_ERROR(POK_ERRNO_EXISTS, NO_ACTION);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
+void CONSUME_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+   pok_ret_t core_ret;
+
+   if (QUEUING_PORT_ID <= 0) {
+       *RETURN_CODE = INVALID_PARAM;
+       return;
+   }
+
+   core_ret = pok_port_queuing_consume(QUEUING_PORT_ID - 1);
+
+   switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_EINVAL, NO_ACTION);
+        MAP_ERROR(POK_ERRNO_TOOMANY, INVALID_CONFIG);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
+void RESERVE_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         *MESSAGE_ADDR,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+   pok_ret_t core_ret;
+   void* message;
+
+   if (QUEUING_PORT_ID <= 0) {
+       *RETURN_CODE = INVALID_PARAM;
+       return;
+   }
+
+   core_ret = pok_port_queuing_reserve(QUEUING_PORT_ID - 1, &message);
+
+   if (core_ret == POK_ERRNO_OK) {
+       *MESSAGE_ADDR = (MESSAGE_ADDR_TYPE)message;
+   }
+
+   switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_FULL, NOT_AVAILABLE);
+        MAP_ERROR(POK_ERRNO_EXISTS, NO_ACTION);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
+void COMMIT_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*in */ MESSAGE_SIZE_TYPE         LENGTH,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE )
+{
+   pok_ret_t core_ret;
+
+   if (QUEUING_PORT_ID <= 0 || LENGTH < 0) {
+       *RETURN_CODE = INVALID_PARAM;
+       return;
+   }
+
+   core_ret = pok_port_queuing_commit(QUEUING_PORT_ID - 1, LENGTH);
+
+   switch (core_ret) {
+        MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
+        MAP_ERROR(POK_ERRNO_MODE, INVALID_MODE);
+        MAP_ERROR(POK_ERRNO_EINVAL, INVALID_PARAM);
+        MAP_ERROR(POK_ERRNO_PORT, INVALID_PARAM);
+        MAP_ERROR_DEFAULT(INVALID_CONFIG);
+    }
+}
+
 #endif
@@ -28,9 +28,89 @@
 #include <core/thread.h>
 #include <utils.h>
 
+#ifdef POK_NEEDS_SAMPLING_SHARED
+#include <arinc_config.h>
+#include <core/time.h>
+#include <string.h>
+#include <compiler.h>
+#endif
+
 #define MAP_ERROR(from, to) case (from): *RETURN_CODE = (to); break
 #define MAP_ERROR_DEFAULT(to) default: *RETURN_CODE = (to); break
 
+#ifdef POK_NEEDS_SAMPLING_SHARED
+/*
+ * Return state of the port if it may be read without syscall,
+ * NULL otherwise.
+ */
+static struct arinc_sampling_port* sampling_port_shared(
+        SAMPLING_PORT_ID_TYPE SAMPLING_PORT_ID)
+{
+    struct arinc_sampling_port* port;
+
+    if (SAMPLING_PORT_ID <= 0 || SAMPLING_PORT_ID > arinc_config_nsampling_ports)
+        return NULL;
+
+    port = &arinc_sampling_ports[SAMPLING_PORT_ID - 1];
+
+    return port->shared ? port : NULL;
+}
+
+static void sampling_port_init_shared(pok_port_id_t core_id)
+{
+    pok_port_sampling_status_t status;
+    struct arinc_sampling_port* port;
+
+    if (core_id >= arinc_config_nsampling_ports)
+        return;
+
+    port = &arinc_sampling_ports[core_id];
+
+    if (pok_port_sampling_status(core_id, &status) != POK_ERRNO_OK)
+        return;
+
+    port->refresh = status.refresh;
+    port->validity = FALSE;
+    port->shared = status.shared;
+    if (port->shared)
+        port->seq_checked = port->shared->seq;
+}
+
+/*
+ * Copy the latest message from the channel mapped by the kernel.
+ *
+ * Returns size of the message (0 if there is no message) and fills
+ * its timestamp. The message is no longer treated as new.
+ */
+static uint32_t sampling_port_read_shared(
+        struct arinc_sampling_port* port,
+        void* data,
+        pok_time_t* timestamp)
+{
+    const struct jet_sampling_shared* shared = port->shared;
+    uint32_t seq, pos, size;
+
+    do {
+        seq = shared->seq;
+        barrier();
+
+        pos = shared->pos;
+        size = shared->size;
+        *timestamp = shared->timestamp;
+
+        // Fields may be inconsistent while writer updates them.
+        if (size != 0 && size <= shared->max_message_size && pos < shared->nb_slots)
+            memcpy(data, shared->messages + pos * shared->message_stride, size);
+
+        barrier();
+    } while ((seq & 1) || shared->seq != seq);
+
+    port->seq_checked = seq;
+
+    return size;
+}
+#endif /* POK_NEEDS_SAMPLING_SHARED */
+
 void CREATE_SAMPLING_PORT (
 			 /*in */ SAMPLING_PORT_NAME_TYPE    SAMPLING_PORT_NAME,
 			 /*in */ MESSAGE_SIZE_TYPE          MAX_MESSAGE_SIZE,
@@ -79,6 +159,11 @@ void CREATE_SAMPLING_PORT (
 
 	 *SAMPLING_PORT_ID = core_id + 1;
 
+#ifdef POK_NEEDS_SAMPLING_SHARED
+   if (core_ret == POK_ERRNO_OK && core_direction == POK_PORT_DIRECTION_IN)
+      sampling_port_init_shared(core_id);
+#endif
+
    switch (core_ret) {
       MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
       // For this function any error in parameter is treated as INVALID_CONFIG
@@ -130,6 +215,27 @@ void READ_SAMPLING_MESSAGE (
         return;
     }
 
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    struct arinc_sampling_port* port = sampling_port_shared(SAMPLING_PORT_ID);
+    if (port) {
+        pok_time_t timestamp;
+
+        *LENGTH = sampling_port_read_shared(port, MESSAGE_ADDR, &timestamp);
+
+        if (*LENGTH == 0) {
+            port->validity = FALSE;
+            *VALIDITY = INVALID;
+            *RETURN_CODE = NO_ACTION;
+            return;
+        }
+
+        port->validity = (timestamp + port->refresh >= pok_time_get());
+        *VALIDITY = port->validity ? VALID : INVALID;
+        *RETURN_CODE = NO_ERROR;
+        return;
+    }
+#endif /* POK_NEEDS_SAMPLING_SHARED */
+
     core_ret = pok_port_sampling_read (SAMPLING_PORT_ID - 1, MESSAGE_ADDR, (pok_port_size_t*) LENGTH, &core_validity);
 
     if(core_ret == POK_ERRNO_OK){
@@ -181,6 +287,12 @@ void GET_SAMPLING_PORT_STATUS (
         SAMPLING_PORT_STATUS->MAX_MESSAGE_SIZE = status.size;
         SAMPLING_PORT_STATUS->PORT_DIRECTION = (status.direction == POK_PORT_DIRECTION_OUT) ? SOURCE : DESTINATION;
         SAMPLING_PORT_STATUS->LAST_MSG_VALIDITY = status.validity? VALID : INVALID;
+#ifdef POK_NEEDS_SAMPLING_SHARED
+        // Messages read without syscall are not known to the kernel.
+        struct arinc_sampling_port* port = sampling_port_shared(SAMPLING_PORT_ID);
+        if (port)
+            SAMPLING_PORT_STATUS->LAST_MSG_VALIDITY = port->validity? VALID : INVALID;
+#endif
     }
 
     switch (core_ret) {
@@ -192,6 +304,18 @@ void GET_SAMPLING_PORT_STATUS (
 pok_bool_t SYS_SAMPLING_PORT_CHECK_IS_NEW_DATA(
         /*in */ SAMPLING_PORT_ID_TYPE      SAMPLING_PORT_ID)
 {
+#ifdef POK_NEEDS_SAMPLING_SHARED
+    struct arinc_sampling_port* port = sampling_port_shared(SAMPLING_PORT_ID);
+    if (port) {
+        uint32_t seq = port->shared->seq;
+        // Same encoding as for the syscall below.
+        pok_bool_t is_new = (seq != port->seq_checked && port->shared->size != 0);
+
+        port->seq_checked = seq;
+
+        return is_new ? POK_ERRNO_OK : POK_ERRNO_EMPTY;
+    }
+#endif /* POK_NEEDS_SAMPLING_SHARED */
     return pok_port_sampling_check(SAMPLING_PORT_ID - 1);
 }
 
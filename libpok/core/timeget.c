@@ -14,18 +14,47 @@
  * Created by julien on Thu Jan 15 23:34:13 2009 
  */
 
-#include <core/dependencies.h>
+#include <config.h>
 
-#if ( (! defined (POK_CONFIG_OPTIMIZE_FOR_GENERATED_CODE )) || ( defined (POK_NEEDS_FUNCTION_TIME_GET)))
-
-#include <errno.h>
 #include <types.h>
 #include <core/time.h>
+#include <core/syscall.h>
+#include <kernel_shared_data.h>
+#include <asp/time.h>
+#include <compiler.h>
 
-pok_ret_t pok_time_get (pok_time_t* ms)
+/*
+ * Compute system time using parameters from kernel shared data.
+ *
+ * Fallback to syscall if kernel doesn't allow such computation.
+ */
+pok_time_t pok_time_get(void)
 {
-   return (pok_time_gettick (ms));
-}
+    const struct jet_time_page* page = &kshd.time_page;
+    uint32_t seq;
+    uint64_t counter_base;
+    struct jet_time_scale scale;
+    pok_bool_t valid;
+
+    do {
+        seq = page->seq;
+        barrier();
 
-#endif /* POK_CONFIG_OPTIMIZE_FOR_GENERATED_CODE */
+        valid = page->valid;
+        counter_base = page->counter_base;
+        scale = page->scale;
 
+        barrier();
+    } while((seq & 1) || seq != page->seq);
+
+    if(!valid)
+    {
+        pok_time_t res;
+
+        pok_syscall2(POK_SYSCALL_CLOCK_GETTIME, (unsigned long)CLOCK_REALTIME, (unsigned long)&res);
+
+        return res;
+    }
+
+    return jet_time_scale_apply(&scale, lja_time_counter() - counter_base);
+}
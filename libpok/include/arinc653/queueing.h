@@ -76,6 +76,66 @@ extern void CLEAR_QUEUING_PORT (
       /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
       /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
 
+/*
+ * Batched extension (not in ARINC-653).
+ *
+ * Messages in MESSAGES_ADDR buffer are placed with stride equal to
+ * MAX_MESSAGE_SIZE of the port; their lengths are in LENGTHS array.
+ *
+ * Functions never wait: up to NB_MESSAGE messages are transmitted,
+ * and their number is stored into NB_PROCESSED.
+ */
+extern void SEND_QUEUING_MESSAGES (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*in */ MESSAGE_ADDR_TYPE         MESSAGES_ADDR,      /* by reference */
+      /*in */ const MESSAGE_SIZE_TYPE   *LENGTHS,
+      /*in */ MESSAGE_RANGE_TYPE        NB_MESSAGE,
+      /*out*/ MESSAGE_RANGE_TYPE        *NB_PROCESSED,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
+extern void RECEIVE_QUEUING_MESSAGES (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         MESSAGES_ADDR,
+      /*out*/ MESSAGE_SIZE_TYPE         *LENGTHS,
+      /*in */ MESSAGE_RANGE_TYPE        NB_MESSAGE,
+      /*out*/ MESSAGE_RANGE_TYPE        *NB_PROCESSED,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
+/*
+ * Zero-copy extension (not in ARINC-653).
+ *
+ * Available only for ports connected with channel, which messages
+ * are stored in the memory block. Functions never wait.
+ */
+
+/* Return address and length of the first message in the port. */
+extern void PEEK_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         *MESSAGE_ADDR,
+      /*out*/ MESSAGE_SIZE_TYPE         *LENGTH,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
+/* Remove message, returned by PEEK_QUEUING_MESSAGE, from the port. */
+extern void CONSUME_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
+/* Return address where the next message should be formed. */
+extern void RESERVE_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*out*/ MESSAGE_ADDR_TYPE         *MESSAGE_ADDR,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
+/*
+ * Send message formed at address returned by RESERVE_QUEUING_MESSAGE.
+ *
+ * Zero LENGTH cancels the reservation.
+ */
+extern void COMMIT_QUEUING_MESSAGE (
+      /*in */ QUEUING_PORT_ID_TYPE      QUEUING_PORT_ID,
+      /*in */ MESSAGE_SIZE_TYPE         LENGTH,
+      /*out*/ RETURN_CODE_TYPE          *RETURN_CODE );
+
 #endif
 
 
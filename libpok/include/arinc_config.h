@@ -46,6 +46,27 @@ extern size_t arinc_config_nevents;
 extern size_t arinc_config_messages_memory_size;
 #endif /* defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD) */
 
+#if defined(POK_NEEDS_ARINC653_SAMPLING) && defined(POK_NEEDS_SAMPLING_SHARED)
+#include <uapi/port_types.h>
+
+// State of the sampling port, which is read without syscall.
+struct arinc_sampling_port
+{
+    // Channel mapped by the kernel. NULL if port should be read via syscall.
+    const struct jet_sampling_shared* shared;
+    pok_time_t refresh;
+    // Validity of the last read message.
+    pok_bool_t validity;
+    // Value of 'shared->seq' at the last read or check for new data.
+    uint32_t seq_checked;
+};
+
+// Maximum number of sampling ports. Set in deployment.c
+extern size_t arinc_config_nsampling_ports;
+// Indexed by port id. Set in deployment.c
+extern struct arinc_sampling_port arinc_sampling_ports[];
+#endif /* defined(POK_NEEDS_ARINC653_SAMPLING) && defined(POK_NEEDS_SAMPLING_SHARED) */
+
 
 
 #endif /* __LIBJET_ARINC_CONFIG_H__ */
@@ -0,0 +1,31 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_ASP_TIME_H__
+#define __LIBJET_ASP_TIME_H__
+
+#include <types.h>
+
+/*
+ * Arch should define function
+ *
+ *     static inline uint64_t lja_time_counter(void);
+ *
+ * which reads hardware counter, used by the kernel for system time
+ * (see 'struct jet_time_page').
+ */
+#include <arch/time.h>
+
+#endif /* __LIBJET_ASP_TIME_H__ */
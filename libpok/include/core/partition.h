@@ -35,6 +35,7 @@
 #define pok_partition_set_mode pok_partition_set_mode_current
 #define pok_partition_inc_lock_level pok_current_partition_inc_lock_level
 #define pok_partition_dec_lock_level pok_current_partition_dec_lock_level
+#define pok_partition_get_cpu_account pok_current_partition_get_cpu_account
 
 // Wrapper around corresponded syscall. Returns whether preemption is disabled.
 #define pok_current_partition_preemption_disabled() \
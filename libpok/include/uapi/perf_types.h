@@ -0,0 +1,57 @@
+/*
+ * COPIED! DO NOT MODIFY!
+ *
+ * Instead of modifying this file, modify original one (kernel/include/uapi/perf_types.h).
+ */
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_UAPI_PERF_TYPES_H__
+#define __JET_UAPI_PERF_TYPES_H__
+
+#include <uapi/types.h>
+
+/*
+ * Maximum number of performance counters per partition.
+ *
+ * Actual number depends on the processor, see jet_perf_counter_setup().
+ */
+#define JET_PERF_COUNTERS_MAX 3
+
+/* Event which is counted by performance counter. */
+typedef enum
+{
+    /* Counter is disabled. */
+    JET_PERF_EVENT_NONE = 0,
+    /* Processor cycles. */
+    JET_PERF_EVENT_CYCLES = 1,
+    /* Instructions completed. */
+    JET_PERF_EVENT_INSTRUCTIONS = 2,
+    /* Misses of the last level cache (L1 data cache reloads on e500). */
+    JET_PERF_EVENT_CACHE_MISSES = 3,
+    /* Misses of data TLB. */
+    JET_PERF_EVENT_DTLB_MISSES = 4,
+    /* Misses of instruction TLB. */
+    JET_PERF_EVENT_ITLB_MISSES = 5,
+} jet_perf_event_t;
+
+/* Values of all counters of the partition. */
+typedef struct
+{
+    /* Value of every counter. 0 for disabled counters. */
+    uint64_t values[JET_PERF_COUNTERS_MAX];
+} jet_perf_counters_t;
+
+#endif /* __JET_UAPI_PERF_TYPES_H__ */
@@ -27,6 +27,7 @@
 #include <uapi/error_arinc_types.h>
 #include <uapi/memblock_types.h>
 #include <uapi/msection.h>
+#include <uapi/perf_types.h>
 
 static inline pok_ret_t pok_thread_create(const char* name,
     void* entry,
@@ -168,6 +169,16 @@ static inline pok_ret_t pok_thread_find(const char* name,
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_THREAD_FIND
 
+static inline pok_ret_t pok_thread_get_cpu_account(pok_thread_id_t id,
+    jet_cpu_account_t* account)
+{
+    return pok_syscall2(POK_SYSCALL_THREAD_GET_CPU_ACCOUNT,
+        (uint32_t)id,
+        (uint32_t)account);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_THREAD_GET_CPU_ACCOUNT
+
 
 static inline pok_ret_t jet_resched(void)
 {
@@ -261,6 +272,14 @@ static inline pok_ret_t pok_current_partition_dec_lock_level(int32_t* lock_level
 }
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL
+
+static inline pok_ret_t pok_current_partition_get_cpu_account(jet_cpu_account_t* account)
+{
+    return pok_syscall1(POK_SYSCALL_PARTITION_GET_CPU_ACCOUNT,
+        (uint32_t)account);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_PARTITION_GET_CPU_ACCOUNT
 #endif
 
 
@@ -449,6 +468,78 @@ static inline pok_ret_t pok_port_queuing_clear(pok_port_id_t id)
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR
 
+static inline pok_ret_t pok_port_queuing_peek(pok_port_id_t id,
+    const void** message,
+    pok_port_size_t* len)
+{
+    return pok_syscall3(POK_SYSCALL_MIDDLEWARE_QUEUEING_PEEK,
+        (uint32_t)id,
+        (uint32_t)message,
+        (uint32_t)len);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_PEEK
+
+static inline pok_ret_t pok_port_queuing_consume(pok_port_id_t id)
+{
+    return pok_syscall1(POK_SYSCALL_MIDDLEWARE_QUEUEING_CONSUME,
+        (uint32_t)id);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_CONSUME
+
+static inline pok_ret_t pok_port_queuing_reserve(pok_port_id_t id,
+    void** message)
+{
+    return pok_syscall2(POK_SYSCALL_MIDDLEWARE_QUEUEING_RESERVE,
+        (uint32_t)id,
+        (uint32_t)message);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_RESERVE
+
+static inline pok_ret_t pok_port_queuing_commit(pok_port_id_t id,
+    pok_port_size_t len)
+{
+    return pok_syscall2(POK_SYSCALL_MIDDLEWARE_QUEUEING_COMMIT,
+        (uint32_t)id,
+        (uint32_t)len);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_COMMIT
+
+static inline pok_ret_t pok_port_queuing_send_batch(pok_port_id_t id,
+    const void* data,
+    const pok_port_size_t* lens,
+    pok_port_size_t n,
+    pok_port_size_t* n_sent)
+{
+    return pok_syscall5(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND_BATCH,
+        (uint32_t)id,
+        (uint32_t)data,
+        (uint32_t)lens,
+        (uint32_t)n,
+        (uint32_t)n_sent);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND_BATCH
+
+static inline pok_ret_t pok_port_queuing_receive_batch(pok_port_id_t id,
+    void* data,
+    pok_port_size_t* lens,
+    pok_port_size_t n,
+    pok_port_size_t* n_received)
+{
+    return pok_syscall5(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE_BATCH,
+        (uint32_t)id,
+        (uint32_t)data,
+        (uint32_t)lens,
+        (uint32_t)n,
+        (uint32_t)n_received);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE_BATCH
+
 #endif /* POK_NEEDS_PORTS_QUEUEING */
 
 
@@ -461,3 +552,23 @@ static inline pok_ret_t pok_memory_block_get_status(const char* name,
 }
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_MEMORY_BLOCK_GET_STATUS
+
+#ifdef POK_NEEDS_PERF_COUNTERS
+static inline pok_ret_t jet_perf_counter_setup(unsigned index,
+    jet_perf_event_t event)
+{
+    return pok_syscall2(POK_SYSCALL_PERF_COUNTER_SETUP,
+        (uint32_t)index,
+        (uint32_t)event);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_PERF_COUNTER_SETUP
+
+static inline pok_ret_t jet_perf_counters_read(jet_perf_counters_t* counters)
+{
+    return pok_syscall1(POK_SYSCALL_PERF_COUNTERS_READ,
+        (uint32_t)counters);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_PERF_COUNTERS_READ
+#endif /* POK_NEEDS_PERF_COUNTERS */
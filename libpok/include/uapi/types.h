@@ -67,5 +67,28 @@ typedef enum {
  */
 #define JET_THREAD_ID_NONE (pok_thread_id_t)(-1)
 
+/* CPU usage of the thread or partition. */
+typedef struct
+{
+    /* Total time spent on CPU. */
+    pok_time_t consumed_time;
+    /* Number of times it has been switched to. */
+    uint32_t n_activations;
+    /*
+     * Number of times it has been switched off while it could
+     * continue to run (for thread) or at the end of time window
+     * (for partition).
+     */
+    uint32_t n_preemptions;
+    /*
+     * Maximum observed response time.
+     *
+     * For periodic thread this is time between release point and
+     * PERIODIC_WAIT call. For partition this is delay between start
+     * of the time window and actual switch to the partition.
+     */
+    pok_time_t max_response_time;
+} jet_cpu_account_t;
+
 
 #endif /* __JET_UAPI_TYPES_H__ */
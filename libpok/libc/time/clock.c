@@ -14,17 +14,9 @@
  */
 
 #include <time.h>
-#include <core/syscall.h>
+#include <core/time.h>
 
 clock_t clock(void)
 {
-    pok_time_t t;
-    
-    pok_ret_t ret = pok_syscall2(POK_SYSCALL_CLOCK_GETTIME, (unsigned long)CLOCK_REALTIME, (unsigned long)&t);
-    
-    if(ret) {
-        return -1; // Not supported.
-    } else {
-        return (clock_t)t;
-    }
+    return (clock_t)pok_time_get();
 }
@@ -40,6 +40,19 @@ def parse_bytes(s):
 
     return int(s) * multiplier
 
+def parse_cache_colors(s):
+    # Comma-separated list of colors and ranges of colors, e.g. "0-3,6".
+    colors = []
+    for item in s.split(","):
+        item = item.strip()
+        if "-" in item:
+            first, last = item.split("-")
+            colors.extend(range(int(first), int(last) + 1))
+        else:
+            colors.append(int(item))
+
+    return colors
+
 def parse_time(s):
     # note: CHPOK uses ms internally
 
@@ -104,17 +117,18 @@ class ArincConfigParser:
 
         self.parse_schedule(conf, root.find("Schedule"))
 
+        mem_blocks = root.find("Memory_Blocks")
+        if mem_blocks is not None:
+            for mem_block_root in mem_blocks.findall("Memory_Block"):
+                self.parse_memory_block(conf, mem_block_root)
+
+        # Channels may refer to memory blocks, so parse them after.
         connection_table = root.find("Connection_Table")
         if connection_table is not None:
             self.parse_channels(conf, connection_table)
 
         conf.network = self.parse_network(root.find("Network"))
 
-        mem_blocks = root.find("Memory_Blocks")
-        if mem_blocks is not None:
-            for mem_block_root in mem_blocks.findall("Memory_Block"):
-                self.parse_memory_block(conf, mem_block_root)
-
         # Use some default value for module HM table.
         module_error_level_selector_per_state = {error_id: 1 for error_id in conf.error_ids_all }
         for s in ['ERROR_HANDLER', 'USER']:
@@ -143,6 +157,14 @@ class ArincConfigParser:
 
         part.heap = heap_size
 
+        if "CacheColors" in part_root.find("Memory").attrib:
+            part.cache_colors = parse_cache_colors(part_root.find("Memory").attrib["CacheColors"])
+
+        bandwidth_root = part_root.find("MemoryBandwidth")
+        if bandwidth_root is not None:
+            part.memguard_budget = int(bandwidth_root.attrib["Budget"])
+            part.memguard_period = parse_time(bandwidth_root.attrib["Period"])
+
         part.num_threads = int(part_root.find("Threads").attrib["Count"])
 
         part.num_arinc653_buffers = int(part_root.find("ARINC653_Buffers").attrib["Count"])
@@ -183,6 +205,11 @@ class ArincConfigParser:
             else:
                 raise ValueError("unknown slot type %r" % slot_type)
 
+            if "Core" in x.attrib:
+                slot.core = int(x.attrib["Core"])
+                if slot.core < 0:
+                    raise ValueError("invalid core %d of the slot" % slot.core)
+
             conf.add_time_slot(slot)
 
     def parse_ports(self, part, ports_root):
@@ -222,9 +249,23 @@ class ArincConfigParser:
         for ch in channels_root.findall("Channel"):
 
             src = self.parse_connection(conf, ch.find("Source")[0])
-            dst = self.parse_connection(conf, ch.find("Destination")[0])
-
-            conf.add_channel(src, dst)
+            # Channel with several destinations is multicast.
+            dsts = [self.parse_connection(conf, dst_root[0])
+                for dst_root in ch.findall("Destination")]
+
+            channel = conf.add_channel(src, dsts)
+
+            # Zero-copy channel: messages are stored in the memory block.
+            if "MemoryBlock" in ch.attrib:
+                if not isinstance(channel, chpok_configuration.ChannelQueueing):
+                    raise ValueError("MemoryBlock is supported only for queuing channels")
+                channel.memory_block = conf.get_memory_block_by_name(ch.attrib["MemoryBlock"])
+
+            # What to do when receiver buffer is full.
+            if "OverflowStrategy" in ch.attrib:
+                if not isinstance(channel, chpok_configuration.ChannelQueueing):
+                    raise ValueError("OverflowStrategy is supported only for queuing channels")
+                channel.set_overflow_strategy(ch.attrib["OverflowStrategy"])
 
     def parse_connection(self, conf, connection_root):
         if connection_root.tag == "Standard_Partition":
@@ -34,6 +34,9 @@ import collections
 import ipaddr
 import math
 
+# Cache colors of the partition are passed to the kernel as 32-bit mask.
+MAX_CACHE_COLORS = 32
+
 
 class PartitionLayout():
     """
@@ -46,9 +49,11 @@ class PartitionLayout():
 # Single time slot for execute something.
 #
 # - duration - duration of given slot, in miliseconds.
+# - offset - start of the slot relative to the major frame start (set when slot is added).
+# - core - index of the processor which executes the slot (POK_NEEDS_SMP).
 class TimeSlot():
     __metaclass__ = abc.ABCMeta
-    __slots__ = ["duration"]
+    __slots__ = ["duration", "offset", "core"]
 
     @abc.abstractmethod
     def get_kind_constant(self):
@@ -59,6 +64,8 @@ class TimeSlot():
             raise ValueError("Minimum value for Slot duration is 1000000 (1ms).")
 
         self.duration = duration
+        self.offset = 0
+        self.core = 0
 
     def validate(self):
         if not isinstance(self.duration, int):
@@ -254,6 +261,19 @@ class Partition:
         # Note: ARINC requirements for buffers and co. shouldn't be counted here.
         "heap",
 
+        # List of cache colors for partition's memory pages.
+        #
+        # Empty list means that partition's memory is contiguous and may
+        # use any color. Used only with POK_NEEDS_CACHE_COLORING.
+        "cache_colors",
+
+        # Regulation of memory bandwidth: number of memory accesses
+        # (last level cache misses) per period, in nanoseconds.
+        #
+        # Budget 0 means no regulation. Used only with POK_NEEDS_MEMGUARD.
+        "memguard_budget",
+        "memguard_period",
+
         "num_threads", # number of user threads, _not_ counting init thread and error handler
         "ports_queueing", # list of queuing ports
         "ports_sampling", # list of sampling ports
@@ -290,6 +310,11 @@ class Partition:
 
         self.heap = 0
 
+        self.cache_colors = []
+
+        self.memguard_budget = 0
+        self.memguard_period = 0
+
         self.num_threads = 0
 
         self.num_arinc653_buffers = 0
@@ -365,12 +390,31 @@ class Partition:
         if self.part_index is None:
             raise ValueError("Index is not set for partition '%s' (Partition is added via conf.add_partition(), isn't it?).")
 
+        for color in self.cache_colors:
+            if color < 0 or color >= MAX_CACHE_COLORS:
+                raise ValueError("Cache color %d of partition '%s' is out of range [0; %d)" %
+                    (color, self.name, MAX_CACHE_COLORS))
+
+        if self.memguard_budget < 0 or self.memguard_budget > 0xffffffff:
+            raise ValueError("Memory bandwidth budget of partition '%s' should fit into 32 bits" % self.name)
+
+        if self.memguard_budget != 0 and self.memguard_period <= 0:
+            raise ValueError("Memory bandwidth period of partition '%s' should be positive" % self.name)
+
         for port in self.ports_sampling + self.ports_queueing:
             port.validate()
             if port.channel_id is None:
                 # Uncomment if processing of non-binded ports will be implemented
                 # raise RuntimeError("Port '%s' is not connected to any channel" % port.name)
                 port.channel_id = 0
+                port.channel_dst_index = 0
+
+    # Return bitmask of cache colors, 0 if colors are not set.
+    def get_cache_colors_mask(self):
+        mask = 0
+        for color in self.cache_colors:
+            mask |= 1 << color
+        return mask
 
     def get_needed_threads(self):
         return (
@@ -435,7 +479,8 @@ class Port:
         "is_direction_src",
         "max_message_size",
         "protocol",
-        "channel_id" # id of corresponded channel. Set internally.
+        "channel_id", # id of corresponded channel. Set internally.
+        "channel_dst_index" # index of dst port among channel destinations. Set internally.
     ]
 
     @abc.abstractmethod
@@ -454,6 +499,7 @@ class Port:
 
         self.max_message_size = max_message_size
         self.channel_id = None
+        self.channel_dst_index = None
         self.partition = None
 
     def is_src(self):
@@ -462,8 +508,11 @@ class Port:
     def is_dst(self):
         return not self.is_direction_src;
 
-    def setChannel(self, channel_id):
+    def setChannel(self, channel_id, dst_index = None):
+        if self.channel_id is not None:
+            raise RuntimeError("Port '%s' is connected to several channels" % self.name)
         self.channel_id = channel_id
+        self.channel_dst_index = dst_index
 
     def validate(self):
         for attr in self.__slots__:
@@ -509,37 +558,41 @@ class QueueingPort(Port):
             if not hasattr(self, attr):
                 raise ValueError("%r is not set for %r" % (attr, self))
 
-# Generic channel connecting two connections.
+# Generic channel connecting source connection with one or more
+# destination connections.
 #
 # - max_message_size - maximum size of the message passed to the channel.
 
 class Channel:
     __metaclass__ = abc.ABCMeta
-    __slots__ = ["src", "dst"]
+    __slots__ = ["src", "dsts"]
 
-    def __init__(self, src, dst, max_message_size):
+    def __init__(self, src, dsts, max_message_size):
         self.max_message_size = max_message_size
 
         self.src = src
-        self.dst = dst
+        self.dsts = dsts
 
     def validate(self):
         if not isinstance(self.src, Connection):
             raise TypeError
-        if not isinstance(self.dst, Connection):
-            raise TypeError
+        if len(self.dsts) == 0:
+            raise ValueError("channel must have at least one destination")
+        for dst in self.dsts:
+            if not isinstance(dst, Connection):
+                raise TypeError
 
         if self.get_local_connection() == None:
             raise ValueError("at least one connection per channel must be local")
 
         self.src.validate()
-        self.dst.validate()
+        for dst in self.dsts:
+            dst.validate()
 
     def get_local_connection(self):
-        if isinstance(self.src, LocalConnection):
-            return self.src
-        if isinstance(self.dst, LocalConnection):
-            return self.dst
+        for connection in [self.src] + self.dsts:
+            if isinstance(connection, LocalConnection):
+                return connection
         return None
 
     @abc.abstractmethod
@@ -547,22 +600,94 @@ class Channel:
         pass
 
     def requires_network(self):
-        return any(isinstance(x, UDPConnection) for x in [self.src, self.dst])
+        return any(isinstance(x, UDPConnection) for x in [self.src] + self.dsts)
+
+# Overflow strategies of queuing channel.
+QUEUING_OVERFLOW_STRATEGIES = [
+    "SENDER_BLOCK", # Sender waits until there is a space in receivers buffers.
+    "RECEIVER_DISCARD", # New message is discarded.
+    "RECEIVER_OVERWRITE", # The oldest message in receiver buffer is discarded.
+]
 
 class ChannelQueueing(Channel):
-    def __init__(self, src, dst, max_message_size, max_nb_message_send, max_nb_message_receive):
-        Channel.__init__(self, src, dst, max_message_size)
+    # max_nb_message_receive - list with buffer size for every destination.
+    def __init__(self, src, dsts, max_message_size, max_nb_message_send, max_nb_message_receive):
+        Channel.__init__(self, src, dsts, max_message_size)
 
         self.max_nb_message_send = max_nb_message_send
         self.max_nb_message_receive = max_nb_message_receive
 
+        # Memory block (object) which stores messages for zero-copy channel.
+        self.memory_block = None
+
+        # What to do when receiver buffer is full (see enum jet_channel_queuing_overflow_strategy).
+        self.overflow_strategy = "SENDER_BLOCK"
+
+    def get_message_stride(self):
+        # Messages are aligned on int (see pok_channel_queuing_init).
+        return (self.max_message_size + 3) & ~3
+
+    def get_messages_size(self):
+        # Messages are stored once for all destinations (see pok_channel_queuing_init).
+        return self.get_message_stride() * (self.max_nb_message_send + max(self.max_nb_message_receive))
+
+    def is_zero_copy(self):
+        return self.memory_block is not None
+
+    def set_overflow_strategy(self, overflow_strategy):
+        if overflow_strategy not in QUEUING_OVERFLOW_STRATEGIES:
+            raise ValueError("Unknown overflow strategy '%s' for queuing channel, should be one of %s" %
+                (overflow_strategy, ", ".join(QUEUING_OVERFLOW_STRATEGIES)))
+        self.overflow_strategy = overflow_strategy
+
+    def validate_zero_copy(self, arch):
+        if not self.is_zero_copy():
+            return
+
+        mblock = self.memory_block
+
+        # Oldest message may be discarded while it is peeked by the receiver.
+        if self.overflow_strategy == "RECEIVER_OVERWRITE":
+            raise ValueError("Zero-copy channel via memory block '%s' cannot use overflow strategy %s" %
+                (mblock.name, self.overflow_strategy))
+
+        # Only PPC maps memory blocks at the same address in all spaces.
+        if arch != 'ppc':
+            raise ValueError("Zero-copy channel via memory block '%s' is not supported for arch '%s'" %
+                (mblock.name, arch))
+
+        if mblock.actual_size < self.get_messages_size():
+            raise ValueError("Memory block '%s' is too small for messages of channel (%d < %d)" %
+                (mblock.name, mblock.actual_size, self.get_messages_size()))
+
+        if self.src.port.partition.part_index + 1 not in mblock.access \
+            or mblock.access[self.src.port.partition.part_index + 1] != 'READ_WRITE':
+            raise ValueError("Memory block '%s' should be writable by partition '%s'" %
+                (mblock.name, self.src.port.partition.name))
+
+        for dst in self.dsts:
+            if dst.port.partition.part_index + 1 not in mblock.access:
+                raise ValueError("Memory block '%s' should be readable by partition '%s'" %
+                    (mblock.name, dst.port.partition.name))
+
     def get_kind_constant(self):
         return "queueing"
 
 
+# Kernel uses 'destinations + 2' message slots, tracked in 32-bit mask
+# (see pok_channel_sampling_init).
+SAMPLING_CHANNEL_MAX_DESTINATIONS = 30
+
 class ChannelSampling(Channel):
-    def __init__(self, src, dst, max_message_size):
-        Channel.__init__(self, src, dst, max_message_size)
+    def __init__(self, src, dsts, max_message_size):
+        Channel.__init__(self, src, dsts, max_message_size)
+
+    def validate(self):
+        Channel.validate(self)
+
+        if len(self.dsts) > SAMPLING_CHANNEL_MAX_DESTINATIONS:
+            raise ValueError("Sampling channel of port '%s' has %d destinations, but at most %d are supported" %
+                (self.get_local_connection().port.name, len(self.dsts), SAMPLING_CHANNEL_MAX_DESTINATIONS))
 
     def get_kind_constant(self):
         return "sampling"
@@ -726,6 +851,8 @@ class Configuration:
         self.test_support_print_when_all_threads_stopped = False
 
         self.major_frame = 0
+        # Total duration of the slots of every core, indexed by core.
+        self.core_frames = []
 
         # For internal usage
         self.partition_names_map = dict()
@@ -764,32 +891,42 @@ class Configuration:
 
         return part
 
-    def add_channel(self, src_connection, dst_connection):
+    # Add channel from 'src_connection' to every connection in
+    # 'dst_connections' list (channel with several destinations is multicast).
+    def add_channel(self, src_connection, dst_connections):
         channel_type = None
         channel_max_message_size = None
-        max_nb_message_receive = 1 # Only for queueing channel
+        max_nb_message_receive = [] # Only for queueing channel
         max_nb_message_send = 1 # Only for queueing channel
 
-        for connection in [src_connection, dst_connection]:
+        if len(dst_connections) == 0:
+            raise RuntimeError("Channel should have at least one destination")
+
+        for connection in [src_connection] + dst_connections:
             if connection is not None:
+                if connection == src_connection:
+                    dst_index = None
+                else:
+                    dst_index = dst_connections.index(connection)
+
                 if not isinstance(connection, LocalConnection):
                     raise RuntimeError("Non-local connections are not supported now")
                 if isinstance(connection.port, SamplingPort):
                     if channel_type is not None:
                         if channel_type != "sampling":
                             raise RuntimeError("Channel for ports of different types: %s and %s" %
-                                (src_connection.port.name, dst_connection.port.name))
+                                (src_connection.port.name, connection.port.name))
                     else:
                         channel_type = "sampling"
-                    connection.port.setChannel(self.next_channel_id_sampling)
+                    connection.port.setChannel(self.next_channel_id_sampling, dst_index)
                 else: # Local connection to queueing port
                     if channel_type is not None:
                         if channel_type != "queueing":
                             raise RuntimeError("Channel for ports of different types: %s and %s" %
-                                (src_connection.port.name, dst_connection.port.name))
+                                (src_connection.port.name, connection.port.name))
                     else:
                         channel_type = "queueing"
-                    connection.port.setChannel(self.next_channel_id_queueing)
+                    connection.port.setChannel(self.next_channel_id_queueing, dst_index)
 
                     if connection == src_connection:
                         if not connection.port.is_src():
@@ -797,13 +934,13 @@ class Configuration:
                         max_nb_message_send = connection.port.max_nb_message
                     else:
                         if not connection.port.is_dst():
-                            raise RuntimeError("Using dst port '%s' as src connection for the channel" % connection.port.name)
-                        max_nb_message_receive = connection.port.max_nb_message
+                            raise RuntimeError("Using src port '%s' as dst connection for the channel" % connection.port.name)
+                        max_nb_message_receive.append(connection.port.max_nb_message)
 
                 if channel_max_message_size is not None:
                     if channel_max_message_size > connection.port.max_message_size:
                         raise RuntimeError("Max message size of dst port '%s' is less than one for src port '%s'" %
-                            (src_connection.port.name, dst_connection.port.name))
+                            (connection.port.name, src_connection.port.name))
                 else:
                     channel_max_message_size = connection.port.max_message_size
 
@@ -811,23 +948,47 @@ class Configuration:
             raise RuntimeError("At least one connection for channel should be local")
 
         if channel_type == 'sampling':
-            channel = ChannelSampling(src_connection, dst_connection, channel_max_message_size)
+            channel = ChannelSampling(src_connection, dst_connections, channel_max_message_size)
             self.channels_sampling.append(channel)
             self.next_channel_id_sampling += 1
         else:
-            channel = ChannelQueueing(src_connection, dst_connection, channel_max_message_size,
+            channel = ChannelQueueing(src_connection, dst_connections, channel_max_message_size,
                 max_nb_message_send, max_nb_message_receive)
             self.channels_queueing.append(channel)
             self.next_channel_id_queueing += 1
 
+        return channel
+
     def add_time_slot(self, slot):
         if isinstance(slot, TimeSlotPartition):
             slot.partition.total_time += slot.duration
             if slot.periodic_processing_start:
                 slot.partition.has_periodic_processing_start = True
 
-        self.slots.append(slot)
-        self.major_frame += slot.duration
+        while len(self.core_frames) <= slot.core:
+            self.core_frames.append(0)
+
+        # Slots are grouped by cores, every core has its own major frame.
+        slot.offset = self.core_frames[slot.core]
+        self.core_frames[slot.core] += slot.duration
+        self.major_frame = max(self.core_frames)
+
+        index = len(self.slots)
+        while index > 0 and self.slots[index - 1].core > slot.core:
+            index -= 1
+        self.slots.insert(index, slot)
+
+    # Return (first, n) range of the slots, executed by given core.
+    def get_core_slots_range(self, core):
+        indices = [i for i, slot in enumerate(self.slots) if slot.core == core]
+
+        if not indices:
+            return (0, 0)
+
+        return (indices[0], len(indices))
+
+    def get_cores_count(self):
+        return len(self.core_frames)
 
     def add_memory_block(self, name, size):
         if name in self.memory_blocks_names:
@@ -850,6 +1011,32 @@ class Configuration:
     def get_all_queueing_ports(self):
         return sum((part.get_all_queueing_ports() for part in self.partitions), [])
 
+    # Return start of the nearest periodic processing window, which follows
+    # the slot with given index and belongs to the same partition.
+    #
+    # Start is relative to the major frame containing given slot, so it
+    # exceeds the major frame if the window is in the next frame.
+    def get_slot_next_pps_offset(self, index):
+        partition = self.slots[index].partition
+        first, n = self.get_core_slots_range(self.slots[index].core)
+        index -= first
+
+        for i in range(index + 1, index + n + 1):
+            slot = self.slots[first + i % n]
+            if (isinstance(slot, TimeSlotPartition)
+                and slot.partition is partition
+                and slot.periodic_processing_start):
+                return slot.offset + (self.major_frame if i >= n else 0)
+
+        # Partition without periodic processing windows, validate() rejects it.
+        return 0
+
+    def get_memory_block_by_name(self, name):
+        for mblock in self.memory_blocks:
+            if mblock.name == name:
+                return mblock
+        raise RuntimeError("Unknown memory block '%s'" % name)
+
     def get_partition_by_name(self, name):
         return self.partition_names_map[name]
 
@@ -879,12 +1066,34 @@ class Configuration:
             #    raise ValueError("Network channel is present, but networking is not configured")
 
         # validate schedule
-        if not isinstance(self.slots[0], TimeSlotPartition):
-            raise ValueError("First time slot must be partition slot")
+        for core in range(self.get_cores_count()):
+            first, n = self.get_core_slots_range(core)
+            if n == 0:
+                raise ValueError("No time slots for core %d" % core)
+            if not isinstance(self.slots[first], TimeSlotPartition):
+                raise ValueError("First time slot of core %d must be partition slot" % core)
+            if self.core_frames[core] != self.major_frame:
+                raise ValueError("Major frame of core %d (%d) differs from the module major frame (%d)"
+                    % (core, self.core_frames[core], self.major_frame))
+
+        partition_cores = dict()
+        for slot in self.slots:
+            if isinstance(slot, TimeSlotPartition):
+                core = partition_cores.setdefault(slot.partition.name, slot.core)
+                if core != slot.core:
+                    raise ValueError("Partition '%s' has time slots on different cores" % slot.partition.name)
+            elif isinstance(slot, (TimeSlotMonitor, TimeSlotGDB)) and slot.core != 0:
+                raise ValueError("Monitor and GDB time slots must be on core 0")
 
         for partition in self.partitions:
             if not partition.has_periodic_processing_start:
                 raise ValueError("partitions '%s' don't have periodic processing points set" % partition.name)
 
+        for channel in self.channels_sampling:
+            channel.validate()
+
+        for channel in self.channels_queueing:
+            channel.validate_zero_copy(self.arch)
+
     def get_all_channels(self):
         return self.channels
@@ -0,0 +1,287 @@
+#!/usr/bin/env python
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+"""
+Decode binary trace rings of JET OS kernel (see kernel/include/core/trace.h).
+
+Input is the memory dump of 'jet_trace_rings' array, e.g. obtained with gdb:
+
+    (gdb) dump binary value trace.bin jet_trace_rings
+
+Output is either Chrome trace JSON (open in chrome://tracing or Perfetto)
+or Cheddar event table XML.
+
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import struct
+import sys
+
+JET_TRACE_MAGIC = 0x4a545243
+JET_TRACE_VERSION = 1
+
+# struct jet_trace_ring header: magic, version, cpu, n_events, head,
+# counter_base, scale.mult, scale.shift.
+RING_HEADER = "IHHIIQII"
+# struct jet_trace_event: counter, event_id, partition, thread, reserved, arg.
+EVENT = "QBBBBI"
+
+THREAD_NONE = 0xff
+
+EVENT_PARTITION_SWITCH = 1
+EVENT_THREAD_SWITCH = 2
+EVENT_SYSCALL_ENTER = 3
+EVENT_SYSCALL_EXIT = 4
+EVENT_QUEUING_SEND = 5
+EVENT_QUEUING_RECEIVE = 6
+EVENT_SAMPLING_WRITE = 7
+EVENT_SAMPLING_READ = 8
+EVENT_ERROR = 9
+EVENT_TIMER = 10
+
+EVENT_NAMES = {
+    EVENT_PARTITION_SWITCH: "partition_switch",
+    EVENT_THREAD_SWITCH: "thread_switch",
+    EVENT_SYSCALL_ENTER: "syscall_enter",
+    EVENT_SYSCALL_EXIT: "syscall_exit",
+    EVENT_QUEUING_SEND: "queuing_send",
+    EVENT_QUEUING_RECEIVE: "queuing_receive",
+    EVENT_SAMPLING_WRITE: "sampling_write",
+    EVENT_SAMPLING_READ: "sampling_read",
+    EVENT_ERROR: "error",
+    EVENT_TIMER: "timer",
+}
+
+class TraceEvent(object):
+    def __init__(self, cpu, time, event_id, partition, thread, arg):
+        self.cpu = cpu
+        self.time = time # Nanoseconds
+        self.event_id = event_id
+        self.partition = partition
+        self.thread = thread
+        self.arg = arg
+
+def scale_apply(mult, shift, counter):
+    # Same as jet_time_scale_apply() in kernel/include/uapi/time.h.
+    high = counter >> 32
+    low = counter & 0xffffffff
+    value = (low * mult) >> shift
+    if high != 0:
+        value += (high * mult) << (32 - shift)
+    return value
+
+def detect_byte_order(data, offset):
+    for order in ("<", ">"):
+        magic, = struct.unpack_from(order + "I", data, offset)
+        if magic == JET_TRACE_MAGIC:
+            return order
+    return None
+
+def read_rings(data):
+    """ Return list of events from all rings in the dump, sorted by time. """
+    events = []
+    offset = 0
+
+    while offset + struct.calcsize("<" + RING_HEADER) <= len(data):
+        order = detect_byte_order(data, offset)
+        if order is None:
+            if offset == 0:
+                raise ValueError("Not a trace dump: wrong magic")
+            break # Rest of the dump is not a ring.
+
+        header_fmt = order + RING_HEADER
+        event_fmt = order + EVENT
+        (magic, version, cpu, n_events, head,
+            counter_base, mult, shift) = struct.unpack_from(header_fmt, data, offset)
+
+        if version != JET_TRACE_VERSION:
+            raise ValueError("Unsupported trace version %d" % version)
+
+        events_offset = offset + struct.calcsize(header_fmt)
+        event_size = struct.calcsize(event_fmt)
+
+        if events_offset + n_events * event_size > len(data):
+            raise ValueError("Dump is truncated (cpu %d)" % cpu)
+
+        # When ring is overflowed, the oldest 'head - n_events' events are lost.
+        n_valid = min(head, n_events)
+        for number in range(head - n_valid, head):
+            index = number % n_events
+            (counter, event_id, partition, thread, _, arg) = struct.unpack_from(
+                event_fmt, data, events_offset + index * event_size)
+            time = scale_apply(mult, shift, (counter - counter_base) & 0xffffffffffffffff)
+            events.append(TraceEvent(cpu, time, event_id, partition, thread, arg))
+
+        offset = events_offset + n_events * event_size
+
+    events.sort(key=lambda e: (e.time, e.cpu))
+
+    return events
+
+def task_name(partition, thread):
+    if thread == THREAD_NONE:
+        return "partition%d" % partition
+    return "partition%d_thread%d" % (partition, thread)
+
+class Running(object):
+    """ Tracks what is currently running on every CPU. """
+
+    def __init__(self):
+        self.current = {} # cpu -> (partition, thread, start time)
+        self.last_thread = {} # partition -> thread
+
+    def switch(self, event, partition, thread):
+        """ Switch to the new task. Return previous one or None. """
+        prev = self.current.get(event.cpu)
+        self.current[event.cpu] = (partition, thread, event.time)
+        self.last_thread[partition] = thread
+        return prev
+
+    def on_event(self, event):
+        """
+        Process switch event.
+
+        Return (partition, thread, start, end) of the task which stops
+        running, or None.
+        """
+        if event.event_id == EVENT_THREAD_SWITCH:
+            new = (event.partition, event.thread)
+        elif event.event_id == EVENT_PARTITION_SWITCH:
+            # Thread, interrupted when partition was switched out, continues.
+            new = (event.arg, self.last_thread.get(event.arg, THREAD_NONE))
+        else:
+            return None
+
+        prev = self.switch(event, new[0], new[1])
+        if prev is None:
+            return None
+
+        return (prev[0], prev[1], prev[2], event.time)
+
+def to_chrome(events, out):
+    trace = []
+    running = Running()
+
+    def us(ns):
+        return ns / 1000.0
+
+    for e in events:
+        slice = running.on_event(e)
+        if slice is not None:
+            partition, thread, start, end = slice
+            trace.append({
+                "name": task_name(partition, thread),
+                "cat": "running",
+                "ph": "X",
+                "ts": us(start),
+                "dur": us(end - start),
+                "pid": partition,
+                "tid": thread,
+            })
+            continue
+
+        if e.event_id in (EVENT_PARTITION_SWITCH, EVENT_THREAD_SWITCH):
+            continue # First switch on the CPU.
+
+        name = EVENT_NAMES.get(e.event_id, "event%d" % e.event_id)
+        record = {
+            "name": name,
+            "ts": us(e.time),
+            "pid": e.partition,
+            "tid": e.thread,
+            "args": {"arg": e.arg, "cpu": e.cpu},
+        }
+
+        if e.event_id == EVENT_SYSCALL_ENTER:
+            record["name"] = "syscall %d" % e.arg
+            record["ph"] = "B"
+        elif e.event_id == EVENT_SYSCALL_EXIT:
+            del record["name"]
+            record["ph"] = "E"
+        else:
+            record["ph"] = "i"
+            record["s"] = "t"
+
+        trace.append(record)
+
+    json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, out, indent=1)
+    out.write("\n")
+
+def to_cheddar(events, out):
+    # Cheddar works with integer time units: use microseconds.
+    running = Running()
+
+    out.write("<event_table>\n")
+    out.write("<processor>\n")
+    out.write("<name>pok_kernel</name>\n")
+
+    for e in events:
+        running.on_event(e)
+        t = e.time // 1000
+
+        if e.event_id in (EVENT_PARTITION_SWITCH, EVENT_THREAD_SWITCH):
+            partition, thread, _ = running.current[e.cpu]
+            out.write("<running_task>   %d   %s</running_task>\n"
+                % (t, task_name(partition, thread)))
+        elif e.event_id in (EVENT_QUEUING_SEND, EVENT_SAMPLING_WRITE):
+            out.write("<write_to_buffer>   %d   %s   port%d</write_to_buffer>\n"
+                % (t, task_name(e.partition, e.thread), e.arg))
+        elif e.event_id in (EVENT_QUEUING_RECEIVE, EVENT_SAMPLING_READ):
+            out.write("<read_from_buffer>   %d   %s   port%d</read_from_buffer>\n"
+                % (t, task_name(e.partition, e.thread), e.arg))
+
+    out.write("</processor>\n")
+    out.write("</event_table>\n")
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary dump of jet_trace_rings")
+    parser.add_argument("-f", "--format", choices=("chrome", "cheddar"),
+        default="chrome", help="output format (default: chrome)")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    try:
+        events = read_rings(data)
+    except ValueError as e:
+        print("%s: %s" % (args.dump, e), file=sys.stderr)
+        return 1
+
+    out = open(args.output, "w") if args.output else sys.stdout
+
+    if args.format == "chrome":
+        to_chrome(events, out)
+    else:
+        to_cheddar(events, out)
+
+    if args.output:
+        out.close()
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,163 @@
+#!/usr/bin/env python
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+"""
+Convert partition ELF into compressed image for the kernel loader
+(POK_NEEDS_LZ4_IMAGES, see kernel/core/loader.c).
+
+Image consists of the header, table of loadable segments and content of
+every segment, compressed as single LZ4 block. All fields are 32-bit
+words in byte order of the ELF:
+
+    header:  magic, entry, number of segments
+    segment: vaddr, filesz, memsz, offset of the block, size of the block
+
+"""
+
+from __future__ import print_function
+
+import struct
+import sys
+
+LZ4_IMAGE_MAGIC = 0x4a4c5a34 # 'JLZ4'
+
+IMAGE_HEADER = "III"
+IMAGE_SEGMENT = "IIIII"
+
+PT_LOAD = 1
+
+# Constraints of the LZ4 block format.
+MIN_MATCH = 4
+LAST_LITERALS = 5
+MF_LIMIT = 12
+MAX_OFFSET = 65535
+
+def _write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+def _write_sequence(out, literals, offset = 0, match_len = 0):
+    token_literals = min(len(literals), 15)
+
+    if offset != 0:
+        token_match = min(match_len - MIN_MATCH, 15)
+    else:
+        token_match = 0
+
+    out.append((token_literals << 4) | token_match)
+    if token_literals == 15:
+        _write_length(out, len(literals) - 15)
+    out += literals
+
+    if offset != 0:
+        out.append(offset & 0xff)
+        out.append(offset >> 8)
+        if token_match == 15:
+            _write_length(out, match_len - MIN_MATCH - 15)
+
+def lz4_compress_block(data):
+    """ Compress data as single LZ4 block (without frame). """
+    src = bytearray(data)
+    n = len(src)
+    out = bytearray()
+
+    # Last position where 4-byte sequence was seen.
+    table = {}
+    anchor = 0
+    i = 0
+
+    while i < n - MF_LIMIT:
+        seq = bytes(src[i:i + MIN_MATCH])
+        ref = table.get(seq)
+        table[seq] = i
+
+        if ref is None or i - ref > MAX_OFFSET:
+            i += 1
+            continue
+
+        match_len = MIN_MATCH
+        max_len = n - LAST_LITERALS - i
+        while match_len < max_len and src[ref + match_len] == src[i + match_len]:
+            match_len += 1
+
+        _write_sequence(out, src[anchor:i], i - ref, match_len)
+
+        i += match_len
+        anchor = i
+
+    _write_sequence(out, src[anchor:])
+
+    return bytes(out)
+
+def elf_to_lz4_image(elf):
+    """ Return compressed image for the content of ELF file. """
+    if elf[:4] != b'\x7fELF':
+        raise RuntimeError('Partition has incorrect ELF format')
+
+    if bytearray(elf[4:5])[0] != 1:
+        raise RuntimeError('Only 32-bit ELF partitions may be compressed')
+
+    endian = '<' if bytearray(elf[5:6])[0] == 1 else '>'
+
+    (e_entry, e_phoff) = struct.unpack_from(endian + 'II', elf, 24)
+    (e_phentsize, e_phnum) = struct.unpack_from(endian + 'HH', elf, 42)
+
+    segments = []
+    for i in range(e_phnum):
+        (p_type, p_offset, p_vaddr, p_paddr, p_filesz, p_memsz) = \
+            struct.unpack_from(endian + 'IIIIII', elf, e_phoff + i * e_phentsize)
+
+        if p_type != PT_LOAD or p_memsz == 0:
+            continue
+
+        block = lz4_compress_block(elf[p_offset:p_offset + p_filesz])
+        segments.append((p_vaddr, p_filesz, p_memsz, block))
+
+    offset = struct.calcsize(IMAGE_HEADER) + len(segments) * struct.calcsize(IMAGE_SEGMENT)
+
+    image = struct.pack(endian + IMAGE_HEADER, LZ4_IMAGE_MAGIC, e_entry, len(segments))
+    for (vaddr, filesz, memsz, block) in segments:
+        image += struct.pack(endian + IMAGE_SEGMENT, vaddr, filesz, memsz, offset, len(block))
+        offset += len(block)
+
+    for (vaddr, filesz, memsz, block) in segments:
+        image += block
+
+    # Images are concatenated in the archive, keep headers aligned.
+    image += b'\0' * (-len(image) % 4)
+
+    return image
+
+def lz4_image_build(target, source, env):
+    """ SCons action: convert source ELF into target compressed image. """
+    with open(str(source[0]), 'rb') as f:
+        elf = f.read()
+
+    with open(str(target[0]), 'wb') as f:
+        f.write(elf_to_lz4_image(elf))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage: %s <part.elf> <part.elf.lz4>' % sys.argv[0], file = sys.stderr)
+        sys.exit(1)
+
+    lz4_image_build([sys.argv[2]], [sys.argv[1]], None)
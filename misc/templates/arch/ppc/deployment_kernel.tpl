@@ -24,12 +24,19 @@ struct ja_ppc_space ja_spaces[{{conf.spaces | length}}] =
         .size_normal = {{space.size}},
         .size_heap = {{space.part.get_heap_size()}},
         // .size_total is calculated on initialization.
+        // Currently stack size is hardcoded to 8K.
+        .size_stack = {{space.part.get_needed_threads()}} * 8 * 1024,
+        .cache_colors = {{'0x%x' % space.part.get_cache_colors_mask()}},
     },
 {%endfor%}
 };
 
 int ja_spaces_n = {{conf.spaces | length}};
 
+#ifdef POK_NEEDS_TLB0_PAGING
+uint32_t* ja_ppc_page_tables[{{conf.spaces | length}}];
+#endif
+
 /************************ Memory mapping ************************/
 
 struct tlb_entry jet_tlb_entries[] = {
@@ -40,7 +47,11 @@ struct tlb_entry jet_tlb_entries[] = {
         .virt_addr = {{"0x%x" | format(mblock.virt_addr)}},
         .phys_addr = {{"0x%x" | format(mblock.phys_addr)}},
         .size = E500MC_PGSIZE_{{mblock.str_size}},
+        {%if access_right == 'READ_ONLY'%}
+        .permissions = MAS3_SW | MAS3_SR | MAS3_UR,
+        {%else%}
         .permissions = MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR,
+        {%endif%}
         {%if mblock.cache_policy == "IO"%}
         .cache_policy = MAS2_W | MAS2_I | MAS2_M | MAS2_G,
         {% endif %}
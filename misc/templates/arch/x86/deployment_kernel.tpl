@@ -23,7 +23,8 @@ struct ja_x86_space ja_spaces[{{conf.spaces | length}}] =
         .size_normal = {{space.size}},
         .size_heap = {{space.part.get_heap_size()}},
         // Currently stack size is hardcoded to 8K.
-        .size_stack = {{space.part.get_needed_threads()}} * 8 * 1024
+        .size_stack = {{space.part.get_needed_threads()}} * 8 * 1024,
+        .cache_colors = {{'0x%x' % space.part.get_cache_colors_mask()}}
     },
 {%endfor%}
 };
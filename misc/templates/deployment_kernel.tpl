@@ -59,22 +59,37 @@ error("UDP connection for the channel doesn't supported yet")
 {%-endmacro%}
 
 /**************** Setup queuing channels ****************************/
+{%for channel_queueing in conf.channels_queueing%}
+// Receivers of the queuing channel {{loop.index0}}.
+static struct pok_channel_queuing_side channel_queuing_recvs_{{loop.index0}}[{{channel_queueing.dsts | length}}] = {
+{%for dst in channel_queueing.dsts%}
+    {
+        .max_nb_message = {{channel_queueing.max_nb_message_receive[loop.index0]}},
+        .part = {{connection_partition(dst)}},
+    },
+{%endfor%}
+};
+
+{%endfor%}
 pok_channel_queuing_t pok_channels_queuing[{{ conf.channels_queueing | length }}] = {
     {%for channel_queueing in conf.channels_queueing%}
     {
         .max_message_size = {{channel_queueing.max_message_size}},
 
-        .recv = {
-            .max_nb_message = {{channel_queueing.max_nb_message_receive}},
-            .part = {{connection_partition(channel_queueing.dst)}},
-        },
+        .recvs = channel_queuing_recvs_{{loop.index0}},
+        .nb_recvs = {{channel_queueing.dsts | length}},
         .send = {
             .max_nb_message = {{channel_queueing.max_nb_message_send}},
             .part = {{connection_partition(channel_queueing.src)}},
         },
 
-        // Currently hardcoded.
-        .overflow_strategy = JET_CHANNEL_QUEUING_SENDER_BLOCK,
+        .overflow_strategy = JET_CHANNEL_QUEUING_{{channel_queueing.overflow_strategy}},
+    {%if channel_queueing.is_zero_copy()%}
+
+        // Messages are stored in memory block '{{channel_queueing.memory_block.name}}'.
+        .is_zero_copy = TRUE,
+        .messages = (char*){{"0x%x" | format(channel_queueing.memory_block.virt_addr)}},
+    {%endif%}
     },
     {%endfor%}
 };
@@ -82,10 +97,17 @@ pok_channel_queuing_t pok_channels_queuing[{{ conf.channels_queueing | length }}
 uint8_t pok_channels_queuing_n = {{ conf.channels_queueing | length }};
 
 /****************** Setup sampling channels ***************************/
+{%for channel_sampling in conf.channels_sampling%}
+// Receivers of the sampling channel {{loop.index0}}.
+static struct pok_channel_sampling_reader channel_sampling_readers_{{loop.index0}}[{{channel_sampling.dsts | length}}];
+{%endfor%}
+
 pok_channel_sampling_t pok_channels_sampling[{{ conf.channels_sampling | length }}] = {
     {%for channel_sampling in conf.channels_sampling%}
     {
         .max_message_size = {{channel_sampling.max_message_size}},
+        .readers = channel_sampling_readers_{{loop.index0}},
+        .nb_readers = {{channel_sampling.dsts | length}},
     },
     {%endfor%}
 };
@@ -141,6 +163,11 @@ static pok_port_queuing_t partition_ports_queuing_{{loop.index0}}[{{part.ports_q
     {
         .name = "{{port_queueing.name}}",
         .channel = &pok_channels_queuing[{{port_queueing.channel_id}}],
+{%if port_queueing.is_src()%}
+        .side = &pok_channels_queuing[{{port_queueing.channel_id}}].send,
+{%else%}
+        .side = &channel_queuing_recvs_{{port_queueing.channel_id}}[{{port_queueing.channel_dst_index}}],
+{%endif%}
         .direction = {%if port_queueing.is_src()%}POK_PORT_DIRECTION_OUT{%else%}POK_PORT_DIRECTION_IN{%endif%},
     },
 {%endfor%}
@@ -152,6 +179,9 @@ static pok_port_sampling_t partition_ports_sampling_{{loop.index0}}[{{part.ports
     {
         .name = "{{port_sampling.name}}",
         .channel = &pok_channels_sampling[{{port_sampling.channel_id}}],
+{%if port_sampling.is_dst()%}
+        .reader = &channel_sampling_readers_{{port_sampling.channel_id}}[{{port_sampling.channel_dst_index}}],
+{%endif%}
         .direction = {%if port_sampling.is_src()%}POK_PORT_DIRECTION_OUT{%else%}POK_PORT_DIRECTION_IN{%endif%},
     },
 {%endfor%}
@@ -166,8 +196,8 @@ pok_partition_arinc_t pok_partitions_arinc[{{conf.partitions | length}}] = {
         .base_part = {
             .name = "{{part.name}}",
 
-            // Allocate 1 event slot per queuing port plus 2 slots for timer.
-            .partition_event_max = {{part.ports_queueing | length}} + 2,
+            // Queuing ports are event handlers, timer event has its own bit.
+            .partition_event_handlers_n = {{part.ports_queueing | length}},
 
             .period = {%if part.period is not none%}{{part.period}}{%else%}{{conf.major_frame}}{%endif%},
             .duration = {%if part.duration is not none%}{{part.duration}}{%else%}{{part.total_time}}{%endif%},
@@ -177,6 +207,14 @@ pok_partition_arinc_t pok_partitions_arinc[{{conf.partitions | length}}] = {
 
             .multi_partition_hm_selector = &pok_hm_multi_partition_selector_default,
             .multi_partition_hm_table = &pok_hm_multi_partition_table_default,
+{%if part.memguard_budget != 0%}
+#ifdef POK_NEEDS_MEMGUARD
+            .memguard = {
+                .budget = {{part.memguard_budget}},
+                .period = {{part.memguard_period}},
+            },
+#endif
+{%endif%}
         },
 
         .nthreads = {{part.get_needed_threads()}},
@@ -209,7 +247,7 @@ pok_partition_t partition_monitor =
 {
     .name = "Monitor",
 
-    .partition_event_max = 0,
+    .partition_event_handlers_n = 0,
 
     .period = {{conf.major_frame}}, {#TODO: Where it is stored in conf?#}
 
@@ -225,7 +263,7 @@ pok_partition_t partition_gdb =
 {
     .name = "GDB",
 
-    .partition_event_max = 0,
+    .partition_event_handlers_n = 0,
 
     .period = {{conf.major_frame}}, {#TODO: Where it is stored in conf?#}
 
@@ -241,10 +279,11 @@ const pok_sched_slot_t pok_module_sched[{{conf.slots | length}}] = {
 {%for slot in conf.slots%}
     {
         .duration = {{slot.duration}},
-        .offset = 0,{#TODO: precalculate somehow#}{{''}}
+        .offset = {{slot.offset}},
     {%if slot.get_kind_constant() == 'POK_SLOT_PARTITION' %}
         .partition = &pok_partitions_arinc[{{slot.partition.part_index}}].base_part,
         .periodic_processing_start = {%if slot.periodic_processing_start%}TRUE{%else%}FALSE{%endif%},
+        .next_pps_offset = {{conf.get_slot_next_pps_offset(loop.index0)}},
     {%elif slot.get_kind_constant() == 'POK_SLOT_MONITOR' %}
 #ifdef POK_NEEDS_MONITOR
         .partition = &partition_monitor,
@@ -267,6 +306,18 @@ const pok_sched_slot_t pok_module_sched[{{conf.slots | length}}] = {
 
 const uint8_t pok_module_sched_n = {{conf.slots | length}};
 
+const pok_sched_cpu_slots_t pok_module_sched_cpus[{{conf.get_cores_count()}}] = {
+{%for core in range(conf.get_cores_count())%}
+{%set slots_range = conf.get_core_slots_range(core)%}
+    {
+        .first = {{slots_range[0]}},
+        .n = {{slots_range[1]}},
+    },
+{%endfor%}
+};
+
+const uint8_t pok_module_sched_cpus_n = {{conf.get_cores_count()}};
+
 const pok_time_t pok_config_scheduling_major_frame = {{conf.major_frame}};
 
 /************************ Memory blocks ************************/
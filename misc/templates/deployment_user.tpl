@@ -40,6 +40,12 @@ size_t arinc_config_nevents = {{part.num_arinc653_events}};
 size_t arinc_config_messages_memory_size = {{part.buffer_data_size + part.blackboard_data_size}};
 #endif /* defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD) */
 
+#if defined(POK_NEEDS_ARINC653_SAMPLING) && defined(POK_NEEDS_SAMPLING_SHARED)
+// Maximum number of sampling ports.
+size_t arinc_config_nsampling_ports = {{part.ports_sampling | length}};
+struct arinc_sampling_port arinc_sampling_ports[{{part.ports_sampling | length}} + 1];
+#endif /* defined(POK_NEEDS_ARINC653_SAMPLING) && defined(POK_NEEDS_SAMPLING_SHARED) */
+
 {%if part.is_system%}
 {% include 'deployment_user_system'%}
 {%endif%}
@@ -1,5 +1,6 @@
 {# TODO: Copyright there -#}
 {% macro full_type(arg) %}{{arg.arg_type}}{%if arg.is_pointer%} __user{%endif%}{%endmacro%}
+#ifndef POK_SYSCALL_TABLE_ENTRY
 pok_ret_t {{sd.func}}(
 {%- for arg in sd.args %}
 {{full_type(arg)}} {{arg.name}}{%if not loop.last %},
@@ -14,3 +15,6 @@ static inline pok_ret_t pok_syscall_wrapper_{{sd.syscall_id}}(const pok_syscall_
                        {%- endfor%}
 );
 }
+#else
+POK_SYSCALL_TABLE_ENTRY({{sd.syscall_id}}, {{sd.args | length}})
+#endif